@@ -353,6 +353,11 @@ class PROJ_GCC_DLL IdentifiedObject : public util::BaseObject,
         util::IComparable::Criterion criterion =
             util::IComparable::Criterion::STRICT,
         const io::DatabaseContextPtr &dbContext = nullptr) PROJ_PURE_DECL;
+
+    PROJ_INTERNAL const std::string &canonicalName() const;
+
+    PROJ_INTERNAL bool
+    hasEquivalentNameTo(const IdentifiedObject *other) const;
     //! @endcond
 
   protected:
@@ -364,6 +369,8 @@ class PROJ_GCC_DLL IdentifiedObject : public util::BaseObject,
     void setProperties(const util::PropertyMap
                            &properties); // throw(InvalidValueTypeException)
 
+    PROJ_INTERNAL void internName();
+
     virtual bool hasEquivalentNameToUsingAlias(
         const IdentifiedObject *other,
         const io::DatabaseContextPtr &dbContext) const;
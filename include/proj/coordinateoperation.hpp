@@ -2067,12 +2067,27 @@ class PROJ_GCC_DLL CoordinateOperationContext {
     PROJ_DLL const util::optional<common::DataEpoch> &
     getTargetCoordinateEpoch() const;
 
+    PROJ_DLL void setMaxThreads(int maxThreads);
+
+    PROJ_DLL int getMaxThreads() const;
+
+    PROJ_DLL void setMaxResultCount(size_t maxResultCount);
+
+    PROJ_DLL size_t getMaxResultCount() const;
+
     PROJ_DLL static CoordinateOperationContextNNPtr
     create(const io::AuthorityFactoryPtr &authorityFactory,
            const metadata::ExtentPtr &extent, double accuracy);
 
     PROJ_DLL CoordinateOperationContextNNPtr clone() const;
 
+    PROJ_PRIVATE :
+        //! @cond Doxygen_Suppress
+        PROJ_INTERNAL CoordinateOperationContextNNPtr
+        cloneWithAuthorityFactory(
+            const io::AuthorityFactoryPtr &authorityFactory) const;
+    //! @endcond
+
   protected:
     PROJ_INTERNAL CoordinateOperationContext();
     PROJ_INTERNAL
@@ -159,6 +159,8 @@ std::string toString(int val);
 
 PROJ_FOR_TEST std::string toString(double val, int precision = 15);
 
+PROJ_FOR_TEST bool formatShortestDouble15(double val, char *szBuffer);
+
 PROJ_FOR_TEST double
 c_locale_stod(const std::string &s); // throw(std::invalid_argument)
 
@@ -184,6 +186,34 @@ std::string concat(const std::string &, const std::string &,
 
 double getRoundedEpochInDecimalYear(double year);
 
+// Interned strings are stored once per process, so that equal interned
+// strings share the same address. They are never released, so strings are
+// only added while an InterningScope is active: when instantiating objects
+// from the database or built-in objects, whose strings form a bounded set.
+// Otherwise, as for strings coming from WKT or PROJ strings, only strings
+// already interned are returned. Returns nullptr if str is not interned.
+// This is meant for values drawn from a small set: code spaces, unit names,
+// operation method and parameter names.
+PROJ_FOR_TEST const std::string *intern(const std::string &str);
+
+// Same as above. Returns a process-wide empty optional if str has no value.
+const util::optional<std::string> *
+internOptional(const util::optional<std::string> &str);
+
+// Lets intern() add strings in the current thread during the lifetime of the
+// object.
+class InterningScope {
+  public:
+    PROJ_FOR_TEST InterningScope();
+    PROJ_FOR_TEST ~InterningScope();
+
+  private:
+    bool previous_;
+
+    InterningScope(const InterningScope &) = delete;
+    InterningScope &operator=(const InterningScope &) = delete;
+};
+
 } // namespace internal
 
 NS_PROJ_END
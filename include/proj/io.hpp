@@ -40,6 +40,10 @@
 
 #include "util.hpp"
 
+//! @cond Doxygen_Suppress
+struct projThreadPool;
+//! @endcond
+
 NS_PROJ_START
 
 class CPLJSonStreamingWriter;
@@ -894,6 +898,8 @@ class PROJ_GCC_DLL DatabaseContext {
 
     PROJ_DLL void stopInsertStatementsSession();
 
+    PROJ_DLL void setUseObjectArena(bool enable);
+
     PROJ_PRIVATE :
         //! @cond Doxygen_Suppress
         PROJ_DLL void *
@@ -901,6 +907,15 @@ class PROJ_GCC_DLL DatabaseContext {
 
     PROJ_DLL static DatabaseContextNNPtr create(void *sqlite_handle);
 
+    PROJ_INTERNAL PJ_CONTEXT *getPJContext() const;
+
+    PROJ_INTERNAL DatabaseContextPtr acquireForOtherThread();
+
+    PROJ_INTERNAL void
+    releaseForOtherThread(const DatabaseContextNNPtr &otherThreadContext);
+
+    PROJ_INTERNAL projThreadPool *getThreadPool(size_t maxThreads);
+
     PROJ_INTERNAL bool lookForGridAlternative(const std::string &officialName,
                                               std::string &projFilename,
                                               std::string &projFormat,
@@ -962,6 +977,10 @@ class PROJ_GCC_DLL DatabaseContext {
     PROJ_DLL std::vector<std::string>
     getVersionedAuthoritiesFromName(const std::string &authName);
 
+    PROJ_FOR_TEST const util::ObjectArenaPtr &getObjectArena() const;
+
+    PROJ_FOR_TEST size_t getOtherThreadContextCount() const;
+
     PROJ_FOR_TEST bool
     toWGS84AutocorrectWrongValues(double &tx, double &ty, double &tz,
                                   double &rx, double &ry, double &rz,
@@ -1262,6 +1281,17 @@ class PROJ_GCC_DLL AuthorityFactory {
         createEllipsoidFromExisting(
             const datum::EllipsoidNNPtr &ellipsoid) const;
 
+    PROJ_FOR_TEST std::vector<operation::CoordinateOperationNNPtr>
+    createFromCoordinateReferenceSystemCodes(
+        const std::string &sourceCRSAuthName, const std::string &sourceCRSCode,
+        const std::string &targetCRSAuthName, const std::string &targetCRSCode,
+        bool usePROJAlternativeGridNames, bool discardIfMissingGrid,
+        bool considerKnownGridsAsAvailable, bool discardSuperseded,
+        bool tryReverseOrder, bool reportOnlyIntersectingTransformations,
+        const metadata::ExtentPtr &intersectingExtent1,
+        const metadata::ExtentPtr &intersectingExtent2, double maxAccuracy,
+        bool &hasSkippedOps) const;
+
     PROJ_INTERNAL std::list<crs::GeodeticCRSNNPtr>
     createGeodeticCRSFromDatum(const std::string &datum_auth_name,
                                const std::string &datum_code,
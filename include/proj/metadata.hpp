@@ -403,6 +403,9 @@ class PROJ_GCC_DLL Identifier : public util::BaseObject,
         PROJ_INTERNAL static std::string
         canonicalizeName(const std::string &str);
 
+    PROJ_INTERNAL static std::string
+    equivalentNameKey(const std::string &str);
+
     PROJ_INTERNAL void _exportToWKT(io::WKTFormatter *formatter)
         const override; // throw(io::FormattingException)
 
@@ -425,6 +428,9 @@ class PROJ_GCC_DLL Identifier : public util::BaseObject,
     PROJ_INTERNAL static IdentifierNNPtr
     createFromDescription(const std::string &descriptionIn);
 
+    PROJ_INTERNAL static IdentifierNNPtr createFromInternedDescription(
+        const util::optional<std::string> &internedDescriptionIn);
+
   private:
     PROJ_OPAQUE_PRIVATE_DATA
 };
@@ -38,9 +38,11 @@
 #undef STRICT
 #endif
 
+#include <cstddef>
 #include <exception>
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -127,18 +129,44 @@ namespace proj {}
                                                                                \
   private:
 
+// Allocator, nested in a class so that it can call its protected/private
+// constructors, taking its memory from util::ObjectAllocatorBase-like Base
+#define INLINED_OBJECT_ALLOCATOR(name, Base)                                   \
+    template <typename U> struct name : public Base<U> {                       \
+        template <typename V> struct rebind {                                  \
+            using other = name<V>;                                             \
+        };                                                                     \
+        name() = default;                                                      \
+        template <typename V>                                                  \
+        name(const name<V> &other) noexcept : Base<U>(other) {}                \
+        template <typename V, typename... Args>                                \
+        void construct(V *ptr, Args &&...args) {                               \
+            ::new (static_cast<void *>(ptr)) V(std::forward<Args>(args)...);   \
+        }                                                                      \
+    };
+
 // To include in the protected/private section of a class definition,
 // to be able to call make_shared on a protected/private constructor
+// The object and its reference count are allocated in a single block, taken
+// from the active util::ObjectArena if there is one, as std::make_shared()
+// would otherwise.
 #define INLINED_MAKE_SHARED                                                    \
+    INLINED_OBJECT_ALLOCATOR(HeapAllocator, util::HeapAllocatorBase)           \
+    INLINED_OBJECT_ALLOCATOR(ArenaAllocator, util::ObjectAllocatorBase)        \
     template <typename T, typename... Args>                                    \
     static std::shared_ptr<T> make_shared(Args &&...args) {                    \
-        return std::shared_ptr<T>(new T(std::forward<Args>(args)...));         \
+        if (util::ObjectArena::active()) {                                     \
+            return std::allocate_shared<T>(ArenaAllocator<T>(),                \
+                                           std::forward<Args>(args)...);       \
+        }                                                                      \
+        return std::allocate_shared<T>(HeapAllocator<T>(),                     \
+                                       std::forward<Args>(args)...);           \
     }                                                                          \
     template <typename T, typename... Args>                                    \
     static util::nn_shared_ptr<T> nn_make_shared(Args &&...args) {             \
         return util::nn_shared_ptr<T>(                                         \
             util::i_promise_i_checked_for_null,                                \
-            std::shared_ptr<T>(new T(std::forward<Args>(args)...)));           \
+            make_shared<T>(std::forward<Args>(args)...));                      \
     }
 
 // To include in the protected/private section of a class definition,
@@ -226,6 +254,134 @@ template <class T> struct remove_cvref {
 
 //! @endcond
 
+//! @cond Doxygen_Suppress
+class ObjectArena;
+/** Shared pointer of ObjectArena. */
+using ObjectArenaPtr = std::shared_ptr<ObjectArena>;
+
+/** Memory arena from which objects can be allocated.
+ *
+ * Memory is handed out from large chunks, and is only released when the
+ * arena itself is destroyed. Each object allocated from an arena keeps a
+ * reference to it. Owners of an arena are expected to replace it with a new
+ * one once it is full(), so that its memory is released with the last of
+ * its objects.
+ *
+ * An arena should be used only by one thread at a time.
+ */
+class PROJ_GCC_DLL ObjectArena {
+  public:
+    PROJ_INTERNAL ObjectArena();
+    PROJ_DLL ~ObjectArena();
+
+    PROJ_DLL void *allocate(size_t size);
+
+    /** Returns the number of bytes handed out by allocate(). */
+    PROJ_DLL size_t usedSize() const noexcept;
+
+    /** Returns the number of bytes of the chunks owned by the arena. */
+    PROJ_DLL size_t reservedSize() const noexcept;
+
+    /** Returns whether the arena has reached its maximum size. */
+    PROJ_DLL bool full() const noexcept;
+
+    PROJ_DLL static const ObjectArenaPtr &active() noexcept;
+
+    /** Makes an arena (or none, if null) the active one of the current
+     * thread during the lifetime of the Scope object. */
+    class PROJ_GCC_DLL Scope {
+      public:
+        PROJ_INTERNAL explicit Scope(const ObjectArenaPtr &arena);
+        PROJ_INTERNAL ~Scope();
+
+      private:
+        ObjectArenaPtr arena_;
+        const ObjectArenaPtr *previous_;
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+  private:
+    PROJ_OPAQUE_PRIVATE_DATA
+    ObjectArena(const ObjectArena &) = delete;
+    ObjectArena &operator=(const ObjectArena &) = delete;
+};
+
+/** Allocator used by the make_shared() methods of INLINED_MAKE_SHARED when
+ * an arena is active. The arena active when the allocator is built is used,
+ * or the regular heap if there is none. */
+template <typename T> class ObjectAllocatorBase {
+  public:
+    using value_type = T;
+
+    ObjectAllocatorBase() : arena_(ObjectArena::active()) {}
+
+    template <typename U>
+    // cppcheck-suppress noExplicitConstructor
+    ObjectAllocatorBase(const ObjectAllocatorBase<U> &other) noexcept
+        : arena_(other.arena()) {}
+
+    T *allocate(std::size_t n) {
+        if (arena_) {
+            return static_cast<T *>(arena_->allocate(n * sizeof(T)));
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t) noexcept {
+        // Memory coming from an arena is released with it
+        if (!arena_) {
+            ::operator delete(ptr);
+        }
+    }
+
+    const ObjectArenaPtr &arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ObjectAllocatorBase<U> &other) const noexcept {
+        return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ObjectAllocatorBase<U> &other) const noexcept {
+        return arena_ != other.arena();
+    }
+
+  private:
+    ObjectArenaPtr arena_{};
+};
+
+/** Allocator used by the make_shared() methods of INLINED_MAKE_SHARED when
+ * no arena is active. */
+template <typename T> class HeapAllocatorBase {
+  public:
+    using value_type = T;
+
+    HeapAllocatorBase() = default;
+
+    template <typename U>
+    // cppcheck-suppress noExplicitConstructor
+    HeapAllocatorBase(const HeapAllocatorBase<U> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t) noexcept { ::operator delete(ptr); }
+
+    template <typename U>
+    bool operator==(const HeapAllocatorBase<U> &) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const HeapAllocatorBase<U> &) const noexcept {
+        return false;
+    }
+};
+//! @endcond
+
 // To avoid formatting differences between clang-format 3.8 and 7
 #define PROJ_NOEXCEPT noexcept
 
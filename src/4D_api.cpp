@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #define FROM_PROJ_CPP
+#define LRU11_DO_NOT_DEFINE_OUT_OF_CLASS_METHODS
 
 #include <assert.h>
 #include <errno.h>
@@ -40,7 +41,12 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "filemanager.hpp"
 #include "geodesic.h"
@@ -55,6 +61,7 @@
 #include "proj/coordinateoperation.hpp"
 #include "proj/internal/internal.hpp"
 #include "proj/internal/io_internal.hpp"
+#include "proj/internal/lru_cache.hpp"
 
 using namespace NS_PROJ::internal;
 
@@ -361,6 +368,41 @@ bool PJCoordOperation::isInstantiable() const {
         isInstantiableCached = proj_coordoperation_is_instantiable(pj->ctx, pj);
     return (isInstantiableCached == 1);
 }
+
+/**************************************************************************************/
+void PJCoordOperation::instantiate() {
+    /**************************************************************************************
+    Replace pj, when it only holds the definition of the operation, by its
+    instantiation, in the same conditions as pj_create_prepared_operations()
+    used to instantiate all operations upfront.
+    **************************************************************************************/
+    if (!instantiationDeferred)
+        return;
+    instantiationDeferred = false;
+
+    PJ_CONTEXT *ctx = pj->ctx;
+    const int old_debug_level = ctx->debug_level;
+    const int old_errno = ctx->last_errno;
+    const bool old_forceOver = ctx->forceOver;
+    if (pj->errorIfBestTransformationNotAvailable ||
+        pj->warnIfBestTransformationNotAvailable)
+        ctx->debug_level = PJ_LOG_NONE;
+    ctx->forceOver = pj->over != 0;
+    PJ *instantiated = pj_obj_create(ctx, NN_NO_CHECK(pj->iso_obj));
+    ctx->forceOver = old_forceOver;
+    ctx->debug_level = old_debug_level;
+    ctx->last_errno = old_errno;
+    if (!instantiated)
+        return;
+
+    instantiated->over = pj->over;
+    instantiated->errorIfBestTransformationNotAvailable =
+        pj->errorIfBestTransformationNotAvailable;
+    instantiated->warnIfBestTransformationNotAvailable =
+        pj->warnIfBestTransformationNotAvailable;
+    proj_destroy(pj);
+    pj = instantiated;
+}
 //! @endcond
 
 /**************************************************************************************/
@@ -453,7 +495,8 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
                        "Attempting a retry with another operation.");
             }
 
-            const auto &alt = P->alternativeCoordinateOperations[iBest];
+            auto &alt = P->alternativeCoordinateOperations[iBest];
+            alt.instantiate();
             if (P->iCurCoordOp != iBest) {
                 if (proj_log_level(P->ctx, PJ_LOG_TELL) >= PJ_LOG_DEBUG) {
                     std::string msg("Using coordinate operation ");
@@ -502,7 +545,7 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
         } catch (const std::exception &) {
         }
         for (int i = 0; i < nOperations; i++) {
-            const auto &alt = P->alternativeCoordinateOperations[i];
+            auto &alt = P->alternativeCoordinateOperations[i];
             auto coordOperation =
                 dynamic_cast<NS_PROJ::operation::CoordinateOperation *>(
                     alt.pj->iso_obj.get());
@@ -519,6 +562,7 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
                         }
                         P->iCurCoordOp = i;
                     }
+                    alt.instantiate();
                     if (direction == PJ_FWD) {
                         pj_fwd4d(coord, alt.pj);
                     } else {
@@ -560,8 +604,49 @@ object must be freed with proj_destroy().
         return nullptr;
     if (P->alternativeCoordinateOperations.empty())
         return proj_clone(P->ctx, P);
-    return proj_clone(P->ctx,
-                      P->alternativeCoordinateOperations[P->iCurCoordOp].pj);
+    auto &op = P->alternativeCoordinateOperations[P->iCurCoordOp];
+    op.instantiate();
+    return proj_clone(P->ctx, op.pj);
+}
+
+/*****************************************************************************/
+static bool proj_trans_array_batched(PJ *P, PJ_DIRECTION direction, size_t n,
+                                     PJ_COORD *coord,
+                                     std::vector<int> &errnos) {
+    /******************************************************************************
+        Transform the array of coordinates with pj_fwd4d_array() or
+    pj_inv4d_array(), giving the same results as calling proj_trans() on each
+    coordinate, with the error code of each coordinate stored in errnos.
+
+        Returns false, without touching the coordinates, when the array
+    must be transformed point by point: when P has alternative coordinate
+    operations, which are selected per point, or when some of the
+    coordinates hold NaN or HUGE_VAL values, which proj_trans() handles
+    specifically.
+    ******************************************************************************/
+    if (n < 2 || direction == PJ_IDENT ||
+        !P->alternativeCoordinateOperations.empty() ||
+        (P->iso_obj != nullptr && !P->iso_obj_is_coordinate_operation))
+        return false;
+    for (size_t i = 0; i < n; i++) {
+        if (coord_has_nans(coord[i]) || coord[i].v[0] == HUGE_VAL)
+            return false;
+    }
+
+    if (P->inverted)
+        direction = opposite_direction(direction);
+    P->iCurCoordOp = 0;
+    if (P->hasCoordinateEpoch) {
+        for (size_t i = 0; i < n; i++)
+            coord[i].xyzt.t = P->coordinateEpoch;
+    }
+
+    errnos.assign(n, 0);
+    if (direction == PJ_FWD)
+        pj_fwd4d_array(P, n, coord, errnos.data());
+    else
+        pj_inv4d_array(P, n, coord, errnos.data());
+    return true;
 }
 
 /*****************************************************************************/
@@ -585,6 +670,24 @@ int proj_trans_array(PJ *P, PJ_DIRECTION direction, size_t n, PJ_COORD *coord) {
     bool hasSetRetErrno = false;
     bool sameRetErrno = true;
 
+    std::vector<int> errnos;
+    if (proj_trans_array_batched(P, direction, n, coord, errnos)) {
+        for (i = 0; i < n; i++) {
+            const int thisErrno = errnos[i];
+            if (thisErrno != 0) {
+                if (!hasSetRetErrno) {
+                    retErrno = thisErrno;
+                    hasSetRetErrno = true;
+                } else if (sameRetErrno && retErrno != thisErrno) {
+                    sameRetErrno = false;
+                    retErrno = PROJ_ERR_COORD_TRANSFM;
+                }
+            }
+        }
+        proj_context_errno_set(P->ctx, retErrno);
+        return retErrno;
+    }
+
     for (i = 0; i < n; i++) {
         proj_context_errno_set(P->ctx, 0);
         coord[i] = proj_trans(P, direction, coord[i]);
@@ -605,6 +708,522 @@ int proj_trans_array(PJ *P, PJ_DIRECTION direction, size_t n, PJ_COORD *coord) {
     return retErrno;
 }
 
+/*****************************************************************************/
+
+namespace {
+
+// Approximation of a transformation over a box of the input space, by
+// tensor product polynomial interpolation at Chebyshev nodes.
+struct ApproxTransformer {
+    static constexpr int N_NODES = 4;
+    static constexpr int N_CHECKS = 5;
+    // Boxes holding less points than this are transformed exactly, as it
+    // would cost about as much as fitting and checking an approximation.
+    static constexpr size_t MIN_POINTS =
+        2 * (N_NODES * N_NODES + N_CHECKS * N_CHECKS);
+    static constexpr int MAX_DEPTH = 12;
+
+    PJ *P;
+    PJ_DIRECTION direction;
+    PJ_COORD *coord;
+    double max_error_xy;
+    double max_error_z;
+    double z;
+    double t;
+    double nodes[N_NODES];
+    double denoms[N_NODES];
+    // Indices of the coordinates to transform exactly
+    std::vector<size_t> exactIdx{};
+
+    ApproxTransformer(PJ *PIn, PJ_DIRECTION directionIn, PJ_COORD *coordIn,
+                      double max_error_xyIn, double max_error_zIn, double zIn,
+                      double tIn)
+        : P(PIn), direction(directionIn), coord(coordIn),
+          max_error_xy(max_error_xyIn), max_error_z(max_error_zIn), z(zIn),
+          t(tIn) {
+        for (int k = 0; k < N_NODES; k++)
+            nodes[k] = cos((2 * k + 1) * M_PI / (2 * N_NODES));
+        for (int k = 0; k < N_NODES; k++) {
+            denoms[k] = 1;
+            for (int m = 0; m < N_NODES; m++) {
+                if (m != k)
+                    denoms[k] *= nodes[k] - nodes[m];
+            }
+        }
+    }
+
+    ApproxTransformer(const ApproxTransformer &) = delete;
+    ApproxTransformer &operator=(const ApproxTransformer &) = delete;
+
+    // Lagrange basis polynomials at u, in [-1,1]
+    void weights(double u, double *w) const {
+        for (int k = 0; k < N_NODES; k++) {
+            double num = 1;
+            for (int m = 0; m < N_NODES; m++) {
+                if (m != k)
+                    num *= u - nodes[m];
+            }
+            w[k] = num / denoms[k];
+        }
+    }
+
+    // Interpolate the values at the nodes. The components flagged as
+    // constant are copied from the first node.
+    PJ_COORD evaluate(const PJ_COORD *values, double u, double v,
+                      const bool *constant) const {
+        double wu[N_NODES], wv[N_NODES];
+        weights(u, wu);
+        weights(v, wv);
+        PJ_COORD res = {{0, 0, 0, 0}};
+        for (int j = 0; j < N_NODES; j++) {
+            for (int i = 0; i < N_NODES; i++) {
+                const double w = wu[i] * wv[j];
+                const PJ_COORD &value = values[j * N_NODES + i];
+                for (int c = 0; c < 4; c++)
+                    res.v[c] += w * value.v[c];
+            }
+        }
+        for (int c = 2; c < 4; c++) {
+            if (constant[c])
+                res.v[c] = values[0].v[c];
+        }
+        return res;
+    }
+
+    void run(double cx, double cy, double hx, double hy,
+             std::vector<size_t> &idx, int depth) {
+        if (idx.size() < MIN_POINTS || depth > MAX_DEPTH) {
+            exactIdx.insert(exactIdx.end(), idx.begin(), idx.end());
+            return;
+        }
+
+        // Reference values at the interpolation nodes, followed by the
+        // check points, evenly spaced over the box including its border
+        PJ_COORD ref[N_NODES * N_NODES + N_CHECKS * N_CHECKS];
+        int nRef = 0;
+        for (int j = 0; j < N_NODES; j++) {
+            for (int i = 0; i < N_NODES; i++)
+                ref[nRef++] = proj_coord(cx + nodes[i] * hx,
+                                         cy + nodes[j] * hy, z, t);
+        }
+        for (int j = 0; j < N_CHECKS; j++) {
+            for (int i = 0; i < N_CHECKS; i++)
+                ref[nRef++] = proj_coord(cx + checkPos(i) * hx,
+                                         cy + checkPos(j) * hy, z, t);
+        }
+        proj_trans_array(P, direction, nRef, ref);
+
+        bool ok = true;
+        for (int k = 0; ok && k < nRef; k++) {
+            for (int c = 0; c < 4; c++) {
+                if (ref[k].v[c] == HUGE_VAL || std::isnan(ref[k].v[c])) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        // z and t are most often passed through unchanged. Otherwise, z is
+        // interpolated if it has a tolerance, and t is never interpolated:
+        // splitting the box would not help, so transform it exactly.
+        bool constant[4] = {false, false, true, true};
+        for (int k = 1; ok && k < nRef; k++) {
+            for (int c = 2; c < 4; c++) {
+                if (ref[k].v[c] != ref[0].v[c])
+                    constant[c] = false;
+            }
+        }
+        if (ok && (!constant[3] || (!constant[2] && !(max_error_z > 0)))) {
+            exactIdx.insert(exactIdx.end(), idx.begin(), idx.end());
+            return;
+        }
+
+        for (int j = 0; ok && j < N_CHECKS; j++) {
+            for (int i = 0; ok && i < N_CHECKS; i++) {
+                const PJ_COORD approx =
+                    evaluate(ref, checkPos(i), checkPos(j), constant);
+                const PJ_COORD &exact =
+                    ref[N_NODES * N_NODES + j * N_CHECKS + i];
+                for (int c = 0; c < 3; c++) {
+                    const double max_error = c < 2 ? max_error_xy : max_error_z;
+                    if (!(fabs(approx.v[c] - exact.v[c]) <= max_error)) {
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (ok) {
+            for (const size_t k : idx) {
+                coord[k] = evaluate(ref, (coord[k].xy.x - cx) / hx,
+                                    (coord[k].xy.y - cy) / hy, constant);
+            }
+            return;
+        }
+
+        // Split the box in four quadrants
+        std::vector<size_t> quadrants[4];
+        for (const size_t k : idx) {
+            const int q = (coord[k].xy.x < cx ? 0 : 1) +
+                          (coord[k].xy.y < cy ? 0 : 2);
+            quadrants[q].push_back(k);
+        }
+        idx.clear();
+        idx.shrink_to_fit();
+        const double qhx = hx / 2;
+        const double qhy = hy / 2;
+        for (int q = 0; q < 4; q++) {
+            if (quadrants[q].empty())
+                continue;
+            run((q & 1) ? cx + qhx : cx - qhx, (q & 2) ? cy + qhy : cy - qhy,
+                qhx, qhy, quadrants[q], depth + 1);
+        }
+    }
+
+    static double checkPos(int i) {
+        return -1 + 2.0 * i / (N_CHECKS - 1);
+    }
+};
+
+} // anonymous namespace
+
+/*****************************************************************************/
+/** \brief Batch transform an array of PJ_COORD, approximating the
+ * transformation.
+ *
+ * Similar to proj_trans_array(), but suited to the transformation of large
+ * numbers of points in a bounded area, such as the pixels of a raster.
+ * The transformation is approximated by polynomials, interpolating the
+ * results of proj_trans() at Chebyshev nodes over the bounding box of the
+ * points. When the approximation departs from the results of proj_trans()
+ * by more than max_error at a regular grid of check points, the box is
+ * split in four, recursively, down to boxes holding too few points to be
+ * worth approximating, which are transformed exactly.
+ *
+ * The approximation is only used when all coordinates share the same third
+ * and fourth components. The third and fourth output components are copied
+ * when they do not vary over a box. Otherwise, the third component is
+ * approximated within max_error_z, and the points of a box whose fourth
+ * component varies are transformed exactly. Coordinates holding NaN or
+ * HUGE_VAL values are always transformed exactly. As the error is only
+ * checked at sampling points, the transformation should be smooth over the
+ * area of the coordinates.
+ *
+ * @param P The PJ object representing the transformation.
+ * @param direction The direction of the transformation.
+ * @param n Number of coordinates in coord.
+ * @param coord Array of coordinates, transformed in place.
+ * @param max_error_xy Maximum error of the approximation of the first two
+ *                     output components, in their unit. Coordinates are
+ *                     transformed exactly, as with proj_trans_array(), if it
+ *                     is not strictly positive.
+ * @param max_error_z Maximum error of the approximation of the third output
+ *                    component, in its unit. If it is not strictly positive,
+ *                    the third component is only approximated where it does
+ *                    not vary.
+ * @return 0 if all coordinates are transformed without error, otherwise an
+ *         error number, as returned by proj_trans_array().
+ * @since 9.5
+ */
+int proj_trans_array_approx(PJ *P, PJ_DIRECTION direction, size_t n,
+                            PJ_COORD *coord, double max_error_xy,
+                            double max_error_z) {
+    if (!(max_error_xy > 0) || direction == PJ_IDENT ||
+        n < ApproxTransformer::MIN_POINTS ||
+        (P->iso_obj != nullptr && !P->iso_obj_is_coordinate_operation))
+        return proj_trans_array(P, direction, n, coord);
+
+    std::vector<size_t> idx;
+    idx.reserve(n);
+    std::vector<size_t> exactIdx;
+    double xmin = HUGE_VAL, ymin = HUGE_VAL;
+    double xmax = -HUGE_VAL, ymax = -HUGE_VAL;
+    for (size_t i = 0; i < n; i++) {
+        const PJ_COORD &c = coord[i];
+        if (coord_has_nans(c) || c.v[0] == HUGE_VAL || c.v[1] == HUGE_VAL ||
+            c.v[2] == HUGE_VAL || c.v[3] == HUGE_VAL) {
+            exactIdx.push_back(i);
+            continue;
+        }
+        if (!idx.empty() && (c.v[2] != coord[idx.front()].v[2] ||
+                             c.v[3] != coord[idx.front()].v[3]))
+            return proj_trans_array(P, direction, n, coord);
+        idx.push_back(i);
+        xmin = std::min(xmin, c.xy.x);
+        xmax = std::max(xmax, c.xy.x);
+        ymin = std::min(ymin, c.xy.y);
+        ymax = std::max(ymax, c.xy.y);
+    }
+
+    if (!idx.empty()) {
+        double hx = (xmax - xmin) / 2;
+        double hy = (ymax - ymin) / 2;
+        if (hx == 0)
+            hx = hy;
+        if (hy == 0)
+            hy = hx;
+        const PJ_COORD &first = coord[idx.front()];
+        ApproxTransformer approx(P, direction, coord, max_error_xy,
+                                 max_error_z, first.v[2], first.v[3]);
+        if (hx > 0) {
+            approx.run((xmin + xmax) / 2, (ymin + ymax) / 2, hx, hy, idx, 0);
+        } else {
+            approx.exactIdx = std::move(idx);
+        }
+        exactIdx.insert(exactIdx.end(), approx.exactIdx.begin(),
+                        approx.exactIdx.end());
+    }
+
+    int retErrno = 0;
+    if (!exactIdx.empty()) {
+        std::vector<PJ_COORD> exactCoords;
+        exactCoords.reserve(exactIdx.size());
+        for (const size_t i : exactIdx)
+            exactCoords.push_back(coord[i]);
+        retErrno = proj_trans_array(P, direction, exactCoords.size(),
+                                    exactCoords.data());
+        for (size_t k = 0; k < exactIdx.size(); k++)
+            coord[exactIdx[k]] = exactCoords[k];
+    }
+    proj_context_errno_set(P->ctx, retErrno);
+    return retErrno;
+}
+
+/*****************************************************************************/
+// Identifiers of the objects destroyed since the last use of a
+// PJ_TRANS_STATE, among the sources of the copies it holds. Referenced
+// weakly by these sources, which push their identifier when destroyed.
+struct PJTransStateEvictions {
+    std::mutex mutex{};
+    std::vector<unsigned long long> ids{};
+    std::atomic<bool> pending{false};
+};
+
+/*****************************************************************************/
+// Per-thread execution state of transformations shared between threads.
+// It holds, for each shared PJ object it was used with, a copy of the
+// object bound to the context of the state. Copies are evicted when their
+// source object is destroyed, by the next call using the state.
+struct PJ_TRANS_STATE {
+    PJ_CONTEXT *ctx = nullptr;
+    // Copies, indexed by the instance_id of their source object
+    std::map<unsigned long long, PJ *> instances{};
+    std::shared_ptr<PJTransStateEvictions> evictions =
+        std::make_shared<PJTransStateEvictions>();
+
+    explicit PJ_TRANS_STATE(PJ_CONTEXT *ctxIn) : ctx(ctxIn) {}
+    PJ_TRANS_STATE(const PJ_TRANS_STATE &) = delete;
+    PJ_TRANS_STATE &operator=(const PJ_TRANS_STATE &) = delete;
+    ~PJ_TRANS_STATE();
+
+    PJ *getInstance(const PJ *P);
+
+  private:
+    void evictPending();
+};
+
+// Serializes the copies of shared objects that cannot be cloned structurally
+// and are instantiated again from their ISO19111 definition, as exporting it
+// is not guaranteed to be free of side effects.
+static std::mutex gSharedCloneMutex;
+
+/*****************************************************************************/
+PJ_TRANS_STATE::~PJ_TRANS_STATE() {
+    /*****************************************************************************/
+    for (auto &kv : instances)
+        proj_destroy(kv.second);
+}
+
+/*****************************************************************************/
+void PJ_TRANS_STATE::evictPending() {
+    /*****************************************************************************/
+    std::vector<unsigned long long> ids;
+    {
+        std::lock_guard<std::mutex> lock(evictions->mutex);
+        ids.swap(evictions->ids);
+        evictions->pending = false;
+    }
+    for (const auto id : ids) {
+        auto iter = instances.find(id);
+        if (iter != instances.end()) {
+            proj_destroy(iter->second);
+            instances.erase(iter);
+        }
+    }
+}
+
+/*****************************************************************************/
+void pj_trans_states_evict(const PJ *P) {
+    /*****************************************************************************
+        Called by proj_destroy(): mark the copies of P held by PJ_TRANS_STATE
+        objects for eviction. They are destroyed by the thread of their
+        state, which may be using other copies.
+    ******************************************************************************/
+    if (!P->hasTransStates)
+        return;
+    std::lock_guard<std::mutex> lock(P->transStatesMutex);
+    for (const auto &weakEvictions : P->transStates) {
+        const auto evictions = weakEvictions.lock();
+        if (evictions) {
+            std::lock_guard<std::mutex> evictionsLock(evictions->mutex);
+            evictions->ids.push_back(P->instance_id);
+            evictions->pending = true;
+        }
+    }
+}
+
+/*****************************************************************************/
+PJ *PJ_TRANS_STATE::getInstance(const PJ *P) {
+    /*****************************************************************************/
+    if (evictions->pending)
+        evictPending();
+
+    auto iter = instances.find(P->instance_id);
+    if (iter != instances.end())
+        return iter->second;
+
+    PJ *pj = nullptr;
+    if (P->iso_obj == nullptr || P->iso_obj_is_coordinate_operation)
+        pj = pj_clone_instantiated(ctx, P);
+    if (!pj) {
+        std::lock_guard<std::mutex> lock(gSharedCloneMutex);
+        pj = proj_clone(ctx, P);
+    }
+    if (!pj)
+        return nullptr;
+    {
+        // Register with P, forgetting the states destroyed since then
+        std::lock_guard<std::mutex> lock(P->transStatesMutex);
+        auto &states = P->transStates;
+        states.erase(std::remove_if(states.begin(), states.end(),
+                                    [](const std::weak_ptr<
+                                        PJTransStateEvictions> &state) {
+                                        return state.expired();
+                                    }),
+                     states.end());
+        states.push_back(evictions);
+        P->hasTransStates = true;
+    }
+    instances[P->instance_id] = pj;
+    return pj;
+}
+
+/*****************************************************************************/
+/** \brief Create the execution state of a thread using shared
+ * transformations.
+ *
+ * The returned object lets a thread transform coordinates with
+ * proj_trans_shared() and proj_trans_array_shared(), through PJ objects
+ * shared with other threads. The execution state of each transformation,
+ * including its error state, is bound to the context of the state, so that
+ * the shared objects are never modified: the first use of a transformation
+ * with a state makes a copy of it, as proj_clone() would, which the state
+ * keeps until the transformation is destroyed. Copies share the grids
+ * already opened by the transformation, whose reads are serialized between
+ * threads, rather than opening them again.
+ *
+ * A state, like its context, must only be used by one thread at a time.
+ *
+ * @param ctx Threading context, which must outlive the returned object.
+ * @return a new object to destroy with proj_trans_state_destroy(), or NULL
+ *         in case of error.
+ * @since 9.5
+ */
+PJ_TRANS_STATE *proj_trans_state_create(PJ_CONTEXT *ctx) {
+    if (!ctx)
+        ctx = pj_get_default_ctx();
+    return new (std::nothrow) PJ_TRANS_STATE(ctx);
+}
+
+/*****************************************************************************/
+/** \brief Destroy an object returned by proj_trans_state_create().
+ *
+ * @param state Object to destroy, or NULL.
+ * @since 9.5
+ */
+void proj_trans_state_destroy(PJ_TRANS_STATE *state) { delete state; }
+
+/*****************************************************************************/
+static PJ *proj_trans_state_get_instance(PJ_TRANS_STATE *state, const PJ *P) {
+    /*****************************************************************************/
+    if (!state)
+        return nullptr;
+    if (!P) {
+        proj_context_errno_set(state->ctx, PROJ_ERR_OTHER_API_MISUSE);
+        pj_log(state->ctx, PJ_LOG_ERROR, "%s: missing required input",
+               __FUNCTION__);
+        return nullptr;
+    }
+    try {
+        PJ *pj = state->getInstance(P);
+        if (!pj && proj_context_errno(state->ctx) == 0)
+            proj_context_errno_set(state->ctx, PROJ_ERR_OTHER);
+        return pj;
+    } catch (const std::exception &e) {
+        pj_log(state->ctx, PJ_LOG_ERROR, "%s: %s", __FUNCTION__, e.what());
+        proj_context_errno_set(state->ctx, PROJ_ERR_OTHER);
+    }
+    return nullptr;
+}
+
+/*****************************************************************************/
+/** \brief Transform a coordinate with a transformation shared between
+ * threads.
+ *
+ * Equivalent to proj_trans(), except that P is not modified, and may thus be
+ * used concurrently by several threads, each with its own state, as long as
+ * no other function modifying it, such as proj_trans(), is called at the
+ * same time. Errors are reported in the context of the state.
+ *
+ * @param P Transformation shared between threads.
+ * @param state Execution state of the calling thread, as returned by
+ *              proj_trans_state_create().
+ * @param direction The direction of the transformation.
+ * @param coord Coordinate to transform.
+ * @return the transformed coordinate, or an error coordinate.
+ * @since 9.5
+ */
+PJ_COORD proj_trans_shared(const PJ *P, PJ_TRANS_STATE *state,
+                           PJ_DIRECTION direction, PJ_COORD coord) {
+    PJ *pj = proj_trans_state_get_instance(state, P);
+    if (!pj)
+        return proj_coord_error();
+    return proj_trans(pj, direction, coord);
+}
+
+/*****************************************************************************/
+/** \brief Batch transform an array of PJ_COORD with a transformation shared
+ * between threads.
+ *
+ * Equivalent to proj_trans_array(), with the same sharing rules as
+ * proj_trans_shared().
+ *
+ * @param P Transformation shared between threads.
+ * @param state Execution state of the calling thread, as returned by
+ *              proj_trans_state_create().
+ * @param direction The direction of the transformation.
+ * @param n Number of coordinates in coord.
+ * @param coord Array of coordinates, transformed in place.
+ * @return 0 if all coordinates are transformed without error, otherwise an
+ *         error number, as returned by proj_trans_array().
+ * @since 9.5
+ */
+int proj_trans_array_shared(const PJ *P, PJ_TRANS_STATE *state,
+                            PJ_DIRECTION direction, size_t n,
+                            PJ_COORD *coord) {
+    PJ *pj = proj_trans_state_get_instance(state, P);
+    if (!pj) {
+        if (!state)
+            return PROJ_ERR_OTHER_API_MISUSE;
+        const int err = proj_context_errno(state->ctx);
+        for (size_t i = 0; i < n; i++)
+            coord[i] = proj_coord_error();
+        return err;
+    }
+    return proj_trans_array(pj, direction, n, coord);
+}
+
 /*************************************************************************************/
 size_t proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x, size_t sx,
                           size_t nx, double *y, size_t sy, size_t ny, double *z,
@@ -989,6 +1608,43 @@ static int cs2cs_emulation_setup(PJ *P) {
     return 1;
 }
 
+/*****************************************************************************/
+// Cache of the objects instantiated by pj_create_internal() in a context,
+// keyed by their normalized definition. The cached objects are templates,
+// never used for transformations: pj_create_internal() returns copies of
+// them.
+struct projPipelineCache {
+    NS_PROJ::lru11::Cache<std::string, std::shared_ptr<PJ>> cache;
+    size_t hits = 0;
+    size_t misses = 0;
+
+    explicit projPipelineCache(size_t maxSize) : cache(maxSize, 0) {}
+};
+
+/*****************************************************************************/
+void pj_pipeline_cache_destroy(projPipelineCache *cache) { delete cache; }
+
+/*****************************************************************************/
+static bool pj_pipeline_cache_key(size_t argc, char **argv, std::string &key) {
+    /*****************************************************************************
+        Build the key of a definition in the pipeline cache, from its
+    arguments, as split by pj_trim_argv(). Definitions expanding +init files
+    are not cached, as the content of the files may change.
+    ******************************************************************************/
+    key.clear();
+    for (size_t i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        if (*arg == '+')
+            ++arg;
+        if (strncmp(arg, "init=", 5) == 0)
+            return false;
+        if (i > 0)
+            key += ' ';
+        key += arg;
+    }
+    return true;
+}
+
 /*************************************************************************************/
 PJ *pj_create_internal(PJ_CONTEXT *ctx, const char *definition) {
     /*************************************************************************************/
@@ -1032,14 +1688,103 @@ PJ *pj_create_internal(PJ_CONTEXT *ctx, const char *definition) {
         return nullptr;
     }
 
+    std::string key;
+    projPipelineCache *cache = nullptr;
+    // Objects instantiated while ctx->forceOver is set differ from those
+    // created from the same definition otherwise: do not cache them.
+    if (ctx->pipelineCacheSize > 0 && !ctx->forceOver &&
+        pj_pipeline_cache_key(argc, argv, key)) {
+        if (!ctx->pipelineCache)
+            ctx->pipelineCache =
+                new (std::nothrow) projPipelineCache(ctx->pipelineCacheSize);
+        cache = ctx->pipelineCache;
+    }
+
+    std::shared_ptr<PJ> cached;
+    if (cache && cache->cache.tryGet(key, cached)) {
+        PJ *Q = pj_clone_instantiated(ctx, cached.get());
+        if (Q) {
+            cache->hits++;
+            ctx->last_errno = 0;
+            free(argv);
+            free(args);
+            return Q;
+        }
+    }
+
     PJ *P = pj_create_argv_internal(ctx, (int)argc, argv);
 
     free(argv);
     free(args);
 
+    if (cache) {
+        cache->misses++;
+        PJ *Q = P ? pj_clone_instantiated(ctx, P) : nullptr;
+        if (Q)
+            cache->cache.insert(key, std::shared_ptr<PJ>(Q, proj_destroy));
+    }
+
     return P;
 }
 
+/*****************************************************************************/
+/** \brief Set the maximum number of objects in the pipeline cache of a
+ * context.
+ *
+ * When enabled, the objects instantiated from PROJ strings, such as those of
+ * proj_create() or of the coordinate operations of
+ * proj_create_crs_to_crs(), are cached in the context, so that later
+ * instantiations of the same PROJ string return a copy of the cached object
+ * instead of parsing and setting it up again. The least recently used
+ * objects are evicted once the cache is full. Objects using grids of the
+ * PROJ 4 API, or whose definition uses +init, are not cached.
+ *
+ * Changing the size empties the cache.
+ *
+ * @param ctx Threading context, or NULL for the default context.
+ * @param max_entries Maximum number of cached objects. 0, the default,
+ *                    disables the cache.
+ * @since 9.5
+ */
+void proj_context_set_pipeline_cache_size(PJ_CONTEXT *ctx,
+                                          size_t max_entries) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    pj_pipeline_cache_destroy(ctx->pipelineCache);
+    ctx->pipelineCache = nullptr;
+    ctx->pipelineCacheSize = max_entries;
+}
+
+/*****************************************************************************/
+/** \brief Get statistics on the pipeline cache of a context.
+ *
+ * The counters are reset when the size of the cache is changed with
+ * proj_context_set_pipeline_cache_size().
+ *
+ * @param ctx Threading context, or NULL for the default context.
+ * @param out_hits Pointer to the number of definitions found in the cache,
+ *                 or NULL.
+ * @param out_misses Pointer to the number of definitions not found in the
+ *                   cache, or NULL.
+ * @param out_entries Pointer to the number of objects in the cache, or NULL.
+ * @since 9.5
+ */
+void proj_context_get_pipeline_cache_stats(PJ_CONTEXT *ctx, size_t *out_hits,
+                                           size_t *out_misses,
+                                           size_t *out_entries) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    const projPipelineCache *cache = ctx->pipelineCache;
+    if (out_hits)
+        *out_hits = cache ? cache->hits : 0;
+    if (out_misses)
+        *out_misses = cache ? cache->misses : 0;
+    if (out_entries)
+        *out_entries = cache ? cache->cache.size() : 0;
+}
+
 /*************************************************************************************/
 PJ *proj_create_argv(PJ_CONTEXT *ctx, int argc, char **argv) {
     /**************************************************************************************
@@ -1641,6 +2386,126 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
     return true;
 }
 
+/*****************************************************************************/
+bool pj_prepare_for_area(PJ *P, PJ_DIRECTION direction,
+                         const std::vector<PJ_COORD> &points,
+                         size_t &bytesLoaded) {
+    /*****************************************************************************
+    Load the resources needed to transform points with P, or with the
+    alternative coordinate operations of P whose area of use intersects them.
+    ******************************************************************************/
+    if (!P->alternativeCoordinateOperations.empty()) {
+        double minx, miny, maxx, maxy;
+        if (!NS_PROJ::pj_get_points_extent(points, minx, miny, maxx, maxy))
+            return true;
+        bool ret = true;
+        for (auto &alt : P->alternativeCoordinateOperations) {
+            const bool isFwd = direction == PJ_FWD;
+            const auto geocentricToLonLat = isFwd
+                                                ? alt.pjSrcGeocentricToLonLat
+                                                : alt.pjDstGeocentricToLonLat;
+            if (geocentricToLonLat == nullptr) {
+                const double altMinx = isFwd ? alt.minxSrc : alt.minxDst;
+                const double altMiny = isFwd ? alt.minySrc : alt.minyDst;
+                const double altMaxx = isFwd ? alt.maxxSrc : alt.maxxDst;
+                const double altMaxy = isFwd ? alt.maxySrc : alt.maxyDst;
+                // altMinx > altMaxx when crossing the antimeridian
+                if (maxy < altMiny || miny > altMaxy ||
+                    (altMinx <= altMaxx && (maxx < altMinx || minx > altMaxx)))
+                    continue;
+            }
+            alt.instantiate();
+            std::vector<PJ_COORD> altPoints(points);
+            if (alt.pj->hasCoordinateEpoch) {
+                for (auto &point : altPoints)
+                    point.xyzt.t = alt.pj->coordinateEpoch;
+            }
+            if (!pj_prepare_for_area(alt.pj, direction, altPoints,
+                                     bytesLoaded))
+                ret = false;
+        }
+        return ret;
+    }
+
+    if (P->prepare_for_area == nullptr)
+        return true;
+    return P->prepare_for_area(P, direction, points, bytesLoaded);
+}
+
+/*****************************************************************************/
+/** \brief Load the resources needed to transform coordinates in an area.
+ *
+ * Transformations using grids (hgridshift, vgridshift, gridshift,
+ * xyzgridshift and defmodel steps) otherwise read the grid data lazily,
+ * when transforming the first points falling in each part of the grids,
+ * which may involve network requests when networking is enabled.
+ * This function determines the parts of the grids that intersect the area,
+ * by transforming a regular sampling of it through the steps of P, and loads
+ * them ahead of time, so that later calls to proj_trans() and similar
+ * functions in the area do not have to.
+ *
+ * The data stays loaded until the next call to this function with P, or
+ * until P is destroyed.
+ *
+ * @param P The PJ object representing the transformation.
+ * @param direction The direction of the transformation.
+ * @param xmin Minimum coordinate of the first axis of the area, in the
+ *             units of the coordinates passed to proj_trans().
+ * @param ymin Minimum coordinate of the second axis of the area.
+ * @param xmax Maximum coordinate of the first axis of the area.
+ * @param ymax Maximum coordinate of the second axis of the area.
+ * @param out_bytes_loaded Pointer to the number of bytes of grid data
+ *             loaded by this call, or NULL.
+ * @return an integer. 1 if successful. 0 if failures encountered.
+ * @since 9.5
+ */
+int proj_prepare_for_area(PJ *P, PJ_DIRECTION direction, double xmin,
+                          double ymin, double xmax, double ymax,
+                          size_t *out_bytes_loaded) {
+    if (out_bytes_loaded)
+        *out_bytes_loaded = 0;
+    if (P == nullptr) {
+        proj_log_error(P, _("NULL P object not allowed."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+    if (direction == PJ_IDENT)
+        return true;
+    if (P->inverted)
+        direction = opposite_direction(direction);
+
+    if (P->iso_obj != nullptr && !P->iso_obj_is_coordinate_operation) {
+        proj_log_error(P, _("Object is not a coordinate operation"));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+
+    constexpr int SAMPLES_PER_SIDE = 21;
+    std::vector<PJ_COORD> points;
+    points.reserve(SAMPLES_PER_SIDE * SAMPLES_PER_SIDE);
+    const double dx = (xmax - xmin) / (SAMPLES_PER_SIDE - 1);
+    const double dy = (ymax - ymin) / (SAMPLES_PER_SIDE - 1);
+    for (int j = 0; j < SAMPLES_PER_SIDE; ++j) {
+        for (int i = 0; i < SAMPLES_PER_SIDE; ++i) {
+            points.emplace_back(proj_coord(xmin + i * dx, ymin + j * dy, 0, 0));
+        }
+    }
+
+    // Transforming the sampling points through the steps may set errors
+    // that must not be reported.
+    const int last_errno = proj_errno_reset(P);
+    size_t bytesLoaded = 0;
+    const bool ret = pj_prepare_for_area(P, direction, points, bytesLoaded);
+    proj_errno_restore(P, last_errno);
+    if (out_bytes_loaded)
+        *out_bytes_loaded = bytesLoaded;
+    if (!ret) {
+        proj_log_error(P, _("Cannot load all the grids needed in the area."));
+        proj_errno_set(P, PROJ_ERR_OTHER);
+    }
+    return ret;
+}
+
 /*****************************************************************************/
 static void reproject_bbox(PJ *pjGeogToCrs, double west_lon, double south_lat,
                            double east_lon, double north_lat, double &minx,
@@ -1690,23 +2555,21 @@ static void reproject_bbox(PJ *pjGeogToCrs, double west_lon, double south_lat,
     }
 }
 
+// Bounding boxes of areas of use, as [min|max][x|y] in the source CRS then in
+// the target CRS, keyed by the west, south, east and north longitudes and
+// latitudes of the areas. Many candidate operations share an area of use.
+typedef std::map<std::array<double, 4>, std::array<double, 8>>
+    ReprojectedBBoxCache;
+
 /*****************************************************************************/
 static PJ *add_coord_op_to_list(
     int idxInOriginalList, PJ *op, double west_lon, double south_lat,
     double east_lon, double north_lat, PJ *pjGeogToSrc, PJ *pjGeogToDst,
     const PJ *pjSrcGeocentricToLonLat, const PJ *pjDstGeocentricToLonLat,
-    const char *areaName, std::vector<PJCoordOperation> &altCoordOps) {
+    const char *areaName, ReprojectedBBoxCache &bboxCache,
+    std::vector<PJCoordOperation> &altCoordOps) {
     /*****************************************************************************/
 
-    double minxSrc;
-    double minySrc;
-    double maxxSrc;
-    double maxySrc;
-    double minxDst;
-    double minyDst;
-    double maxxDst;
-    double maxyDst;
-
     double w = west_lon / 180 * M_PI;
     double s = south_lat / 180 * M_PI;
     double e = east_lon / 180 * M_PI;
@@ -1717,25 +2580,39 @@ static PJ *add_coord_op_to_list(
     // Integrate cos(lat) between south_lat and north_lat
     const double pseudoArea = (e - w) * (std::sin(n) - std::sin(s));
 
-    if (pjSrcGeocentricToLonLat) {
-        minxSrc = west_lon;
-        minySrc = south_lat;
-        maxxSrc = east_lon;
-        maxySrc = north_lat;
-    } else {
-        reproject_bbox(pjGeogToSrc, west_lon, south_lat, east_lon, north_lat,
-                       minxSrc, minySrc, maxxSrc, maxySrc);
-    }
+    const std::array<double, 4> area{{west_lon, south_lat, east_lon, north_lat}};
+    auto iter = bboxCache.find(area);
+    if (iter == bboxCache.end()) {
+        std::array<double, 8> bbox;
+        if (pjSrcGeocentricToLonLat) {
+            bbox[0] = west_lon;
+            bbox[1] = south_lat;
+            bbox[2] = east_lon;
+            bbox[3] = north_lat;
+        } else {
+            reproject_bbox(pjGeogToSrc, west_lon, south_lat, east_lon,
+                           north_lat, bbox[0], bbox[1], bbox[2], bbox[3]);
+        }
 
-    if (pjDstGeocentricToLonLat) {
-        minxDst = west_lon;
-        minyDst = south_lat;
-        maxxDst = east_lon;
-        maxyDst = north_lat;
-    } else {
-        reproject_bbox(pjGeogToDst, west_lon, south_lat, east_lon, north_lat,
-                       minxDst, minyDst, maxxDst, maxyDst);
+        if (pjDstGeocentricToLonLat) {
+            bbox[4] = west_lon;
+            bbox[5] = south_lat;
+            bbox[6] = east_lon;
+            bbox[7] = north_lat;
+        } else {
+            reproject_bbox(pjGeogToDst, west_lon, south_lat, east_lon,
+                           north_lat, bbox[4], bbox[5], bbox[6], bbox[7]);
+        }
+        iter = bboxCache.emplace(area, bbox).first;
     }
+    const double minxSrc = iter->second[0];
+    const double minySrc = iter->second[1];
+    const double maxxSrc = iter->second[2];
+    const double maxySrc = iter->second[3];
+    const double minxDst = iter->second[4];
+    const double minyDst = iter->second[5];
+    const double maxxDst = iter->second[6];
+    const double maxyDst = iter->second[7];
 
     if (minxSrc <= maxxSrc && minxDst <= maxxDst) {
         const char *c_name = proj_get_name(op);
@@ -1746,6 +2623,8 @@ static PJ *add_coord_op_to_list(
             idxInOriginalList, minxSrc, minySrc, maxxSrc, maxySrc, minxDst,
             minyDst, maxxDst, maxyDst, op, name, accuracy, pseudoArea, areaName,
             pjSrcGeocentricToLonLat, pjDstGeocentricToLonLat);
+        // op was created by pj_list_get_deferred()
+        altCoordOps.back().instantiationDeferred = true;
         op = nullptr;
     }
     return op;
@@ -1999,12 +2878,15 @@ pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
 
     try {
         std::vector<PJCoordOperation> preparedOpList;
+        ReprojectedBBoxCache bboxCache;
 
         // Iterate over source->target candidate transformations and reproject
-        // their long-lat bounding box into the source CRS.
+        // their long-lat bounding box into the source CRS. Their instantiation
+        // is deferred until they are used, as most of them are never
+        // selected.
         const auto op_count = proj_list_get_count(op_list);
         for (int i = 0; i < op_count; i++) {
-            auto op = proj_list_get(ctx, op_list, i);
+            auto op = pj_list_get_deferred(ctx, op_list, i);
             assert(op);
             double west_lon = 0.0;
             double south_lat = 0.0;
@@ -2024,18 +2906,21 @@ pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
                 op = add_coord_op_to_list(
                     i, op, west_lon, south_lat, east_lon, north_lat,
                     pjGeogToSrc, pjGeogToDst, pjSrcGeocentricToLonLat,
-                    pjDstGeocentricToLonLat, areaName, preparedOpList);
+                    pjDstGeocentricToLonLat, areaName, bboxCache,
+                    preparedOpList);
             } else {
-                auto op_clone = proj_clone(ctx, op);
+                auto op_clone = pj_list_get_deferred(ctx, op_list, i);
 
                 op = add_coord_op_to_list(
                     i, op, west_lon, south_lat, 180, north_lat, pjGeogToSrc,
                     pjGeogToDst, pjSrcGeocentricToLonLat,
-                    pjDstGeocentricToLonLat, areaName, preparedOpList);
+                    pjDstGeocentricToLonLat, areaName, bboxCache,
+                    preparedOpList);
                 op_clone = add_coord_op_to_list(
                     i, op_clone, -180, south_lat, east_lon, north_lat,
                     pjGeogToSrc, pjGeogToDst, pjSrcGeocentricToLonLat,
-                    pjDstGeocentricToLonLat, areaName, preparedOpList);
+                    pjDstGeocentricToLonLat, areaName, bboxCache,
+                    preparedOpList);
                 proj_destroy(op_clone);
             }
 
@@ -2365,6 +3250,7 @@ PJ *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx, const PJ *source_crs,
 
     // If there's finally juste a single result, return it directly
     if (preparedOpList.size() == 1) {
+        preparedOpList[0].instantiate();
         auto retP = preparedOpList[0].pj;
         preparedOpList[0].pj = nullptr;
         proj_destroy(P);
@@ -2613,15 +3499,17 @@ PJ_PROJ_INFO proj_pj_info(PJ *P) {
     /* coordinate operation description */
     if (!P->alternativeCoordinateOperations.empty()) {
         if (P->iCurCoordOp >= 0) {
-            P = P->alternativeCoordinateOperations[P->iCurCoordOp].pj;
+            auto &op = P->alternativeCoordinateOperations[P->iCurCoordOp];
+            op.instantiate();
+            P = op.pj;
         } else {
-            PJ *candidateOp = nullptr;
+            PJCoordOperation *candidateOp = nullptr;
             // If there's just a single coordinate operation which is
             // instanciable, use it.
-            for (const auto &op : P->alternativeCoordinateOperations) {
+            for (auto &op : P->alternativeCoordinateOperations) {
                 if (op.isInstantiable()) {
                     if (candidateOp == nullptr) {
-                        candidateOp = op.pj;
+                        candidateOp = &op;
                     } else {
                         candidateOp = nullptr;
                         break;
@@ -2629,7 +3517,8 @@ PJ_PROJ_INFO proj_pj_info(PJ *P) {
                 }
             }
             if (candidateOp) {
-                P = candidateOp;
+                candidateOp->instantiate();
+                P = candidateOp->pj;
             } else {
                 pjinfo.id = "unknown";
                 pjinfo.description = "unavailable until proj_trans is called";
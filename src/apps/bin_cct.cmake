@@ -2,8 +2,9 @@ set(CCT_SRC
   cct.cpp
   proj_strtod.cpp
   proj_strtod.h
+  utils.cpp
 )
-set(CCT_INCLUDE optargpm.h)
+set(CCT_INCLUDE optargpm.h utils.h)
 
 source_group("Source Files\\Bin" FILES ${CCT_SRC})
 
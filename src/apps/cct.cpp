@@ -82,11 +82,14 @@ Thomas Knudsen, thokn@sdfe.dk, 2016-05-25/2017-10-26
 #include <cstdint>
 #include <fstream> // std::ifstream
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "optargpm.h"
 #include "proj.h"
 #include "proj_internal.h"
 #include "proj_strtod.h"
+#include "utils.h"
 
 static void logger(void *data, int level, const char *msg);
 static void print(PJ_LOG_LEVEL log_level, const char *fmt, ...);
@@ -117,6 +120,12 @@ static const char usage[] = {
     "    -z value          Provide a fixed z value for all input data (e.g. -z "
     "0)\n"
     "    -s n              Skip n first lines of a infile\n"
+    "    --batch-size n    Transform the input by batches of n records.\n"
+    "                      Defaults to 1 for terminal input, 1000 otherwise\n"
+    "    --binary-input    Read records of little-endian float64 values\n"
+    "    --binary-output   Write records of little-endian float64 values\n"
+    "    --binary-dims n   Number of values (2 to 4) in binary records.\n"
+    "                      Defaults to 3\n"
     "    -v                Verbose: Provide non-essential informational "
     "output.\n"
     "                      Repeat -v for more verbosity (e.g. -vv)\n"
@@ -224,14 +233,18 @@ int main(int argc, char **argv) {
     char whitespace[] = " ";
     int i, nfields = 4, skip_lines = 0, verbose;
     double fixed_z = HUGE_VAL, fixed_time = HUGE_VAL;
+    int batch_size = 0;
+    bool binary_input = false, binary_output = false;
+    int binary_dims = 3;
     int decimals_angles = 10;
     int decimals_distances = 4;
     int columns_xyzt[] = {1, 2, 3, 4};
-    const char *longflags[] = {"v=verbose", "h=help", "I=inverse", "version",
+    const char *longflags[] = {"v=verbose",    "h=help",        "I=inverse",
+                               "version",      "binary-input", "binary-output",
                                nullptr};
-    const char *longkeys[] = {"o=output", "c=columns", "d=decimals",
-                              "z=height", "t=time",    "s=skip-lines",
-                              nullptr};
+    const char *longkeys[] = {"o=output",   "c=columns",   "d=decimals",
+                              "z=height",   "t=time",      "s=skip-lines",
+                              "batch-size", "binary-dims", nullptr};
 
     fout = stdout;
 
@@ -261,8 +274,11 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    binary_input = opt_given(o, "binary-input") != 0;
+    binary_output = opt_given(o, "binary-output") != 0;
+
     if (opt_given(o, "o"))
-        fout = fopen(opt_arg(o, "output"), "wt");
+        fout = fopen(opt_arg(o, "output"), binary_output ? "wb" : "wt");
     if (nullptr == fout) {
         print(PJ_LOG_ERROR, "%s: Cannot open '%s' for output", o->progname,
               opt_arg(o, "output"));
@@ -292,6 +308,36 @@ int main(int argc, char **argv) {
         skip_lines = atoi(opt_arg(o, "s"));
     }
 
+    if (opt_given(o, "binary-dims")) {
+        binary_dims = atoi(opt_arg(o, "binary-dims"));
+        if (binary_dims < 2 || binary_dims > 4) {
+            print(PJ_LOG_ERROR, "%s: Invalid number of binary dimensions: '%s'",
+                  o->progname, opt_arg(o, "binary-dims"));
+            free(o);
+            if (stdout != fout)
+                fclose(fout);
+            return 1;
+        }
+    }
+
+    if (opt_given(o, "batch-size")) {
+        batch_size = atoi(opt_arg(o, "batch-size"));
+        if (batch_size < 1) {
+            print(PJ_LOG_ERROR, "%s: Invalid batch size: '%s'", o->progname,
+                  opt_arg(o, "batch-size"));
+            free(o);
+            if (stdout != fout)
+                fclose(fout);
+            return 1;
+        }
+    } else if (binary_input || o->fargc > 0) {
+        batch_size = DEFAULT_BATCH_SIZE;
+    } else {
+        /* Text read from stdin may come from a process that waits for the
+         * output of each line before writing the next one */
+        batch_size = 1;
+    }
+
     if (opt_given(o, "c")) {
         int ncols;
         /* reset column numbers to ease comment output later on */
@@ -441,11 +487,171 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    /* Records are buffered until batch_size of them have been read, and the
+     * coordinates of a batch are transformed with a single proj_trans_array()
+     * call. The output is flushed once per batch. */
+    enum RecordKind { RECORD_VERBATIM, RECORD_UNREADABLE, RECORD_POINT };
+    struct InputRecord {
+        RecordKind kind = RECORD_POINT;
+        int record_index = 0;
+        PJ_COORD point = proj_coord(0, 0, 0, 0);
+        std::string line{};
+    };
+    std::vector<InputRecord> records;
+    std::vector<PJ_COORD> points;
+    std::vector<double> binary_values;
+    records.reserve(batch_size);
+    points.reserve(batch_size);
+
+    if (binary_output && fout == stdout)
+        set_binary_mode(stdout);
+
+    const auto transform_records = [&]() {
+        points.clear();
+        binary_values.clear();
+        for (const auto &record : records) {
+            if (record.kind == RECORD_POINT)
+                points.push_back(record.point);
+        }
+        int err = proj_errno_reset(P);
+        int batch_errno = 0;
+        if (!points.empty()) {
+            batch_errno = proj_trans_array(P, direction, points.size(),
+                                           points.data());
+        }
+
+        size_t point_index = 0;
+        for (auto &record : records) {
+            char *bufptr = &record.line[0];
+            if (record.kind == RECORD_VERBATIM) {
+                if (!binary_output)
+                    fprintf(fout, "%s", bufptr);
+                continue;
+            }
+            if (record.kind == RECORD_UNREADABLE) {
+                /* keep the binary output aligned with the input records */
+                if (binary_output)
+                    binary_values.insert(binary_values.end(), binary_dims,
+                                         HUGE_VAL);
+                else
+                    print(PJ_LOG_NONE, "# Record %d UNREADABLE: %s",
+                          record.record_index, bufptr);
+                continue;
+            }
+
+            point = points[point_index++];
+            if (HUGE_VAL == point.xyzt.x && binary_output) {
+                binary_values.insert(binary_values.end(), point.v,
+                                     point.v + binary_dims);
+                continue;
+            }
+            if (HUGE_VAL == point.xyzt.x) {
+                /* transformation error. If the points of the batch failed
+                 * for different reasons, proj_trans_array() returns a generic
+                 * error code, so transform the point again to get its own. */
+                int point_errno = batch_errno;
+                if (point_errno == PROJ_ERR_COORD_TRANSFM) {
+                    proj_errno_reset(P);
+                    proj_trans(P, direction, record.point);
+                    point_errno = proj_errno(P);
+                }
+                print(PJ_LOG_NONE, "# Record %d TRANSFORMATION ERROR: %s (%s)",
+                      record.record_index, bufptr,
+                      proj_errno_string(point_errno));
+                continue;
+            }
+
+            /* convert radians to degrees before output */
+            if (proj_angular_output(P, direction)) {
+                point.lpzt.lam = proj_todeg(point.lpzt.lam);
+                point.lpzt.phi = proj_todeg(point.lpzt.phi);
+            }
+
+            if (binary_output) {
+                binary_values.insert(binary_values.end(), point.v,
+                                     point.v + binary_dims);
+                continue;
+            }
+
+            /* handle comment string */
+            char *comment = column(bufptr, nfields + 1);
+            if (opt_given(o, "c")) {
+                /* what number is the last coordinate column in the input data?
+                 */
+                int colmax = 0;
+                for (i = 0; i < 4; i++)
+                    colmax = MAX(colmax, columns_xyzt[i]);
+                comment = column(bufptr, colmax + 1);
+            }
+            /* remove the line feed from comment, as it is added back below */
+            size_t len = strlen(comment);
+            if (len >= 1)
+                comment[len - 1] = '\0';
+            const char *comment_delimiter =
+                *comment ? whitespace : blank_comment;
+
+            /* Time to print the result */
+            /* use same arguments to printf format string for both radians and
+               degrees */
+            if (proj_angular_output(P, direction) ||
+                proj_degree_output(P, direction)) {
+                fprintf(fout, "%14.*f  %14.*f  %12.*f  %12.4f%s%s\n",
+                        decimals_angles, point.xyzt.x, decimals_angles,
+                        point.xyzt.y, decimals_distances, point.xyzt.z,
+                        point.xyzt.t, comment_delimiter, comment);
+            } else
+                fprintf(fout, "%13.*f  %13.*f  %12.*f  %12.4f%s%s\n",
+                        decimals_distances, point.xyzt.x, decimals_distances,
+                        point.xyzt.y, decimals_distances, point.xyzt.z,
+                        point.xyzt.t, comment_delimiter, comment);
+        }
+        proj_errno_restore(P, err);
+
+        if (!binary_values.empty()) {
+            write_float64_records(fout, binary_values.data(), binary_dims,
+                                  binary_values.size() / binary_dims);
+        }
+        records.clear();
+        if (fout == stdout)
+            fflush(stdout);
+    };
+
     /* Loop over all records of all input files */
     int previous_index = -1;
     bool gotError = false;
-    while (opt_input_loop(o, optargs_file_format_text, &gotError)) {
-        int err;
+    if (binary_input) {
+        if (o->fargc == 0)
+            set_binary_mode(stdin);
+        std::vector<double> values(static_cast<size_t>(batch_size) *
+                                   binary_dims);
+        int record_index = 0;
+        while (opt_input_loop(o, optargs_file_format_binary, &gotError)) {
+            if (o->input_index != previous_index) {
+                previous_index = o->input_index;
+                record_index = 0;
+            }
+            const size_t n = read_float64_records(o->input, values.data(),
+                                                  binary_dims, batch_size);
+            for (size_t j = 0; j < n; j++) {
+                const double *v = values.data() + j * binary_dims;
+                InputRecord record;
+                record.record_index = ++record_index;
+                record.point = proj_coord(
+                    v[0], v[1], binary_dims > 2 ? v[2] : fixed_z,
+                    binary_dims > 3 ? v[3] : fixed_time);
+                if (binary_dims == 2 && fixed_z == HUGE_VAL)
+                    record.point.xyzt.z = 0;
+                if (proj_angular_input(P, direction)) {
+                    record.point.lpzt.lam = proj_torad(record.point.lpzt.lam);
+                    record.point.lpzt.phi = proj_torad(record.point.lpzt.phi);
+                }
+                records.emplace_back(std::move(record));
+            }
+            transform_records();
+        }
+    }
+    while (!binary_input &&
+           opt_input_loop(o, optargs_file_format_text, &gotError)) {
         char *bufptr = fgets(buf, BUFFER_SIZE - 1, o->input);
         if (opt_eof(o)) {
             continue;
@@ -471,77 +677,30 @@ int main(int argc, char **argv) {
             continue;
         }
 
+        InputRecord record;
+        record.record_index = (int)o->record_index;
+        record.point = point;
+        record.line = bufptr;
+
         /* if it's a comment or blank line, we reflect it */
         const char *c = column(bufptr, 1);
         if (c && ((*c == '\0') || (*c == '#'))) {
-            fprintf(fout, "%s", bufptr);
-            continue;
-        }
-
-        if (HUGE_VAL == point.xyzt.x) {
+            record.kind = RECORD_VERBATIM;
+        } else if (HUGE_VAL == point.xyzt.x) {
             /* otherwise, it must be a syntax error */
-            print(PJ_LOG_NONE, "# Record %d UNREADABLE: %s",
-                  (int)o->record_index, bufptr);
+            record.kind = RECORD_UNREADABLE;
             print(PJ_LOG_ERROR, "%s: Could not parse file '%s' line %d",
                   o->progname, opt_filename(o), opt_record(o));
-            continue;
-        }
-
-        if (proj_angular_input(P, direction)) {
-            point.lpzt.lam = proj_torad(point.lpzt.lam);
-            point.lpzt.phi = proj_torad(point.lpzt.phi);
-        }
-        err = proj_errno_reset(P);
-        /* coverity[returned_value] */
-        point = proj_trans(P, direction, point);
-
-        if (HUGE_VAL == point.xyzt.x) {
-            /* transformation error */
-            print(PJ_LOG_NONE, "# Record %d TRANSFORMATION ERROR: %s (%s)",
-                  (int)o->record_index, bufptr,
-                  proj_errno_string(proj_errno(P)));
-            proj_errno_restore(P, err);
-            continue;
+        } else if (proj_angular_input(P, direction)) {
+            record.point.lpzt.lam = proj_torad(record.point.lpzt.lam);
+            record.point.lpzt.phi = proj_torad(record.point.lpzt.phi);
         }
-        proj_errno_restore(P, err);
 
-        /* handle comment string */
-        char *comment = column(bufptr, nfields + 1);
-        if (opt_given(o, "c")) {
-            /* what number is the last coordinate column in the input data? */
-            int colmax = 0;
-            for (i = 0; i < 4; i++)
-                colmax = MAX(colmax, columns_xyzt[i]);
-            comment = column(bufptr, colmax + 1);
-        }
-        /* remove the line feed from comment, as logger() above, invoked
-           by print() below (output), will add one */
-        size_t len = strlen(comment);
-        if (len >= 1)
-            comment[len - 1] = '\0';
-        const char *comment_delimiter = *comment ? whitespace : blank_comment;
-
-        /* Time to print the result */
-        /* use same arguments to printf format string for both radians and
-           degrees; convert radians to degrees before printing */
-        if (proj_angular_output(P, direction) ||
-            proj_degree_output(P, direction)) {
-            if (proj_angular_output(P, direction)) {
-                point.lpzt.lam = proj_todeg(point.lpzt.lam);
-                point.lpzt.phi = proj_todeg(point.lpzt.phi);
-            }
-            print(PJ_LOG_NONE, "%14.*f  %14.*f  %12.*f  %12.4f%s%s",
-                  decimals_angles, point.xyzt.x, decimals_angles, point.xyzt.y,
-                  decimals_distances, point.xyzt.z, point.xyzt.t,
-                  comment_delimiter, comment);
-        } else
-            print(PJ_LOG_NONE, "%13.*f  %13.*f  %12.*f  %12.4f%s%s",
-                  decimals_distances, point.xyzt.x, decimals_distances,
-                  point.xyzt.y, decimals_distances, point.xyzt.z, point.xyzt.t,
-                  comment_delimiter, comment);
-        if (fout == stdout)
-            fflush(stdout);
+        records.emplace_back(std::move(record));
+        if (records.size() >= static_cast<size_t>(batch_size))
+            transform_records();
     }
+    transform_records();
 
     proj_destroy(P);
 
@@ -39,6 +39,7 @@
 #include <cstdint>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <proj/io.hpp>
@@ -76,6 +77,11 @@ static const char *oform =
     nullptr;                  /* output format for x-y or decimal degrees */
 static char oform_buffer[16]; /* buffer for oform when using -d */
 static const char *oterr = "*\t*"; /* output line for unprojectable input */
+static int batchSize = 0;          /* number of records per transformation */
+static bool oformIsG15 = false;    /* oform is %.15g */
+static bool binaryInput = false;   /* read little-endian float64 records */
+static bool binaryOutput = false;  /* write little-endian float64 records */
+static int binaryDims = 3;         /* number of values in binary records */
 static const char *usage =
     "%s\nusage: %s [-dDeEfIlrstvwW [args]]\n"
     "              [[--area name_or_code] | [--bbox "
@@ -84,6 +90,8 @@ static const char *usage =
     "              [--accuracy {accuracy}] [--only-best[=yes|=no]] "
     "[--no-ballpark]\n"
     "              [--s_epoch {epoch}] [--t_epoch {epoch}]\n"
+    "              [--batch-size {n}] [--binary-input] [--binary-output]\n"
+    "              [--binary-dims {n}]\n"
     "              [+opt[=arg] ...] [+to +opt[=arg] ...] [file ...]\n";
 
 static double (*informat)(const char *,
@@ -94,6 +102,144 @@ using namespace NS_PROJ::metadata;
 using namespace NS_PROJ::util;
 using namespace NS_PROJ::internal;
 
+/************************************************************************/
+/*                            print_number()                            */
+/************************************************************************/
+static void print_number(double val) {
+    char buffer[32];
+    if (oformIsG15 && formatShortestDouble15(val, buffer))
+        fputs(buffer, stdout);
+    else
+        limited_fprintf_for_number(stdout, oform, val);
+}
+
+/************************************************************************/
+/*                             InputRecord                              */
+/*                                                                      */
+/*      Input line buffered until the batch it belongs to is            */
+/*      transformed.                                                    */
+/************************************************************************/
+struct InputRecord {
+    bool verbatim = false;    /* tagged line, output as it is */
+    bool transform = false;   /* coord must be transformed */
+    std::string line{};       /* input line, after the BOM */
+    size_t rest = 0;          /* offset in line of the text after z */
+    PJ_COORD coord = {{0, 0, 0, 0}};
+};
+
+/************************************************************************/
+/*                           output_records()                           */
+/*                                                                      */
+/*      Transform the coordinates of a batch of records and write       */
+/*      them.                                                           */
+/************************************************************************/
+static void output_records(std::vector<InputRecord> &records,
+                           std::vector<PJ_COORD> &coords) {
+    char pline[40];
+    PJ_UV data;
+    std::vector<double> values;
+
+    coords.clear();
+    for (const auto &record : records) {
+        if (record.transform)
+            coords.push_back(record.coord);
+    }
+    if (!coords.empty())
+        proj_trans_array(transformation, PJ_FWD, coords.size(), coords.data());
+
+    size_t coordIdx = 0;
+    for (auto &record : records) {
+        if (record.verbatim) {
+            if (!binaryOutput)
+                fputs(record.line.c_str(), stdout);
+            continue;
+        }
+
+        if (binaryOutput) {
+            /* values in the units of the target CRS */
+            PJ_COORD coord =
+                record.transform ? coords[coordIdx++] : record.coord;
+            if (reverseout)
+                std::swap(coord.xyzt.x, coord.xyzt.y);
+            values.insert(values.end(), coord.v, coord.v + binaryDims);
+            continue;
+        }
+
+        if (echoin) {
+            fwrite(record.line.data(), 1, record.rest, stdout);
+            putchar('\t');
+        }
+
+        const PJ_COORD &coord =
+            record.transform ? coords[coordIdx++] : record.coord;
+        data.u = coord.xyz.x;
+        data.v = coord.xyz.y;
+        const double z = coord.xyz.z;
+
+        if (data.u == HUGE_VAL) /* error output */
+            fputs(oterr, stdout);
+
+        else if (destIsLongLat && !oform) { /*ascii DMS output */
+
+            // rtodms() expect radians: convert from the output SRS unit
+            data.u *= destToRadians;
+            data.v *= destToRadians;
+
+            if (destIsLatLong) {
+                if (reverseout) {
+                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
+                          stdout);
+                    putchar('\t');
+                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
+                          stdout);
+                } else {
+                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
+                          stdout);
+                    putchar('\t');
+                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
+                          stdout);
+                }
+            } else if (reverseout) {
+                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
+                putchar('\t');
+                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
+            } else {
+                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
+                putchar('\t');
+                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
+            }
+
+        } else { /* x-y or decimal degree ascii output */
+            if (destIsLongLat) {
+                data.v *= destToRadians * RAD_TO_DEG;
+                data.u *= destToRadians * RAD_TO_DEG;
+            }
+            if (reverseout) {
+                print_number(data.v);
+                putchar('\t');
+                print_number(data.u);
+            } else {
+                print_number(data.u);
+                putchar('\t');
+                print_number(data.v);
+            }
+        }
+
+        putchar(' ');
+        if (oform != nullptr)
+            print_number(z);
+        else
+            printf("%.3f", z);
+        fputs(record.line.c_str() + record.rest, stdout);
+    }
+    if (!values.empty()) {
+        write_float64_records(stdout, values.data(), binaryDims,
+                              values.size() / binaryDims);
+    }
+    fflush(stdout);
+    records.clear();
+}
+
 /************************************************************************/
 /*                              process()                               */
 /*                                                                      */
@@ -102,9 +248,41 @@ using namespace NS_PROJ::internal;
 static void process(FILE *fid)
 
 {
-    char line[MAX_LINE + 3], *s, pline[40];
+    char line[MAX_LINE + 3], *s;
     PJ_UV data;
     int nLineNumber = 0;
+    std::vector<InputRecord> records;
+    std::vector<PJ_COORD> coords;
+    /* Text read from stdin may come from a process that waits for the  */
+    /* output of each line before writing the next one                  */
+    const size_t nBatchSize =
+        batchSize > 0 ? batchSize
+                      : (binaryInput || fid != stdin ? DEFAULT_BATCH_SIZE : 1);
+
+    if (binaryInput) {
+        /* values in the units of the source CRS */
+        std::vector<double> values(nBatchSize * binaryDims);
+        size_t n;
+        while ((n = read_float64_records(fid, values.data(), binaryDims,
+                                         nBatchSize)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                const double *v = values.data() + i * binaryDims;
+                InputRecord record;
+                record.line = "\n";
+                record.coord.xyzt.x = reversein ? v[1] : v[0];
+                record.coord.xyzt.y = reversein ? v[0] : v[1];
+                record.coord.xyzt.z = binaryDims > 2 ? v[2] : 0.0;
+                record.coord.xyzt.t = binaryDims > 3 ? v[3] : HUGE_VAL;
+                record.transform = record.coord.xyzt.x != HUGE_VAL &&
+                                   record.coord.xyzt.y != HUGE_VAL;
+                if (!record.transform)
+                    record.coord.xyzt.x = record.coord.xyzt.y = HUGE_VAL;
+                records.emplace_back(std::move(record));
+            }
+            output_records(records, coords);
+        }
+        return;
+    }
 
     while (true) {
         double z;
@@ -128,8 +306,14 @@ static void process(FILE *fid)
             while ((c = fgetc(fid)) != EOF && c != '\n')
                 ;
         }
+
+        InputRecord record;
         if (*s == tag) {
-            fputs(line, stdout);
+            record.verbatim = true;
+            record.line = line;
+            records.emplace_back(std::move(record));
+            if (records.size() >= nBatchSize)
+                output_records(records, coords);
             continue;
         }
 
@@ -162,14 +346,10 @@ static void process(FILE *fid)
         if (!*s && (s > line))
             --s; /* assumed we gobbled \n */
 
-        if (echoin) {
-            char temp;
-            temp = *s;
-            *s = '\0';
-            (void)fputs(pszLineAfterBOM, stdout);
-            *s = temp;
-            putchar('\t');
-        }
+        record.line = pszLineAfterBOM;
+        record.rest = s > pszLineAfterBOM
+                          ? static_cast<size_t>(s - pszLineAfterBOM)
+                          : 0;
 
         if (data.u != HUGE_VAL) {
 
@@ -180,77 +360,18 @@ static void process(FILE *fid)
                 data.v /= srcToRadians;
             }
 
-            PJ_COORD coord;
-            coord.xyzt.x = data.u;
-            coord.xyzt.y = data.v;
-            coord.xyzt.z = z;
-            coord.xyzt.t = t;
-            coord = proj_trans(transformation, PJ_FWD, coord);
-            data.u = coord.xyz.x;
-            data.v = coord.xyz.y;
-            z = coord.xyz.z;
-        }
-
-        if (data.u == HUGE_VAL) /* error output */
-            fputs(oterr, stdout);
-
-        else if (destIsLongLat && !oform) { /*ascii DMS output */
-
-            // rtodms() expect radians: convert from the output SRS unit
-            data.u *= destToRadians;
-            data.v *= destToRadians;
-
-            if (destIsLatLong) {
-                if (reverseout) {
-                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
-                          stdout);
-                    putchar('\t');
-                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
-                          stdout);
-                } else {
-                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
-                          stdout);
-                    putchar('\t');
-                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
-                          stdout);
-                }
-            } else if (reverseout) {
-                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
-                putchar('\t');
-                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
-            } else {
-                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
-                putchar('\t');
-                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
-            }
-
-        } else { /* x-y or decimal degree ascii output */
-            if (destIsLongLat) {
-                data.v *= destToRadians * RAD_TO_DEG;
-                data.u *= destToRadians * RAD_TO_DEG;
-            }
-            if (reverseout) {
-                limited_fprintf_for_number(stdout, oform, data.v);
-                putchar('\t');
-                limited_fprintf_for_number(stdout, oform, data.u);
-            } else {
-                limited_fprintf_for_number(stdout, oform, data.u);
-                putchar('\t');
-                limited_fprintf_for_number(stdout, oform, data.v);
-            }
+            record.transform = true;
         }
-
-        putchar(' ');
-        if (oform != nullptr)
-            limited_fprintf_for_number(stdout, oform, z);
-        else
-            printf("%.3f", z);
-        if (s)
-            printf("%s", s);
-        else
-            printf("\n");
-        fflush(stdout);
+        record.coord.xyzt.x = data.u;
+        record.coord.xyzt.y = data.v;
+        record.coord.xyzt.z = z;
+        record.coord.xyzt.t = t;
+
+        records.emplace_back(std::move(record));
+        if (records.size() >= nBatchSize)
+            output_records(records, coords);
     }
+    output_records(records, coords);
 }
 
 /************************************************************************/
@@ -506,6 +627,34 @@ int main(int argc, char **argv) {
                 std::exit(1);
             }
             targetEpoch = *argv;
+        } else if (strcmp(*argv, "--batch-size") == 0) {
+            ++argv;
+            --argc;
+            if (argc == 0) {
+                emess(1, "missing argument for --batch-size");
+                std::exit(1);
+            }
+            batchSize = atoi(*argv);
+            if (batchSize < 1) {
+                emess(1, "invalid value for --batch-size: %s", *argv);
+                std::exit(1);
+            }
+        } else if (strcmp(*argv, "--binary-input") == 0) {
+            binaryInput = true;
+        } else if (strcmp(*argv, "--binary-output") == 0) {
+            binaryOutput = true;
+        } else if (strcmp(*argv, "--binary-dims") == 0) {
+            ++argv;
+            --argc;
+            if (argc == 0) {
+                emess(1, "missing argument for --binary-dims");
+                std::exit(1);
+            }
+            binaryDims = atoi(*argv);
+            if (binaryDims < 2 || binaryDims > 4) {
+                emess(1, "invalid value for --binary-dims: %s", *argv);
+                std::exit(1);
+            }
         } else if (**argv == '-') {
             for (arg = *argv;;) {
                 switch (*++arg) {
@@ -987,6 +1136,10 @@ int main(int argc, char **argv) {
 
     if (!destIsLongLat && !oform)
         oform = "%.2f";
+    oformIsG15 = oform && strcmp(oform, "%.15g") == 0;
+
+    if (binaryOutput)
+        set_binary_mode(stdout);
 
     /* process input file list */
     for (; eargc--; ++eargv) {
@@ -994,8 +1147,11 @@ int main(int argc, char **argv) {
             fid = stdin;
             emess_dat.File_name = const_cast<char *>("<stdin>");
 
+            if (binaryInput)
+                set_binary_mode(stdin);
+
         } else {
-            if ((fid = fopen(*eargv, "rt")) == nullptr) {
+            if ((fid = fopen(*eargv, binaryInput ? "rb" : "rt")) == nullptr) {
                 emess(-2, "input file: %s", *eargv);
                 continue;
             }
@@ -31,6 +31,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(MSDOS) || defined(OS2) || defined(WIN32) || defined(__WIN32__)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
 bool validate_form_string_for_numbers(const char *formatString) {
     /* Only accepts '%[+]?[number]?[.]?[number]?[e|E|f|F|g|G]' */
     bool valid = true;
@@ -190,3 +195,45 @@ void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
         return;
     }
 }
+
+// Switch a standard stream to binary mode (only matters on Windows).
+void set_binary_mode(FILE *f) {
+#if defined(MSDOS) || defined(OS2) || defined(WIN32) || defined(__WIN32__)
+    _setmode(_fileno(f), O_BINARY);
+#else
+    (void)f;
+#endif
+}
+
+static const int byte_order_test = 1;
+#define IS_LSB (1 == ((const unsigned char *)(&byte_order_test))[0])
+
+static void swap_float64(double *values, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned char *b = reinterpret_cast<unsigned char *>(values + i);
+        for (size_t j = 0; j < sizeof(double) / 2; j++) {
+            const unsigned char tmp = b[j];
+            b[j] = b[sizeof(double) - 1 - j];
+            b[sizeof(double) - 1 - j] = tmp;
+        }
+    }
+}
+
+// Read up to count records of dims little-endian float64 values.
+// Returns the number of complete records read: a truncated record at the
+// end of the file is ignored.
+size_t read_float64_records(FILE *f, double *values, size_t dims,
+                            size_t count) {
+    const size_t n = fread(values, dims * sizeof(double), count, f);
+    if (!IS_LSB)
+        swap_float64(values, n * dims);
+    return n;
+}
+
+// Write count records of dims little-endian float64 values. On big-endian
+// hosts, values is byte-swapped in place.
+bool write_float64_records(FILE *f, double *values, size_t dims, size_t count) {
+    if (!IS_LSB)
+        swap_float64(values, count * dims);
+    return fwrite(values, dims * sizeof(double), count, f) == count;
+}
@@ -26,8 +26,19 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include <stddef.h>
 #include <stdio.h>
 
 bool validate_form_string_for_numbers(const char *formatString);
 
 void limited_fprintf_for_number(FILE *f, const char *formatString, double val);
+
+void set_binary_mode(FILE *f);
+
+/* Batch size of cct and cs2cs when the input is binary or read from files */
+#define DEFAULT_BATCH_SIZE 1000
+
+size_t read_float64_records(FILE *f, double *values, size_t dims,
+                            size_t count);
+
+bool write_float64_records(FILE *f, double *values, size_t dims, size_t count);
@@ -154,6 +154,40 @@ static void pj_axisswap_reverse_4d(PJ_COORD &coo, PJ *P) {
     coo = out;
 }
 
+static bool pj_axisswap_get_affine_coeffs(const PJ *P, PJ_DIRECTION direction,
+                                          PJ_AFFINE_COEFFS &coeffs) {
+    const struct pj_axisswap_data *Q =
+        (const struct pj_axisswap_data *)P->opaque;
+    unsigned int i, j, n = 0;
+
+    for (i = 0; i < 4; i++)
+        if (Q->axis[i] < 4)
+            n++;
+    /* the time axis cannot be mixed with the spatial ones */
+    if (n == 4 && Q->axis[3] != 3)
+        return false;
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++)
+            coeffs.matrix[i][j] = (i == j) ? 1.0 : 0.0;
+        coeffs.offset[i] = 0.0;
+    }
+    coeffs.tscale = (n == 4) ? Q->sign[3] : 1.0;
+    coeffs.toff = 0.0;
+
+    if (n > 3)
+        n = 3;
+    for (i = 0; i < n; i++)
+        coeffs.matrix[i][i] = 0.0;
+    for (i = 0; i < n; i++) {
+        if (direction == PJ_FWD)
+            coeffs.matrix[i][Q->axis[i]] = Q->sign[i];
+        else
+            coeffs.matrix[Q->axis[i]][i] = Q->sign[i];
+    }
+    return true;
+}
+
 /***********************************************************************/
 PJ *PJ_CONVERSION(axisswap, 0) {
     /***********************************************************************/
@@ -165,6 +199,7 @@ PJ *PJ_CONVERSION(axisswap, 0) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = (void *)Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_axisswap_data>;
 
     /* +order and +axis are mutually exclusive */
     if (!pj_param_exists(P->params, "order") ==
@@ -287,6 +322,7 @@ PJ *PJ_CONVERSION(axisswap, 0) {
         proj_log_error(P, _("axisswap: bad axis order"));
         return pj_default_destructor(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
     }
+    P->get_affine_coeffs = pj_axisswap_get_affine_coeffs;
 
     if (pj_param(P->ctx, P->params, "tangularunits").i) {
         P->left = PJ_IO_UNITS_RADIANS;
@@ -41,6 +41,7 @@ PJ *OPERATION(set, 0) {
     P->opaque = set;
     if (nullptr == P->opaque)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
+    P->clone_opaque = pj_clone_plain_opaque<struct Set>;
 
     if (pj_param_exists(P->params, "v_1")) {
         set->v1 = true;
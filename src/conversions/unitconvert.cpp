@@ -391,6 +391,39 @@ static void reverse_4d(PJ_COORD &coo, PJ *P) {
         coo.xyzt.t = time_units[Q->t_in_id].t_out(coo.xyzt.t);
 }
 
+/***********************************************************************/
+static bool get_affine_coeffs(const PJ *P, PJ_DIRECTION direction,
+                              PJ_AFFINE_COEFFS &coeffs) {
+    /************************************************************************
+        Unit conversions of physical dimensions are a scaling, time
+        conversions are not linear in general.
+    ************************************************************************/
+    const struct pj_opaque_unitconvert *Q =
+        (const struct pj_opaque_unitconvert *)P->opaque;
+    int i, j;
+
+    if (Q->t_in_id >= 0 || Q->t_out_id >= 0)
+        return false;
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++)
+            coeffs.matrix[i][j] = 0.0;
+        coeffs.offset[i] = 0.0;
+    }
+    if (direction == PJ_FWD) {
+        coeffs.matrix[0][0] = Q->xy_factor;
+        coeffs.matrix[1][1] = Q->xy_factor;
+        coeffs.matrix[2][2] = Q->z_factor;
+    } else {
+        coeffs.matrix[0][0] = 1.0 / Q->xy_factor;
+        coeffs.matrix[1][1] = 1.0 / Q->xy_factor;
+        coeffs.matrix[2][2] = 1.0 / Q->z_factor;
+    }
+    coeffs.tscale = 1.0;
+    coeffs.toff = 0.0;
+    return true;
+}
+
 /***********************************************************************/
 static double get_unit_conversion_factor(const char *name, int *p_is_linear,
                                          const char **p_normalized_name) {
@@ -451,6 +484,7 @@ PJ *PJ_CONVERSION(unitconvert, 0) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = (void *)Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_opaque_unitconvert>;
 
     P->fwd4d = forward_4d;
     P->inv4d = reverse_4d;
@@ -458,6 +492,7 @@ PJ *PJ_CONVERSION(unitconvert, 0) {
     P->inv3d = reverse_3d;
     P->fwd = forward_2d;
     P->inv = reverse_2d;
+    P->get_affine_coeffs = get_affine_coeffs;
 
     P->left = PJ_IO_UNITS_WHATEVER;
     P->right = PJ_IO_UNITS_WHATEVER;
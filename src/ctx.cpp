@@ -176,7 +176,9 @@ pj_ctx::pj_ctx(const pj_ctx &other)
       defaultTmercAlgo(other.defaultTmercAlgo),
       // END ini file settings
       projStringParserCreateFromPROJStringRecursionCounter(0),
-      pipelineInitRecursiongCounter(0) {
+      pipelineInitRecursiongCounter(0),
+      pipelineCacheSize(other.pipelineCacheSize), pipelineCache(nullptr),
+      threadPool(nullptr) {
     set_search_paths(other.search_paths);
 }
 
@@ -197,6 +199,10 @@ PJ_CONTEXT *pj_get_default_ctx()
 /************************************************************************/
 
 pj_ctx::~pj_ctx() {
+    // Tasks of the thread pool may still use the context
+    pj_thread_pool_destroy(threadPool);
+    // Cached objects may still reference the context
+    pj_pipeline_cache_destroy(pipelineCache);
     delete[] c_compat_paths;
     proj_context_delete_cpp_context(cpp_context);
 }
@@ -294,3 +294,58 @@ bool pj_fwd4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+void pj_fwd4d_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    /* Equivalent of pj_fwd4d() called on each coordinate of coo whose first
+     * component is not HUGE_VAL, storing in errnos the error code of the
+     * coordinates that fail to transform. Operations providing array
+     * variants of their operators get them called on the whole array. */
+    PJ_CONTEXT *ctx = P->ctx;
+    const int last_errno = ctx->last_errno;
+
+    if (P->fwd4d_array && P->skip_fwd_prepare && P->skip_fwd_finalize) {
+        P->fwd4d_array(P, n, coo, errnos);
+        ctx->last_errno = last_errno;
+        return;
+    }
+
+    if (!P->fwd_array) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            ctx->last_errno = 0;
+            if (!pj_fwd4d(coo[i], P))
+                errnos[i] = ctx->last_errno;
+        }
+        ctx->last_errno = last_errno;
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0])
+            continue;
+        ctx->last_errno = 0;
+        if (!P->skip_fwd_prepare)
+            fwd_prepare(P, coo[i]);
+        if (HUGE_VAL == coo[i].v[0])
+            coo[i] = proj_coord_error();
+        errnos[i] = ctx->last_errno;
+    }
+
+    P->fwd_array(P, n, coo, errnos);
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        ctx->last_errno = errnos[i];
+        if (!P->skip_fwd_finalize)
+            fwd_finalize(P, coo[i]);
+        if (ctx->last_errno) {
+            coo[i] = proj_coord_error();
+            errnos[i] = ctx->last_errno;
+        }
+    }
+    ctx->last_errno = last_errno;
+}
@@ -0,0 +1,1458 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Batch functions built on top of the geodesic library
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "geod_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Number of geodesics solved together by geod_direct_array() and
+// geod_inverse_array(). The series are evaluated for all of them in loops
+// over the lanes, which the compiler can vectorize, while the branches and
+// the trigonometric functions are still evaluated lane by lane.
+constexpr int LANES = 8;
+
+// Same constants as geodesic.c
+constexpr int nA1 = 6;
+constexpr int nC1 = 6;
+constexpr int nC1p = 6;
+constexpr int nA2 = 6;
+constexpr int nC2 = 6;
+constexpr int nA3 = 6;
+constexpr int nC3 = 6;
+constexpr int nC = 7;
+constexpr double qd = 90;
+constexpr double hd = 180;
+constexpr double td = 360;
+constexpr double pi = 3.14159265358979323846;
+constexpr double degree = pi / hd;
+constexpr unsigned maxit1 = 20;
+constexpr unsigned maxit2 = maxit1 + DBL_MANT_DIG + 10;
+constexpr double tol0 = DBL_EPSILON;
+constexpr double tol1 = 200 * tol0;
+constexpr double tolb = tol0;
+const double tiny = std::sqrt(DBL_MIN);
+const double tol2 = std::sqrt(tol0);
+const double xthresh = 1000 * tol2;
+
+// ---------------------------------------------------------------------------
+
+double sq(double x) { return x * x; }
+
+// ---------------------------------------------------------------------------
+
+// Same as sumx() of geodesic.c: error-free sum u + v = s + t
+double sumx(double u, double v, double *t) {
+    volatile double s = u + v;
+    volatile double up = s - v;
+    volatile double vpp = s - up;
+    up -= u;
+    vpp -= v;
+    if (t)
+        *t = s != 0 ? 0 - (up + vpp) : s;
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as accadd() of geodesic.c: add y to an accumulator
+void accadd(double s[], double y) {
+    double u, z = sumx(y, s[1], &u);
+    s[0] = sumx(z, s[0], &s[1]);
+    if (s[0] == 0)
+        s[0] = u;
+    else
+        s[1] = s[1] + u;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as norm2() of geodesic.c
+void norm2(double *sinx, double *cosx) {
+    const double r = std::hypot(*sinx, *cosx);
+    *sinx /= r;
+    *cosx /= r;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as AngNormalize() of geodesic.c
+double AngNormalize(double x) {
+    double y = std::remainder(x, td);
+    return std::fabs(y) == hd ? std::copysign(hd, x) : y;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as LatFix() of geodesic.c
+double LatFix(double x) {
+    return std::fabs(x) > qd ? std::numeric_limits<double>::quiet_NaN() : x;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as AngDiff() of geodesic.c, taking the remainders of x and y by 360
+// which only depend on each point.
+double AngDiff(double x, double xr, double y, double yr, double *e) {
+    // remainder(-x, 360) == -remainder(x, 360)
+    double t, d = sumx(-xr, yr, &t);
+    d = sumx(std::remainder(d, td), t, &t);
+    if (d == 0 || std::fabs(d) == hd)
+        d = std::copysign(d, t == 0 ? y - x : -t);
+    if (e)
+        *e = t;
+    return d;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as AngRound() of geodesic.c
+double AngRound(double x) {
+    const double z = 1.0 / 16.0;
+    volatile double y = std::fabs(x);
+    volatile double w = z - y;
+    y = w > 0 ? z - w : y;
+    return std::copysign(y, x);
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as the end of sincosdx() and sincosde() of geodesic.c
+void sincosQuadrant(double x, double r, int q, double *sinx, double *cosx) {
+    const double s = std::sin(r);
+    const double c = std::cos(r);
+    switch (static_cast<unsigned>(q) & 3U) {
+    case 0U:
+        *sinx = s;
+        *cosx = c;
+        break;
+    case 1U:
+        *sinx = c;
+        *cosx = -s;
+        break;
+    case 2U:
+        *sinx = -s;
+        *cosx = -c;
+        break;
+    default:
+        *sinx = -c;
+        *cosx = s;
+        break;
+    }
+    *cosx += 0;
+    if (*sinx == 0)
+        *sinx = std::copysign(*sinx, x);
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as sincosdx() of geodesic.c
+void sincosdx(double x, double *sinx, double *cosx) {
+    int q = 0;
+    const double r = std::remquo(x, qd, &q);
+    sincosQuadrant(x, r * degree, q, sinx, cosx);
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as sincosde() of geodesic.c
+void sincosde(double x, double t, double *sinx, double *cosx) {
+    int q = 0;
+    const double r = AngRound(std::remquo(x, qd, &q) + t);
+    sincosQuadrant(x, r * degree, q, sinx, cosx);
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as atan2dx() of geodesic.c
+double atan2dx(double y, double x) {
+    int q = 0;
+    if (std::fabs(y) > std::fabs(x)) {
+        std::swap(x, y);
+        q = 2;
+    }
+    if (std::signbit(x)) {
+        x = -x;
+        ++q;
+    }
+    double ang = std::atan2(y, x) / degree;
+    switch (q) {
+    case 1:
+        ang = std::copysign(hd, y) - ang;
+        break;
+    case 2:
+        ang = qd - ang;
+        break;
+    case 3:
+        ang = -qd + ang;
+        break;
+    default:
+        break;
+    }
+    return ang;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as AngDiff() of geodesic.c, without the error term
+double AngDiff(double x, double y) {
+    return AngDiff(x, std::remainder(x, td), y, std::remainder(y, td),
+                   nullptr);
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as transit() of geodesic.c: return 1 or -1 if crossing the prime
+// meridian in east or west direction, otherwise 0.
+int transit(double lon1, double lon2) {
+    const double lon12 = AngDiff(lon1, lon2);
+    lon1 = AngNormalize(lon1);
+    lon2 = AngNormalize(lon2);
+    return lon12 > 0 && ((lon1 < 0 && lon2 >= 0) || (lon1 > 0 && lon2 == 0))
+               ? 1
+               : (lon12 < 0 && lon1 >= 0 && lon2 < 0 ? -1 : 0);
+}
+
+// ---------------------------------------------------------------------------
+
+// The following functions are the ones of geodesic.c evaluated for N lanes
+// at once: x[k] is the value of x for the lane k, and c[l][k] is the
+// coefficient l of the series of the lane k. They perform the same floating
+// point operations in the same order, so that the results are identical.
+
+// polyvalx() of geodesic.c
+template <int N>
+void polyvalLanes(int m, const double p[], const double x[], double y[]) {
+    for (int k = 0; k < N; ++k)
+        y[k] = m < 0 ? 0 : p[0];
+    for (int i = 1; i <= m; ++i)
+        for (int k = 0; k < N; ++k)
+            y[k] = y[k] * x[k] + p[i];
+}
+
+// ---------------------------------------------------------------------------
+
+// SinCosSeries(TRUE, ...) of geodesic.c: y = sum(c[i] * sin(2*i * x), i, 1,
+// n), using Clenshaw summation.
+template <int N>
+void sinSeriesLanes(const double sinx[], const double cosx[],
+                    const double c[][N], int n, double y[]) {
+    double ar[N], y0[N], y1[N];
+    int i = n + 1; // One beyond the last element
+    for (int k = 0; k < N; ++k) {
+        ar[k] = 2 * (cosx[k] - sinx[k]) * (cosx[k] + sinx[k]);
+        y0[k] = 0;
+        y1[k] = 0;
+    }
+    if (n & 1) {
+        --i;
+        for (int k = 0; k < N; ++k)
+            y0[k] = c[i][k];
+    }
+    for (int j = n / 2; j > 0; --j) {
+        --i;
+        for (int k = 0; k < N; ++k)
+            y1[k] = ar[k] * y0[k] - y1[k] + c[i][k];
+        --i;
+        for (int k = 0; k < N; ++k)
+            y0[k] = ar[k] * y1[k] - y0[k] + c[i][k];
+    }
+    for (int k = 0; k < N; ++k)
+        y[k] = 2 * sinx[k] * cosx[k] * y0[k];
+}
+
+// ---------------------------------------------------------------------------
+
+// A1m1f() and A2m1f() of geodesic.c, with sign = 1 and -1 respectively.
+template <int N>
+void aLanes(const double coeff[], int m, double sign, const double eps[],
+            double a[]) {
+    double eps2[N];
+    for (int k = 0; k < N; ++k)
+        eps2[k] = sq(eps[k]);
+    polyvalLanes<N>(m, coeff, eps2, a);
+    for (int k = 0; k < N; ++k) {
+        const double t = a[k] / coeff[m + 1];
+        a[k] = (t + sign * eps[k]) / (1 - sign * eps[k]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// C1f(), C1pf() and C2f() of geodesic.c: c[1] to c[n] are set.
+template <int N>
+void cLanes(const double coeff[], int n, const double eps[], double c[][N]) {
+    double eps2[N], d[N];
+    for (int k = 0; k < N; ++k) {
+        eps2[k] = sq(eps[k]);
+        d[k] = eps[k];
+    }
+    int o = 0;
+    for (int l = 1; l <= n; ++l) {
+        const int m = (n - l) / 2;
+        polyvalLanes<N>(m, coeff + o, eps2, c[l]);
+        for (int k = 0; k < N; ++k) {
+            c[l][k] = d[k] * c[l][k] / coeff[o + m + 1];
+            d[k] *= eps[k];
+        }
+        o += m + 2;
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+template <int N> void A1m1Lanes(const double eps[], double a[]) {
+    static const double coeff[] = {
+        // (1-eps)*A1-1, polynomial in eps2 of order 3
+        1, 4, 64, 0, 256,
+    };
+    aLanes<N>(coeff, nA1 / 2, 1, eps, a);
+}
+
+// ---------------------------------------------------------------------------
+
+template <int N> void C1Lanes(const double eps[], double c[][N]) {
+    static const double coeff[] = {
+        // C1[1]/eps^1, polynomial in eps2 of order 2
+        -1, 6, -16, 32,
+        // C1[2]/eps^2, polynomial in eps2 of order 2
+        -9, 64, -128, 2048,
+        // C1[3]/eps^3, polynomial in eps2 of order 1
+        9, -16, 768,
+        // C1[4]/eps^4, polynomial in eps2 of order 1
+        3, -5, 512,
+        // C1[5]/eps^5, polynomial in eps2 of order 0
+        -7, 1280,
+        // C1[6]/eps^6, polynomial in eps2 of order 0
+        -7, 2048,
+    };
+    cLanes<N>(coeff, nC1, eps, c);
+}
+
+// ---------------------------------------------------------------------------
+
+template <int N> void C1pLanes(const double eps[], double c[][N]) {
+    static const double coeff[] = {
+        // C1p[1]/eps^1, polynomial in eps2 of order 2
+        205, -432, 768, 1536,
+        // C1p[2]/eps^2, polynomial in eps2 of order 2
+        4005, -4736, 3840, 12288,
+        // C1p[3]/eps^3, polynomial in eps2 of order 1
+        -225, 116, 384,
+        // C1p[4]/eps^4, polynomial in eps2 of order 1
+        -7173, 2695, 7680,
+        // C1p[5]/eps^5, polynomial in eps2 of order 0
+        3467, 7680,
+        // C1p[6]/eps^6, polynomial in eps2 of order 0
+        38081, 61440,
+    };
+    cLanes<N>(coeff, nC1p, eps, c);
+}
+
+// ---------------------------------------------------------------------------
+
+template <int N> void A2m1Lanes(const double eps[], double a[]) {
+    static const double coeff[] = {
+        // (eps+1)*A2-1, polynomial in eps2 of order 3
+        -11, -28, -192, 0, 256,
+    };
+    aLanes<N>(coeff, nA2 / 2, -1, eps, a);
+}
+
+// ---------------------------------------------------------------------------
+
+template <int N> void C2Lanes(const double eps[], double c[][N]) {
+    static const double coeff[] = {
+        // C2[1]/eps^1, polynomial in eps2 of order 2
+        1, 2, 16, 32,
+        // C2[2]/eps^2, polynomial in eps2 of order 2
+        35, 64, 384, 2048,
+        // C2[3]/eps^3, polynomial in eps2 of order 1
+        15, 80, 768,
+        // C2[4]/eps^4, polynomial in eps2 of order 1
+        7, 35, 512,
+        // C2[5]/eps^5, polynomial in eps2 of order 0
+        63, 1280,
+        // C2[6]/eps^6, polynomial in eps2 of order 0
+        77, 2048,
+    };
+    cLanes<N>(coeff, nC2, eps, c);
+}
+
+// ---------------------------------------------------------------------------
+
+// A3f() of geodesic.c
+template <int N>
+void A3Lanes(const struct geod_geodesic *g, const double eps[], double a[]) {
+    polyvalLanes<N>(nA3 - 1, g->A3x, eps, a);
+}
+
+// ---------------------------------------------------------------------------
+
+// C3f() of geodesic.c: c[1] to c[nC3 - 1] are set.
+template <int N>
+void C3Lanes(const struct geod_geodesic *g, const double eps[],
+             double c[][N]) {
+    double mult[N];
+    for (int k = 0; k < N; ++k)
+        mult[k] = 1;
+    int o = 0;
+    for (int l = 1; l < nC3; ++l) {
+        const int m = nC3 - l - 1;
+        polyvalLanes<N>(m, g->C3x + o, eps, c[l]);
+        for (int k = 0; k < N; ++k) {
+            mult[k] *= eps[k];
+            c[l][k] = mult[k] * c[l][k];
+        }
+        o += m + 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Lengths() of geodesic.c, without the geodesic scales: s12b, m12b and m0
+// may be null.
+template <int N>
+void LengthsLanes(const double eps[], const double sig12[],
+                  const double ssig1[], const double csig1[],
+                  const double dn1[], const double ssig2[],
+                  const double csig2[], const double dn2[], double s12b[],
+                  double m12b[], double m0[]) {
+    double A1[N], A2[N] = {}, m0x[N] = {}, J12[N] = {}, B1[N], B2[N];
+    double y1[N], y2[N];
+    double Ca[nC][N], Cb[nC][N];
+    const bool redlp = m12b || m0;
+    A1m1Lanes<N>(eps, A1);
+    C1Lanes<N>(eps, Ca);
+    if (redlp) {
+        A2m1Lanes<N>(eps, A2);
+        C2Lanes<N>(eps, Cb);
+        for (int k = 0; k < N; ++k) {
+            m0x[k] = A1[k] - A2[k];
+            A2[k] = 1 + A2[k];
+        }
+    }
+    for (int k = 0; k < N; ++k)
+        A1[k] = 1 + A1[k];
+    if (s12b) {
+        sinSeriesLanes<N>(ssig2, csig2, Ca, nC1, y2);
+        sinSeriesLanes<N>(ssig1, csig1, Ca, nC1, y1);
+        for (int k = 0; k < N; ++k) {
+            B1[k] = y2[k] - y1[k];
+            // Missing a factor of b
+            s12b[k] = A1[k] * (sig12[k] + B1[k]);
+        }
+        if (redlp) {
+            sinSeriesLanes<N>(ssig2, csig2, Cb, nC2, y2);
+            sinSeriesLanes<N>(ssig1, csig1, Cb, nC2, y1);
+            for (int k = 0; k < N; ++k) {
+                B2[k] = y2[k] - y1[k];
+                J12[k] = m0x[k] * sig12[k] + (A1[k] * B1[k] - A2[k] * B2[k]);
+            }
+        }
+    } else if (redlp) {
+        // Assume here that nC1 >= nC2
+        for (int l = 1; l <= nC2; ++l)
+            for (int k = 0; k < N; ++k)
+                Cb[l][k] = A1[k] * Ca[l][k] - A2[k] * Cb[l][k];
+        sinSeriesLanes<N>(ssig2, csig2, Cb, nC2, y2);
+        sinSeriesLanes<N>(ssig1, csig1, Cb, nC2, y1);
+        for (int k = 0; k < N; ++k)
+            J12[k] = m0x[k] * sig12[k] + (y2[k] - y1[k]);
+    }
+    if (m0) {
+        for (int k = 0; k < N; ++k)
+            m0[k] = m0x[k];
+    }
+    if (m12b) {
+        // Missing a factor of b
+        for (int k = 0; k < N; ++k)
+            m12b[k] = dn2[k] * (csig1[k] * ssig2[k]) -
+                      dn1[k] * (ssig1[k] * csig2[k]) -
+                      csig1[k] * csig2[k] * J12[k];
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as Astroid() of geodesic.c: solve k^4+2*k^3-(x^2+y^2-1)*k^2-2*y^2*k-y^2
+// = 0 for the positive root k.
+double Astroid(double x, double y) {
+    double k;
+    const double p = sq(x);
+    const double q = sq(y);
+    const double r = (p + q - 1) / 6;
+    if (!(q == 0 && r <= 0)) {
+        const double S = p * q / 4;
+        const double r2 = sq(r);
+        const double r3 = r * r2;
+        const double disc = S * (S + 2 * r3);
+        double u = r;
+        if (disc >= 0) {
+            double T3 = S + r3;
+            T3 += T3 < 0 ? -std::sqrt(disc) : std::sqrt(disc);
+            const double T = std::cbrt(T3);
+            u += T + (T != 0 ? r2 / T : 0);
+        } else {
+            const double ang = std::atan2(std::sqrt(-disc), -(S + r3));
+            u += 2 * r * std::cos(ang / 3);
+        }
+        const double v = std::sqrt(sq(u) + q);
+        const double uv = u < 0 ? q / (v - u) : u + v;
+        const double w = (uv - q) / (2 * v);
+        k = uv / (std::sqrt(uv + sq(w)) + w);
+    } else {
+        k = 0;
+    }
+    return k;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as InverseStart() of geodesic.c: return a starting point for Newton's
+// method in salp1 and calp1 (function value is -1). If Newton's method
+// doesn't need to be used, return also salp2 and calp2 and function value is
+// sig12.
+double InverseStart(const struct geod_geodesic *g, double sbet1, double cbet1,
+                    double dn1, double sbet2, double cbet2, double dn2,
+                    double lam12, double slam12, double clam12,
+                    double *psalp1, double *pcalp1, double *psalp2,
+                    double *pcalp2, double *pdnm) {
+    double salp1 = 0, calp1 = 0, salp2 = 0, calp2 = 0, dnm = 0;
+    double sig12 = -1;
+    const double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+    const double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+    const bool shortline = cbet12 >= 0 && sbet12 < 0.5 && cbet2 * lam12 < 0.5;
+    double somg12, comg12;
+    const double sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+    if (shortline) {
+        double sbetm2 = sq(sbet1 + sbet2);
+        sbetm2 /= sbetm2 + sq(cbet1 + cbet2);
+        dnm = std::sqrt(1 + g->ep2 * sbetm2);
+        const double omg12 = lam12 / (g->f1 * dnm);
+        somg12 = std::sin(omg12);
+        comg12 = std::cos(omg12);
+    } else {
+        somg12 = slam12;
+        comg12 = clam12;
+    }
+
+    salp1 = cbet2 * somg12;
+    calp1 = comg12 >= 0
+                ? sbet12 + cbet2 * sbet1 * sq(somg12) / (1 + comg12)
+                : sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+
+    const double ssig12 = std::hypot(salp1, calp1);
+    const double csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+    if (shortline && ssig12 < g->etol2) {
+        // really short lines
+        salp2 = cbet1 * somg12;
+        calp2 = sbet12 - cbet1 * sbet2 *
+                             (comg12 >= 0 ? sq(somg12) / (1 + comg12)
+                                          : 1 - comg12);
+        norm2(&salp2, &calp2);
+        sig12 = std::atan2(ssig12, csig12);
+    } else if (std::fabs(g->n) > 0.1 || csig12 >= 0 ||
+               ssig12 >= 6 * std::fabs(g->n) * pi * sq(cbet1)) {
+        // Nothing to do, zeroth order spherical approximation is OK
+    } else {
+        // Scale lam12 and bet2 to x, y coordinate system where antipodal
+        // point is at origin and singular point is at y = 0, x = -1.
+        double x, y, lamscale, betscale;
+        const double lam12x = std::atan2(-slam12, -clam12); // lam12 - pi
+        if (g->f >= 0) {
+            // x = dlong, y = dlat
+            {
+                const double k2 = sq(sbet1) * g->ep2;
+                const double eps = k2 / (2 * (1 + std::sqrt(1 + k2)) + k2);
+                double A3;
+                A3Lanes<1>(g, &eps, &A3);
+                lamscale = g->f * cbet1 * A3 * pi;
+            }
+            betscale = lamscale * cbet1;
+
+            x = lam12x / lamscale;
+            y = sbet12a / betscale;
+        } else {
+            // x = dlat, y = dlong
+            const double cbet12a = cbet2 * cbet1 - sbet2 * sbet1;
+            const double bet12a = std::atan2(sbet12a, cbet12a);
+            const double eps = g->n;
+            const double sig12a = pi + bet12a;
+            const double csig1 = -cbet1;
+            double m12b, m0;
+            LengthsLanes<1>(&eps, &sig12a, &sbet1, &csig1, &dn1, &sbet2,
+                            &cbet2, &dn2, nullptr, &m12b, &m0);
+            x = -1 + m12b / (cbet1 * cbet2 * m0 * pi);
+            betscale = x < -0.01 ? sbet12a / x : -g->f * sq(cbet1) * pi;
+            lamscale = betscale / cbet1;
+            y = lam12x / lamscale;
+        }
+
+        if (y > -tol1 && x > -1 - xthresh) {
+            // strip near cut
+            if (g->f >= 0) {
+                salp1 = std::fmin(1.0, -x);
+                calp1 = -std::sqrt(1 - sq(salp1));
+            } else {
+                calp1 = std::fmax(x > -tol1 ? 0.0 : -1.0, x);
+                salp1 = std::sqrt(1 - sq(calp1));
+            }
+        } else {
+            // Estimate omg12 by solving the astroid problem, and use the
+            // spherical formula to compute alp1.
+            const double k = Astroid(x, y);
+            const double omg12a =
+                lamscale *
+                (g->f >= 0 ? -x * k / (1 + k) : -y * (1 + k) / k);
+            somg12 = std::sin(omg12a);
+            comg12 = -std::cos(omg12a);
+            salp1 = cbet2 * somg12;
+            calp1 = sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+        }
+    }
+    // Sanity check on starting guess. Backwards check allows NaN through.
+    if (!(salp1 <= 0))
+        norm2(&salp1, &calp1);
+    else {
+        salp1 = 1;
+        calp1 = 0;
+    }
+
+    *psalp1 = salp1;
+    *pcalp1 = calp1;
+    if (shortline)
+        *pdnm = dnm;
+    if (sig12 >= 0) {
+        *psalp2 = salp2;
+        *pcalp2 = calp2;
+    }
+    return sig12;
+}
+
+// ---------------------------------------------------------------------------
+
+// The terms of the inverse problem which only depend on one of the points.
+struct GeodPoint {
+    double lat = 0;  // AngRound(LatFix(lat))
+    double lon = 0;  // As given
+    double lonr = 0; // remainder(lon, 360)
+    double sbet = 0; // Reduced latitude
+    double cbet = 1;
+    double dn = 1;
+};
+
+// ---------------------------------------------------------------------------
+
+GeodPoint prepareGeodPoint(const struct geod_geodesic *g, double lat,
+                           double lon) {
+    GeodPoint pt;
+    // If really close to the equator, treat as on equator.
+    pt.lat = AngRound(LatFix(lat));
+    pt.lon = lon;
+    pt.lonr = std::remainder(lon, td);
+    sincosdx(pt.lat, &pt.sbet, &pt.cbet);
+    pt.sbet *= g->f1;
+    // Ensure cbet = +epsilon at poles
+    norm2(&pt.sbet, &pt.cbet);
+    pt.cbet = std::fmax(tiny, pt.cbet);
+    pt.dn = std::sqrt(1 + g->ep2 * sq(pt.sbet));
+    return pt;
+}
+
+// ---------------------------------------------------------------------------
+
+// The quantities of geod_geninverse_int() of geodesic.c for the lanes of a
+// batch of inverse problems.
+struct InverseLanes {
+    double sbet1[LANES], cbet1[LANES], dn1[LANES];
+    double sbet2[LANES], cbet2[LANES], dn2[LANES];
+    double lam12[LANES], slam12[LANES], clam12[LANES];
+    double salp1[LANES], calp1[LANES], salp2[LANES], calp2[LANES];
+    double sig12[LANES], ssig1[LANES], csig1[LANES];
+    double ssig2[LANES], csig2[LANES], eps[LANES];
+    double s12x[LANES];
+};
+
+// ---------------------------------------------------------------------------
+
+// Lambda12() of geodesic.c for the active lanes of st, with salp1 and calp1
+// taken from st and the other results written to out. The series are
+// evaluated for all the lanes, on the values left in out for the inactive
+// ones. dlam12 is only set if diffp.
+void Lambda12Lanes(const struct geod_geodesic *g, const InverseLanes &st,
+                   const bool active[], bool diffp, InverseLanes &out,
+                   double lam12[], double dlam12[]) {
+    double salp0[LANES], somg1[LANES], comg1[LANES], somg2[LANES];
+    double comg2[LANES], eta[LANES], y1[LANES], y2[LANES], A3[LANES];
+    double Ca[nC][LANES];
+    for (int k = 0; k < LANES; ++k) {
+        salp0[k] = 0;
+        eta[k] = 0;
+        if (!active[k])
+            continue;
+        const double sbet1 = st.sbet1[k];
+        const double cbet1 = st.cbet1[k];
+        const double sbet2 = st.sbet2[k];
+        const double cbet2 = st.cbet2[k];
+        const double salp1 = st.salp1[k];
+        // Break degeneracy of equatorial line. This case has already been
+        // handled.
+        const double calp1 =
+            sbet1 == 0 && st.calp1[k] == 0 ? -tiny : st.calp1[k];
+
+        // sin(alp1) * cos(bet1) = sin(alp0)
+        salp0[k] = salp1 * cbet1;
+        const double calp0 = std::hypot(calp1, salp1 * sbet1);
+
+        // tan(bet1) = tan(sig1) * cos(alp1)
+        // tan(omg1) = sin(alp0) * tan(sig1) = tan(omg1)=tan(alp1)*sin(bet1)
+        double ssig1 = sbet1;
+        somg1[k] = salp0[k] * sbet1;
+        double csig1 = comg1[k] = calp1 * cbet1;
+        norm2(&ssig1, &csig1);
+
+        // Enforce symmetries in the case abs(bet2) = -bet1.
+        out.salp2[k] = cbet2 != cbet1 ? salp0[k] / cbet2 : salp1;
+        const double calp2 =
+            cbet2 != cbet1 || std::fabs(sbet2) != -sbet1
+                ? std::sqrt(sq(calp1 * cbet1) +
+                            (cbet1 < -sbet1
+                                 ? (cbet2 - cbet1) * (cbet1 + cbet2)
+                                 : (sbet1 - sbet2) * (sbet1 + sbet2))) /
+                      cbet2
+                : std::fabs(calp1);
+        out.calp2[k] = calp2;
+        // tan(bet2) = tan(sig2) * cos(alp2)
+        // tan(omg2) = sin(alp0) * tan(sig2).
+        double ssig2 = sbet2;
+        somg2[k] = salp0[k] * sbet2;
+        double csig2 = comg2[k] = calp2 * cbet2;
+        norm2(&ssig2, &csig2);
+
+        // sig12 = sig2 - sig1, limit to [0, pi]
+        out.sig12[k] =
+            std::atan2(std::fmax(0.0, csig1 * ssig2 - ssig1 * csig2) + 0,
+                       csig1 * csig2 + ssig1 * ssig2);
+
+        // omg12 = omg2 - omg1, limit to [0, pi]
+        const double somg12 =
+            std::fmax(0.0, comg1[k] * somg2[k] - somg1[k] * comg2[k]) + 0;
+        const double comg12 = comg1[k] * comg2[k] + somg1[k] * somg2[k];
+        // eta = omg12 - lam120
+        eta[k] = std::atan2(somg12 * st.clam12[k] - comg12 * st.slam12[k],
+                            comg12 * st.clam12[k] + somg12 * st.slam12[k]);
+        const double k2 = sq(calp0) * g->ep2;
+        out.eps[k] = k2 / (2 * (1 + std::sqrt(1 + k2)) + k2);
+        out.ssig1[k] = ssig1;
+        out.csig1[k] = csig1;
+        out.ssig2[k] = ssig2;
+        out.csig2[k] = csig2;
+    }
+    C3Lanes<LANES>(g, out.eps, Ca);
+    sinSeriesLanes<LANES>(out.ssig2, out.csig2, Ca, nC3 - 1, y2);
+    sinSeriesLanes<LANES>(out.ssig1, out.csig1, Ca, nC3 - 1, y1);
+    A3Lanes<LANES>(g, out.eps, A3);
+    for (int k = 0; k < LANES; ++k) {
+        const double B312 = y2[k] - y1[k];
+        const double domg12 =
+            -g->f * A3[k] * salp0[k] * (out.sig12[k] + B312);
+        lam12[k] = eta[k] + domg12;
+    }
+
+    if (diffp) {
+        LengthsLanes<LANES>(out.eps, out.sig12, out.ssig1, out.csig1, st.dn1,
+                            out.ssig2, out.csig2, st.dn2, nullptr, dlam12,
+                            nullptr);
+        for (int k = 0; k < LANES; ++k) {
+            if (out.calp2[k] == 0)
+                dlam12[k] = -2 * g->f1 * st.dn1[k] / st.sbet1[k];
+            else
+                dlam12[k] *= g->f1 / (out.calp2[k] * st.cbet2[k]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Solve the inverse problems between the points p1[k] and p2[k], for k < n
+// <= LANES, as geod_inverse() does. The sines and cosines of the azimuths
+// are returned in salp1, calp1, salp2, calp2, which may be null.
+void inverseLanes(const struct geod_geodesic *g, int n,
+                  const GeodPoint *const p1[], const GeodPoint *const p2[],
+                  double s12[], double salp1[], double calp1[],
+                  double salp2[], double calp2[]) {
+    InverseLanes st;
+    double lon12s[LANES];
+    int swapp[LANES], latsign[LANES], lonsign[LANES];
+    bool meridian[LANES], newton[LANES];
+    bool anyMeridian = false;
+    bool anyNewton = false;
+    for (int k = 0; k < LANES; ++k) {
+        // The lanes past n repeat the first one, so that the loops over the
+        // lanes do not need to mask them.
+        const GeodPoint *pt1 = p1[k < n ? k : 0];
+        const GeodPoint *pt2 = p2[k < n ? k : 0];
+
+        // Compute longitude difference (AngDiff does this carefully).
+        double lon12 =
+            AngDiff(pt1->lon, pt1->lonr, pt2->lon, pt2->lonr, &lon12s[k]);
+        // Make longitude difference positive.
+        lonsign[k] = std::signbit(lon12) ? -1 : 1;
+        lon12 *= lonsign[k];
+        lon12s[k] *= lonsign[k];
+        st.lam12[k] = lon12 * degree;
+        // Calculate sincos of lon12 + error (this applies AngRound
+        // internally).
+        sincosde(lon12, lon12s[k], &st.slam12[k], &st.clam12[k]);
+        // the supplementary longitude difference
+        lon12s[k] = (hd - lon12) - lon12s[k];
+
+        // Swap points so that point with higher (abs) latitude is point 1.
+        // If one latitude is a nan, then it becomes lat1.
+        swapp[k] = std::fabs(pt1->lat) < std::fabs(pt2->lat) ||
+                           pt2->lat != pt2->lat
+                       ? -1
+                       : 1;
+        if (swapp[k] < 0) {
+            lonsign[k] *= -1;
+            std::swap(pt1, pt2);
+        }
+        // Make lat1 <= -0. sincosdx() is odd, so that the sines of the
+        // reduced latitudes only need the same change of sign.
+        latsign[k] = std::signbit(pt1->lat) ? 1 : -1;
+        const double lat1 = pt1->lat * latsign[k];
+        const double sbet1 = pt1->sbet * latsign[k];
+        const double cbet1 = pt1->cbet;
+        double sbet2 = pt2->sbet * latsign[k];
+        double cbet2 = pt2->cbet;
+        double dn2 = pt2->dn;
+
+        // If cbet1 < -sbet1, then cbet2 - cbet1 is a sensitive measure of
+        // the |bet1| - |bet2|. Alternatively (cbet1 >= -sbet1), abs(sbet2) +
+        // sbet1 is a better measure. Sometimes these quantities vanish and
+        // in that case we force bet2 = +/- bet1 exactly.
+        if (cbet1 < -sbet1) {
+            if (cbet2 == cbet1) {
+                sbet2 = std::copysign(sbet1, sbet2);
+                dn2 = pt1->dn;
+            }
+        } else {
+            if (std::fabs(sbet2) == -sbet1)
+                cbet2 = cbet1;
+        }
+        st.sbet1[k] = sbet1;
+        st.cbet1[k] = cbet1;
+        st.dn1[k] = pt1->dn;
+        st.sbet2[k] = sbet2;
+        st.cbet2[k] = cbet2;
+        st.dn2[k] = dn2;
+
+        meridian[k] = lat1 == -qd || st.slam12[k] == 0;
+        anyMeridian = anyMeridian || meridian[k];
+        newton[k] = false;
+        st.s12x[k] = 0;
+        st.sig12[k] = 0;
+        st.salp1[k] = 1;
+        st.calp1[k] = 0;
+        st.salp2[k] = 1;
+        st.calp2[k] = 0;
+        if (meridian[k]) {
+            // Endpoints are on a single full meridian, so the geodesic might
+            // lie on a meridian. Head to the target longitude, and at the
+            // target we're heading north.
+            st.calp1[k] = st.clam12[k];
+            st.salp1[k] = st.slam12[k];
+            st.calp2[k] = 1;
+            st.salp2[k] = 0;
+        }
+        // tan(bet) = tan(sig) * cos(alp)
+        st.ssig1[k] = sbet1;
+        st.csig1[k] = st.calp1[k] * cbet1;
+        st.ssig2[k] = sbet2;
+        st.csig2[k] = st.calp2[k] * cbet2;
+        if (meridian[k]) {
+            // sig12 = sig2 - sig1
+            st.sig12[k] = std::atan2(
+                std::fmax(0.0, st.csig1[k] * st.ssig2[k] -
+                                   st.ssig1[k] * st.csig2[k]) +
+                    0,
+                st.csig1[k] * st.csig2[k] + st.ssig1[k] * st.ssig2[k]);
+        }
+        st.eps[k] = g->n;
+    }
+
+    if (anyMeridian) {
+        double m12x[LANES];
+        LengthsLanes<LANES>(st.eps, st.sig12, st.ssig1, st.csig1, st.dn1,
+                            st.ssig2, st.csig2, st.dn2, st.s12x, m12x,
+                            nullptr);
+        for (int k = 0; k < n; ++k) {
+            if (!meridian[k])
+                continue;
+            // Add the check for sig12 since zero length geodesics might
+            // yield m12 < 0. In fact, we will have sig12 > pi/2 for
+            // meridional geodesic which is not a shortest path.
+            if (st.sig12[k] < 1 || m12x[k] >= 0) {
+                // Need at least 2, to handle 90 0 90 180
+                if (st.sig12[k] < 3 * tiny ||
+                    // Prevent negative s12 or m12 for short lines
+                    (st.sig12[k] < tol0 && (st.s12x[k] < 0 || m12x[k] < 0)))
+                    st.sig12[k] = m12x[k] = st.s12x[k] = 0;
+                st.s12x[k] *= g->b;
+            } else {
+                // m12 < 0, i.e., prolate and too close to anti-podal
+                meridian[k] = false;
+            }
+        }
+    }
+
+    for (int k = 0; k < n; ++k) {
+        if (meridian[k])
+            continue;
+        if (st.sbet1[k] == 0 && // and sbet2 == 0
+            // Mimic the way Lambda12 works with calp1 = 0
+            (g->f <= 0 || lon12s[k] >= g->f * hd)) {
+            // Geodesic runs along equator
+            st.calp1[k] = st.calp2[k] = 0;
+            st.salp1[k] = st.salp2[k] = 1;
+            st.s12x[k] = g->a * st.lam12[k];
+        } else {
+            // Figure a starting point for Newton's method
+            double dnm = 0;
+            st.sig12[k] = InverseStart(
+                g, st.sbet1[k], st.cbet1[k], st.dn1[k], st.sbet2[k],
+                st.cbet2[k], st.dn2[k], st.lam12[k], st.slam12[k],
+                st.clam12[k], &st.salp1[k], &st.calp1[k], &st.salp2[k],
+                &st.calp2[k], &dnm);
+            if (st.sig12[k] >= 0) {
+                // Short lines (InverseStart sets salp2, calp2, dnm)
+                st.s12x[k] = st.sig12[k] * g->b * dnm;
+            } else {
+                newton[k] = true;
+                anyNewton = true;
+            }
+        }
+    }
+
+    if (anyNewton) {
+        // Newton's method, as in geod_geninverse_int(), iterated for all the
+        // lanes at once until each of them has converged.
+        double salp1a[LANES], calp1a[LANES], salp1b[LANES], calp1b[LANES];
+        bool tripn[LANES], tripb[LANES], active[LANES];
+        for (int k = 0; k < LANES; ++k) {
+            // Bracketing range
+            salp1a[k] = tiny;
+            calp1a[k] = 1;
+            salp1b[k] = tiny;
+            calp1b[k] = -1;
+            tripn[k] = false;
+            tripb[k] = false;
+            active[k] = newton[k];
+        }
+        InverseLanes trial = st;
+        double v[LANES], dv[LANES];
+        bool anyActive = true;
+        for (unsigned numit = 0; anyActive; ++numit) {
+            const bool diffp = numit < maxit1;
+            Lambda12Lanes(g, st, active, diffp, trial, v, dv);
+            anyActive = false;
+            for (int k = 0; k < LANES; ++k) {
+                if (!active[k])
+                    continue;
+                st.salp2[k] = trial.salp2[k];
+                st.calp2[k] = trial.calp2[k];
+                st.sig12[k] = trial.sig12[k];
+                st.ssig1[k] = trial.ssig1[k];
+                st.csig1[k] = trial.csig1[k];
+                st.ssig2[k] = trial.ssig2[k];
+                st.csig2[k] = trial.csig2[k];
+                st.eps[k] = trial.eps[k];
+                const double dvk = diffp ? dv[k] : 0;
+                if (tripb[k] ||
+                    // Reversed test to allow escape with NaNs
+                    !(std::fabs(v[k]) >= (tripn[k] ? 8 : 1) * tol0) ||
+                    // Enough bisections to get accurate result
+                    numit == maxit2) {
+                    active[k] = false;
+                    continue;
+                }
+                anyActive = true;
+                double &salp1k = st.salp1[k];
+                double &calp1k = st.calp1[k];
+                // Update bracketing values
+                if (v[k] > 0 && (numit > maxit1 ||
+                                 calp1k / salp1k > calp1b[k] / salp1b[k])) {
+                    salp1b[k] = salp1k;
+                    calp1b[k] = calp1k;
+                } else if (v[k] < 0 &&
+                           (numit > maxit1 ||
+                            calp1k / salp1k < calp1a[k] / salp1a[k])) {
+                    salp1a[k] = salp1k;
+                    calp1a[k] = calp1k;
+                }
+                if (numit < maxit1 && dvk > 0) {
+                    const double dalp1 = -v[k] / dvk;
+                    if (std::fabs(dalp1) < pi) {
+                        const double sdalp1 = std::sin(dalp1);
+                        const double cdalp1 = std::cos(dalp1);
+                        const double nsalp1 = salp1k * cdalp1 + calp1k * sdalp1;
+                        if (nsalp1 > 0) {
+                            calp1k = calp1k * cdalp1 - salp1k * sdalp1;
+                            salp1k = nsalp1;
+                            norm2(&salp1k, &calp1k);
+                            // In some regimes we don't get quadratic
+                            // convergence because slope -> 0. So use
+                            // convergence conditions based on epsilon
+                            // instead of sqrt(epsilon).
+                            tripn[k] = std::fabs(v[k]) <= 16 * tol0;
+                            continue;
+                        }
+                    }
+                }
+                // Either dv was not positive or updated value was outside
+                // legal range. Use the midpoint of the bracket as the next
+                // estimate.
+                salp1k = (salp1a[k] + salp1b[k]) / 2;
+                calp1k = (calp1a[k] + calp1b[k]) / 2;
+                norm2(&salp1k, &calp1k);
+                tripn[k] = false;
+                tripb[k] = (std::fabs(salp1a[k] - salp1k) +
+                                    (calp1a[k] - calp1k) <
+                                tolb ||
+                            std::fabs(salp1k - salp1b[k]) +
+                                    (calp1k - calp1b[k]) <
+                                tolb);
+            }
+        }
+        double s12b[LANES];
+        LengthsLanes<LANES>(st.eps, st.sig12, st.ssig1, st.csig1, st.dn1,
+                            st.ssig2, st.csig2, st.dn2, s12b, nullptr,
+                            nullptr);
+        for (int k = 0; k < n; ++k) {
+            if (newton[k])
+                st.s12x[k] = s12b[k] * g->b;
+        }
+    }
+
+    for (int k = 0; k < n; ++k) {
+        if (s12)
+            s12[k] = 0 + st.s12x[k]; // Convert -0 to 0
+        // Convert calp, salp to azimuth accounting for lonsign, swapp,
+        // latsign.
+        double salp1k = st.salp1[k];
+        double calp1k = st.calp1[k];
+        double salp2k = st.salp2[k];
+        double calp2k = st.calp2[k];
+        if (swapp[k] < 0) {
+            std::swap(salp1k, salp2k);
+            std::swap(calp1k, calp2k);
+        }
+        salp1k *= swapp[k] * lonsign[k];
+        calp1k *= swapp[k] * latsign[k];
+        salp2k *= swapp[k] * lonsign[k];
+        calp2k *= swapp[k] * latsign[k];
+        if (salp1)
+            salp1[k] = salp1k;
+        if (calp1)
+            calp1[k] = calp1k;
+        if (salp2)
+            salp2[k] = salp2k;
+        if (calp2)
+            calp2[k] = calp2k;
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Solve the direct problems for the lanes k < n <= LANES of the arrays, as
+// geod_direct() does. The input arrays have LANES elements, and the
+// longitudes are only computed if lon2 is not null.
+void directLanes(const struct geod_geodesic *g, int n, const double lat1[],
+                 const double lon1[], const double azi1[],
+                 const double s12[], double lat2[], double lon2[],
+                 double azi2[]) {
+    double salp0[LANES], calp0[LANES], ssig1[LANES], csig1[LANES];
+    double somg1[LANES], comg1[LANES], k2[LANES], eps[LANES];
+    double A1m1[LANES], B11[LANES], stau1[LANES], ctau1[LANES];
+    double A3c[LANES], B31[LANES], A3[LANES];
+    double sig12[LANES], ssig12[LANES], csig12[LANES];
+    double ssig2[LANES], csig2[LANES], B12[LANES], x[LANES], y[LANES];
+    double C1a[nC][LANES], C1pa[nC][LANES], C3a[nC][LANES];
+
+    // geod_lineinit()
+    for (int k = 0; k < LANES; ++k) {
+        double salp1, calp1;
+        // Guard against underflow in salp0
+        sincosdx(AngRound(AngNormalize(azi1[k])), &salp1, &calp1);
+        double sbet1, cbet1;
+        sincosdx(AngRound(LatFix(lat1[k])), &sbet1, &cbet1);
+        sbet1 *= g->f1;
+        // Ensure cbet1 = +epsilon at poles
+        norm2(&sbet1, &cbet1);
+        cbet1 = std::fmax(tiny, cbet1);
+
+        // Evaluate alp0 from sin(alp1) * cos(bet1) = sin(alp0),
+        salp0[k] = salp1 * cbet1; // alp0 in [0, pi/2 - |bet1|]
+        calp0[k] = std::hypot(calp1, salp1 * sbet1);
+        // Evaluate sig with tan(bet1) = tan(sig1) * cos(alp1), and omg1 with
+        // tan(omg1) = sin(alp0) * tan(sig1).
+        ssig1[k] = sbet1;
+        somg1[k] = salp0[k] * sbet1;
+        csig1[k] = comg1[k] = sbet1 != 0 || calp1 != 0 ? cbet1 * calp1 : 1;
+        norm2(&ssig1[k], &csig1[k]); // sig1 in (-pi, pi]
+
+        k2[k] = sq(calp0[k]) * g->ep2;
+        eps[k] = k2[k] / (2 * (1 + std::sqrt(1 + k2[k])) + k2[k]);
+    }
+    A1m1Lanes<LANES>(eps, A1m1);
+    C1Lanes<LANES>(eps, C1a);
+    sinSeriesLanes<LANES>(ssig1, csig1, C1a, nC1, B11);
+    for (int k = 0; k < LANES; ++k) {
+        const double s = std::sin(B11[k]);
+        const double c = std::cos(B11[k]);
+        // tau1 = sig1 + B11
+        stau1[k] = ssig1[k] * c + csig1[k] * s;
+        ctau1[k] = csig1[k] * c - ssig1[k] * s;
+    }
+    C1pLanes<LANES>(eps, C1pa);
+    if (lon2) {
+        C3Lanes<LANES>(g, eps, C3a);
+        A3Lanes<LANES>(g, eps, A3);
+        for (int k = 0; k < LANES; ++k)
+            A3c[k] = -g->f * salp0[k] * A3[k];
+        sinSeriesLanes<LANES>(ssig1, csig1, C3a, nC3 - 1, B31);
+    }
+
+    // geod_genposition(), with s12 as a distance
+    for (int k = 0; k < LANES; ++k) {
+        sig12[k] = s12[k] / (g->b * (1 + A1m1[k])); // tau12
+        const double s = std::sin(sig12[k]);
+        const double c = std::cos(sig12[k]);
+        // tau2 = tau1 + tau12
+        x[k] = stau1[k] * c + ctau1[k] * s;
+        y[k] = ctau1[k] * c - stau1[k] * s;
+    }
+    sinSeriesLanes<LANES>(x, y, C1pa, nC1p, B12);
+    for (int k = 0; k < LANES; ++k) {
+        B12[k] = -B12[k];
+        sig12[k] = sig12[k] - (B12[k] - B11[k]);
+        ssig12[k] = std::sin(sig12[k]);
+        csig12[k] = std::cos(sig12[k]);
+    }
+    if (std::fabs(g->f) > 0.01) {
+        // Reverted distance series is inaccurate for |f| > 1/100, so
+        // correct sig12 with 1 Newton iteration.
+        for (int k = 0; k < LANES; ++k) {
+            ssig2[k] = ssig1[k] * csig12[k] + csig1[k] * ssig12[k];
+            csig2[k] = csig1[k] * csig12[k] - ssig1[k] * ssig12[k];
+        }
+        sinSeriesLanes<LANES>(ssig2, csig2, C1a, nC1, B12);
+        for (int k = 0; k < LANES; ++k) {
+            const double serr =
+                (1 + A1m1[k]) * (sig12[k] + (B12[k] - B11[k])) -
+                s12[k] / g->b;
+            sig12[k] = sig12[k] - serr / std::sqrt(1 + k2[k] * sq(ssig2[k]));
+            ssig12[k] = std::sin(sig12[k]);
+            csig12[k] = std::cos(sig12[k]);
+        }
+    }
+
+    for (int k = 0; k < LANES; ++k) {
+        // sig2 = sig1 + sig12
+        ssig2[k] = ssig1[k] * csig12[k] + csig1[k] * ssig12[k];
+        csig2[k] = csig1[k] * csig12[k] - ssig1[k] * ssig12[k];
+        // sin(bet2) = cos(alp0) * sin(sig2)
+        const double sbet2 = calp0[k] * ssig2[k];
+        double cbet2 = std::hypot(salp0[k], calp0[k] * csig2[k]);
+        if (cbet2 == 0)
+            // I.e., salp0 = 0, csig2 = 0. Break the degeneracy in this case
+            cbet2 = csig2[k] = tiny;
+        if (k < n) {
+            if (lat2)
+                lat2[k] = atan2dx(sbet2, g->f1 * cbet2);
+            // tan(alp0) = cos(sig2)*tan(alp2)
+            if (azi2)
+                azi2[k] = atan2dx(salp0[k], calp0[k] * csig2[k]);
+        }
+    }
+
+    if (lon2) {
+        sinSeriesLanes<LANES>(ssig2, csig2, C3a, nC3 - 1, y);
+        for (int k = 0; k < n; ++k) {
+            // tan(omg2) = sin(alp0) * tan(sig2)
+            const double somg2 = salp0[k] * ssig2[k];
+            const double comg2 = csig2[k];
+            // omg12 = omg2 - omg1
+            const double omg12 =
+                std::atan2(somg2 * comg1[k] - comg2 * somg1[k],
+                           comg2 * comg1[k] + somg2 * somg1[k]);
+            const double lam12 =
+                omg12 + A3c[k] * (sig12[k] + (y[k] - B31[k]));
+            const double lon12 = lam12 / degree;
+            lon2[k] = AngNormalize(AngNormalize(lon1[k]) + AngNormalize(lon12));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Run worker() on the calling thread and on up to nthreads - 1 other threads,
+// nthreads <= 1 meaning the calling thread only. The workers share the work
+// among themselves, so that nothing is lost if some threads cannot be
+// started.
+template <class Worker>
+void runWorkers(int nthreads, size_t maxWorkers, const Worker &worker) {
+    std::vector<std::thread> threads;
+    const size_t nWorkers =
+        nthreads > 1 ? std::min(static_cast<size_t>(nthreads), maxWorkers)
+                     : 1;
+    try {
+        for (size_t i = 1; i < nWorkers; ++i)
+            threads.emplace_back(worker);
+    } catch (const std::exception &) {
+        // Go on with the threads that could be started
+    }
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+void geod_direct_array(const struct geod_geodesic *g, int n,
+                       const double lat1[], const double lon1[],
+                       const double azi1[], const double s12[], double lat2[],
+                       double lon2[], double azi2[]) {
+    for (int i = 0; i < n; i += LANES) {
+        const int m = std::min(LANES, n - i);
+        // Read the inputs first, as the outputs may alias them. The lanes
+        // past m repeat the first one.
+        double lat1x[LANES], lon1x[LANES], azi1x[LANES], s12x[LANES];
+        for (int k = 0; k < LANES; ++k) {
+            const int j = i + (k < m ? k : 0);
+            lat1x[k] = lat1[j];
+            lon1x[k] = lon1[j];
+            azi1x[k] = azi1[j];
+            s12x[k] = s12[j];
+        }
+        directLanes(g, m, lat1x, lon1x, azi1x, s12x, lat2 ? lat2 + i : nullptr,
+                    lon2 ? lon2 + i : nullptr, azi2 ? azi2 + i : nullptr);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void geod_inverse_array(const struct geod_geodesic *g, int n,
+                        const double lat1[], const double lon1[],
+                        const double lat2[], const double lon2[],
+                        double s12[], double azi1[], double azi2[]) {
+    GeodPoint pts1[LANES], pts2[LANES];
+    const GeodPoint *p1[LANES], *p2[LANES];
+    for (int k = 0; k < LANES; ++k) {
+        p1[k] = &pts1[k];
+        p2[k] = &pts2[k];
+    }
+    double salp1[LANES], calp1[LANES], salp2[LANES], calp2[LANES];
+    for (int i = 0; i < n; i += LANES) {
+        const int m = std::min(LANES, n - i);
+        // Read the inputs first, as the outputs may alias them
+        for (int k = 0; k < m; ++k) {
+            pts1[k] = prepareGeodPoint(g, lat1[i + k], lon1[i + k]);
+            pts2[k] = prepareGeodPoint(g, lat2[i + k], lon2[i + k]);
+        }
+        inverseLanes(g, m, p1, p2, s12 ? s12 + i : nullptr, salp1, calp1,
+                     salp2, calp2);
+        for (int k = 0; k < m; ++k) {
+            if (azi1)
+                azi1[i + k] = atan2dx(salp1[k], calp1[k]);
+            if (azi2)
+                azi2[i + k] = atan2dx(salp2[k], calp2[k]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void geod_distances(const struct geod_geodesic *g, const double lat1[],
+                    const double lon1[], int n1, const double lat2[],
+                    const double lon2[], int n2, double s12[], int nthreads) {
+    if (n1 <= 0 || n2 <= 0)
+        return;
+    // The terms depending on a single point are computed once per point
+    std::vector<GeodPoint> points1, points2;
+    try {
+        points1.resize(static_cast<size_t>(n1));
+        points2.resize(static_cast<size_t>(n2));
+    } catch (const std::exception &) {
+        for (int i = 0; i < n1; ++i) {
+            for (int j = 0; j < n2; ++j, ++s12) {
+                geod_inverse(g, lat1[i], lon1[i], lat2[j], lon2[j], s12,
+                             nullptr, nullptr);
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < n1; ++i)
+        points1[i] = prepareGeodPoint(g, lat1[i], lon1[i]);
+    for (int j = 0; j < n2; ++j)
+        points2[j] = prepareGeodPoint(g, lat2[j], lon2[j]);
+
+    std::atomic<int> nextRow{0};
+    const auto computeRows = [&]() {
+        const GeodPoint *p1[LANES], *p2[LANES];
+        while (true) {
+            const int i = nextRow++;
+            if (i >= n1)
+                break;
+            for (int k = 0; k < LANES; ++k)
+                p1[k] = &points1[i];
+            double *row = s12 + static_cast<size_t>(i) * n2;
+            for (int j = 0; j < n2; j += LANES) {
+                const int m = std::min(LANES, n2 - j);
+                for (int k = 0; k < m; ++k)
+                    p2[k] = &points2[j + k];
+                inverseLanes(g, m, p1, p2, row + j, nullptr, nullptr, nullptr,
+                             nullptr);
+            }
+        }
+    };
+    runWorkers(nthreads, static_cast<size_t>(n1), computeRows);
+}
+
+// ---------------------------------------------------------------------------
+
+int geod_nearest(const struct geod_geodesic *g, double lat, double lon,
+                 const double lats[], const double lons[], int n,
+                 double *ps12) {
+    const GeodPoint pt = prepareGeodPoint(g, lat, lon);
+    GeodPoint pts[LANES];
+    const GeodPoint *p1[LANES], *p2[LANES];
+    for (int k = 0; k < LANES; ++k) {
+        p1[k] = &pt;
+        p2[k] = &pts[k];
+    }
+    double s12[LANES];
+    int imin = -1;
+    double smin = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < n; i += LANES) {
+        const int m = std::min(LANES, n - i);
+        for (int k = 0; k < m; ++k)
+            pts[k] = prepareGeodPoint(g, lats[i + k], lons[i + k]);
+        inverseLanes(g, m, p1, p2, s12, nullptr, nullptr, nullptr, nullptr);
+        for (int k = 0; k < m; ++k) {
+            if (imin < 0 ? !std::isnan(s12[k]) : s12[k] < smin) {
+                imin = i + k;
+                smin = s12[k];
+            }
+        }
+    }
+    if (ps12)
+        *ps12 = smin;
+    return imin;
+}
+
+// ---------------------------------------------------------------------------
+
+void geod_polygon_addpoints(const struct geod_geodesic *g,
+                            struct geod_polygon *p, const double lats[],
+                            const double lons[], int n, int nthreads) {
+    if (n <= 0)
+        return;
+    int i0 = 0;
+    if (p->num == 0) {
+        geod_polygon_addpoint(g, p, lats[0], lons[0]);
+        i0 = 1;
+    }
+    const size_t nEdges = static_cast<size_t>(n - i0);
+    constexpr size_t CHUNK_SIZE = 1024;
+    if (nthreads <= 1 || nEdges <= CHUNK_SIZE) {
+        for (int i = i0; i < n; ++i)
+            geod_polygon_addpoint(g, p, lats[i], lons[i]);
+        return;
+    }
+
+    // Phase 1: compute the edges, from the current point of the polygon to
+    // lats[i0], lons[i0], and then between consecutive points.
+    std::vector<double> s12, S12;
+    try {
+        s12.resize(nEdges);
+        if (!p->polyline)
+            S12.resize(nEdges);
+    } catch (const std::exception &) {
+        for (int i = i0; i < n; ++i)
+            geod_polygon_addpoint(g, p, lats[i], lons[i]);
+        return;
+    }
+    const double latStart = p->lat;
+    const double lonStart = p->lon;
+    const bool polyline = p->polyline != 0;
+    const size_t nChunks = (nEdges + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::atomic<size_t> nextChunk{0};
+    const auto computeEdges = [&]() {
+        while (true) {
+            const size_t chunk = nextChunk++;
+            if (chunk >= nChunks)
+                break;
+            const size_t end = std::min(nEdges, (chunk + 1) * CHUNK_SIZE);
+            for (size_t k = chunk * CHUNK_SIZE; k < end; ++k) {
+                const size_t i = i0 + k;
+                geod_geninverse(g, k == 0 ? latStart : lats[i - 1],
+                                k == 0 ? lonStart : lons[i - 1], lats[i],
+                                lons[i], &s12[k], nullptr, nullptr, nullptr,
+                                nullptr, nullptr,
+                                polyline ? nullptr : &S12[k]);
+            }
+        }
+    };
+
+    runWorkers(nthreads, nChunks, computeEdges);
+
+    // Phase 2: accumulate the edges in order, as geod_polygon_addpoint()
+    // does, so that the compensated sums are identical.
+    for (size_t k = 0; k < nEdges; ++k) {
+        const size_t i = i0 + k;
+        accadd(p->P, s12[k]);
+        if (!polyline) {
+            accadd(p->A, S12[k]);
+            p->crossings += transit(p->lon, lons[i]);
+        }
+        p->lat = lats[i];
+        p->lon = lons[i];
+        ++p->num;
+    }
+}
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Batch functions built on top of the geodesic library
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/**
+ * \file geod_batch.h
+ * \brief Batch functions built on top of the geodesic library.
+ *
+ * geodesic.h is maintained as part of GeographicLib. The functions declared
+ * here are specific to PROJ. They give the same results as calling the
+ * functions of geodesic.h once for each element: except for
+ * geod_polygon_addpoints(), they use a private copy of the algorithms of
+ * geodesic.c, which performs the same floating point operations but
+ * evaluates the series for several geodesics at once.
+ */
+
+#ifndef GEOD_BATCH_H
+#define GEOD_BATCH_H
+
+#include "geodesic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Solve the direct geodesic problem for arrays of starting points.
+ *
+ * @param[in] g a pointer to the geod_geodesic object specifying the
+ *   ellipsoid.
+ * @param[in] n the number of geodesics.
+ * @param[in] lat1 an array of the latitudes of points 1 (degrees).
+ * @param[in] lon1 an array of the longitudes of points 1 (degrees).
+ * @param[in] azi1 an array of the azimuths at points 1 (degrees).
+ * @param[in] s12 an array of the distances from points 1 to points 2
+ *   (meters); they can be negative.
+ * @param[out] lat2 an array receiving the latitudes of points 2 (degrees).
+ * @param[out] lon2 an array receiving the longitudes of points 2 (degrees).
+ * @param[out] azi2 an array receiving the (forward) azimuths at points 2
+ *   (degrees).
+ *
+ * This is equivalent to calling geod_direct() \e n times and gives
+ * identical results. All the arrays have \e n elements. Any of the output
+ * arrays may be replaced by 0, if you do not need some quantities computed,
+ * and an output array may be the same as an input array, e.g., \e lat2 =
+ * \e lat1 to update the positions in place.
+ *
+ * @since 9.5
+ */
+void GEOD_DLL geod_direct_array(const struct geod_geodesic *g, int n,
+                                const double lat1[], const double lon1[],
+                                const double azi1[], const double s12[],
+                                double lat2[], double lon2[], double azi2[]);
+
+/**
+ * Solve the inverse geodesic problem for arrays of point pairs.
+ *
+ * @param[in] g a pointer to the geod_geodesic object specifying the
+ *   ellipsoid.
+ * @param[in] n the number of point pairs.
+ * @param[in] lat1 an array of the latitudes of points 1 (degrees).
+ * @param[in] lon1 an array of the longitudes of points 1 (degrees).
+ * @param[in] lat2 an array of the latitudes of points 2 (degrees).
+ * @param[in] lon2 an array of the longitudes of points 2 (degrees).
+ * @param[out] s12 an array receiving the distances from points 1 to
+ *   points 2 (meters).
+ * @param[out] azi1 an array receiving the azimuths at points 1 (degrees).
+ * @param[out] azi2 an array receiving the (forward) azimuths at points 2
+ *   (degrees).
+ *
+ * This is equivalent to calling geod_inverse() \e n times, with the
+ * <i>i</i>th pair of points given by \e lat1[i], \e lon1[i], \e lat2[i],
+ * \e lon2[i], and gives identical results. All the arrays have \e n
+ * elements. Any of the output arrays may be replaced by 0, if you do not
+ * need some quantities computed, and an output array may be the same as an
+ * input array. The distances between consecutive points of a track of \e m
+ * points are obtained by passing \e lats, \e lons, \e lats + 1, \e lons + 1
+ * with \e n = \e m &minus; 1.
+ *
+ * @since 9.5
+ */
+void GEOD_DLL geod_inverse_array(const struct geod_geodesic *g, int n,
+                                 const double lat1[], const double lon1[],
+                                 const double lat2[], const double lon2[],
+                                 double s12[], double azi1[], double azi2[]);
+
+/**
+ * Compute the matrix of the distances between two sets of points.
+ *
+ * @param[in] g a pointer to the geod_geodesic object specifying the
+ *   ellipsoid.
+ * @param[in] lat1 an array of the latitudes of the \e n1 points 1 (degrees).
+ * @param[in] lon1 an array of the longitudes of the \e n1 points 1 (degrees).
+ * @param[in] n1 the number of points 1.
+ * @param[in] lat2 an array of the latitudes of the \e n2 points 2 (degrees).
+ * @param[in] lon2 an array of the longitudes of the \e n2 points 2 (degrees).
+ * @param[in] n2 the number of points 2.
+ * @param[out] s12 an array of \e n1 &times; \e n2 elements receiving the
+ *   distances (meters); the distance from point 1 \e i to point 2 \e j is
+ *   stored in \e s12[i * n2 + j].
+ * @param[in] nthreads the maximum number of threads computing the rows of
+ *   the matrix; with 1 or less, all of them are computed by the calling
+ *   thread.
+ *
+ * The distances are identical to the ones returned by geod_inverse(). The
+ * terms depending on a single point, such as its reduced latitude, are
+ * computed once per point. The one-to-many distances are obtained with
+ * \e n1 = 1. The threads are started by each call, so \e nthreads > 1 is
+ * only worth it for large matrices.
+ *
+ * @since 9.5
+ */
+void GEOD_DLL geod_distances(const struct geod_geodesic *g,
+                             const double lat1[], const double lon1[], int n1,
+                             const double lat2[], const double lon2[], int n2,
+                             double s12[], int nthreads);
+
+/**
+ * Find the point nearest to a reference point.
+ *
+ * @param[in] g a pointer to the geod_geodesic object specifying the
+ *   ellipsoid.
+ * @param[in] lat the latitude of the reference point (degrees).
+ * @param[in] lon the longitude of the reference point (degrees).
+ * @param[in] lats an array of the latitudes of the \e n candidate points
+ *   (degrees).
+ * @param[in] lons an array of the longitudes of the \e n candidate points
+ *   (degrees).
+ * @param[in] n the number of candidate points.
+ * @param[out] ps12 pointer to the distance from the reference point to the
+ *   nearest point (meters).
+ * @return the index of the nearest point, or &minus;1 if \e n is 0 or if
+ *   all the distances are NaN.
+ *
+ * The distances are identical to the ones returned by geod_inverse(). If
+ * several points are at the same distance, the first one is returned.
+ * \e ps12 may be replaced by 0.
+ *
+ * @since 9.5
+ */
+int GEOD_DLL geod_nearest(const struct geod_geodesic *g, double lat,
+                          double lon, const double lats[], const double lons[],
+                          int n, double *ps12);
+
+/**
+ * Add an array of points to the polygon or polyline.
+ *
+ * @param[in] g a pointer to the geod_geodesic object specifying the
+ *   ellipsoid.
+ * @param[in,out] p a pointer to the geod_polygon object specifying the
+ *   polygon.
+ * @param[in] lats an array of the latitudes of the points (degrees).
+ * @param[in] lons an array of the longitudes of the points (degrees).
+ * @param[in] n the number of points.
+ * @param[in] nthreads the maximum number of threads computing the edges;
+ *   with 1 or less, all of them are computed by the calling thread.
+ *
+ * This gives identical results to calling geod_polygon_addpoint() \e n
+ * times, and can be mixed with calls to geod_polygon_addpoint() and
+ * geod_polygon_addedge(). The edges are computed by chunks of 1024, shared
+ * by the threads, and then accumulated in order. The threads are started by
+ * each call, so \e nthreads > 1 is only worth it for large arrays.
+ *
+ * @since 9.5
+ */
+void GEOD_DLL geod_polygon_addpoints(const struct geod_geodesic *g,
+                                     struct geod_polygon *p,
+                                     const double lats[], const double lons[],
+                                     int n, int nthreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GEOD_BATCH_H */
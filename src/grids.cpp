@@ -36,15 +36,27 @@
 #include "proj/internal/internal.hpp"
 #include "proj/internal/lru_cache.hpp"
 #include "proj_internal.h"
+#include "thread_pool.hpp"
 
 #ifdef TIFF_ENABLED
 #include "tiffio.h"
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
 
 NS_PROJ_START
 
@@ -411,27 +423,46 @@ class BlockCache {
     const std::vector<unsigned char> *get(uint32_t ifdIdx,
                                           uint32_t blockNumber);
 
-  private:
     typedef uint64_t Key;
 
+    static Key key(uint32_t ifdIdx, uint32_t blockNumber) {
+        return (static_cast<uint64_t>(ifdIdx) << 32) | blockNumber;
+    }
+
+    // Replace the blocks loaded by a previous GTiffDataset::prefetch() call.
+    // Contrary to the ones of the LRU cache, they are never evicted.
+    void setPrefetched(std::map<Key, std::vector<unsigned char>> &&blocks) {
+        prefetched_ = std::move(blocks);
+    }
+
+  private:
     static constexpr int NUM_BLOCKS_AT_CROSSING_TILES = 4;
     static constexpr int MAX_SAMPLE_COUNT = 3;
     lru11::Cache<Key, std::vector<unsigned char>, lru11::NullLock> cache_{
         NUM_BLOCKS_AT_CROSSING_TILES * MAX_SAMPLE_COUNT};
+    std::map<Key, std::vector<unsigned char>> prefetched_{};
 };
 
 // ---------------------------------------------------------------------------
 
 void BlockCache::insert(uint32_t ifdIdx, uint32_t blockNumber,
                         const std::vector<unsigned char> &data) {
-    cache_.insert((static_cast<uint64_t>(ifdIdx) << 32) | blockNumber, data);
+    cache_.insert(key(ifdIdx, blockNumber), data);
 }
 
 // ---------------------------------------------------------------------------
 
 const std::vector<unsigned char> *BlockCache::get(uint32_t ifdIdx,
                                                   uint32_t blockNumber) {
-    return cache_.getPtr((static_cast<uint64_t>(ifdIdx) << 32) | blockNumber);
+    const auto k = key(ifdIdx, blockNumber);
+    const auto ret = cache_.getPtr(k);
+    if (ret == nullptr && !prefetched_.empty()) {
+        const auto iter = prefetched_.find(k);
+        if (iter != prefetched_.end()) {
+            return &(iter->second);
+        }
+    }
+    return ret;
 }
 
 // ---------------------------------------------------------------------------
@@ -450,6 +481,7 @@ class GTiffGrid : public Grid {
     bool m_tiled;
     uint32_t m_blockWidth = 0;
     uint32_t m_blockHeight = 0;
+    size_t m_blockSize = 0;
     mutable std::vector<unsigned char> m_buffer{};
     mutable uint32_t m_bufferBlockId = std::numeric_limits<uint32_t>::max();
     unsigned m_blocksPerRow = 0;
@@ -495,6 +527,22 @@ class GTiffGrid : public Grid {
 
     uint32_t subfileType() const { return m_subfileType; }
 
+    uint32_t ifdIdx() const { return m_ifdIdx; }
+
+    // Size in bytes of a decoded block.
+    size_t blockSize() const { return m_blockSize; }
+
+    // Append to blockIds the identifiers of the blocks needed to interpolate
+    // in the specified area, expressed in the units of the grid extent.
+    void getBlocksIntersecting(double west, double south, double east,
+                               double north,
+                               std::vector<uint32_t> &blockIds) const;
+
+    // Read and decode a block using hTIFF, which may be another handle than
+    // the one of the grid, opened on the same file.
+    bool readBlock(TIFF *hTIFF, uint32_t blockId,
+                   std::vector<unsigned char> &buffer) const;
+
     void reassign_context(PJ_CONTEXT *ctx) { m_ctx = ctx; }
 
     bool hasChanged() const override { return m_fp->hasChanged(); }
@@ -534,6 +582,8 @@ GTiffGrid::GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, BlockCache &cache, File *fp,
     m_blocksPerRow = (m_width + m_blockWidth - 1) / m_blockWidth;
     m_blocksPerCol = (m_height + m_blockHeight - 1) / m_blockHeight;
     m_blocks = m_blocksPerRow * m_blocksPerCol;
+    m_blockSize = static_cast<size_t>(m_tiled ? TIFFTileSize64(m_hTIFF)
+                                              : TIFFStripSize64(m_hTIFF));
 
     const char *text = nullptr;
     // Poor-man XML parsing of TIFFTAG_GDAL_METADATA tag. Hopefully good
@@ -930,6 +980,82 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
 
 // ---------------------------------------------------------------------------
 
+void GTiffGrid::getBlocksIntersecting(double west, double south, double east,
+                                      double north,
+                                      std::vector<uint32_t> &blockIds) const {
+    const auto &extent = m_extent;
+    if (north < extent.south || south > extent.north)
+        return;
+    const auto toIndex = [](double v, int maxVal) {
+        return static_cast<int>(std::max(0.0, std::min(v, double(maxVal))));
+    };
+    const int yMin =
+        toIndex(std::floor((south - extent.south) * extent.invResY),
+                m_height - 1);
+    const int yMax = toIndex(
+        std::ceil((north - extent.south) * extent.invResY), m_height - 1);
+    const int yTIFFMin = m_bottomUp ? yMin : m_height - 1 - yMax;
+    const int yTIFFMax = m_bottomUp ? yMax : m_height - 1 - yMin;
+
+    if (extent.isGeographic && east < west)
+        east += 2 * M_PI;
+    std::vector<bool> blockColumns(m_blocksPerRow);
+    bool found = false;
+    for (const double lonShift : {0.0, -2 * M_PI, 2 * M_PI}) {
+        if (lonShift != 0 && !extent.isGeographic)
+            break;
+        const double w = west + lonShift;
+        const double e = east + lonShift;
+        if (e < extent.west || w > extent.east)
+            continue;
+        const int xMin = toIndex(std::floor((w - extent.west) * extent.invResX),
+                                 m_width - 1);
+        const int xMax = toIndex(std::ceil((e - extent.west) * extent.invResX),
+                                 m_width - 1);
+        for (int i = xMin / static_cast<int>(m_blockWidth);
+             i <= xMax / static_cast<int>(m_blockWidth); ++i) {
+            blockColumns[i] = true;
+            found = true;
+        }
+    }
+    if (!found)
+        return;
+
+    const int planes =
+        m_planarConfig == PLANARCONFIG_SEPARATE ? m_samplesPerPixel : 1;
+    for (int plane = 0; plane < planes; ++plane) {
+        for (int j = yTIFFMin / static_cast<int>(m_blockHeight);
+             j <= yTIFFMax / static_cast<int>(m_blockHeight); ++j) {
+            for (unsigned i = 0; i < m_blocksPerRow; ++i) {
+                if (blockColumns[i]) {
+                    blockIds.push_back(plane * m_blocks + j * m_blocksPerRow +
+                                       i);
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+bool GTiffGrid::readBlock(TIFF *hTIFF, uint32_t blockId,
+                          std::vector<unsigned char> &buffer) const {
+    if (TIFFCurrentDirOffset(hTIFF) != m_dirOffset &&
+        !TIFFSetSubDirectory(hTIFF, m_dirOffset)) {
+        return false;
+    }
+    buffer.resize(static_cast<size_t>(m_tiled ? TIFFTileSize64(hTIFF)
+                                              : TIFFStripSize64(hTIFF)));
+    if (m_tiled) {
+        return TIFFReadEncodedTile(hTIFF, blockId, buffer.data(),
+                                   buffer.size()) != -1;
+    }
+    return TIFFReadEncodedStrip(hTIFF, blockId, buffer.data(),
+                                buffer.size()) != -1;
+}
+
+// ---------------------------------------------------------------------------
+
 bool GTiffGrid::isNodata(float val) const {
     return (m_hasNodata && val == m_noData) || std::isnan(val);
 }
@@ -997,6 +1123,111 @@ class GTiffDataset {
 
     static void tiffUnmapProc(thandle_t, tdata_t, toff_t) {}
 
+    struct PrefetchState;
+
+    // Gives a TIFF handle, used by GTiffDataset::prefetch(), read access to
+    // m_fp with its own file position. When used from a thread of the pool,
+    // reads are forwarded to the thread running prefetch(), so that only
+    // that one uses the File and its context.
+    class PrefetchReader {
+        File *m_fp; // nullptr for a pool thread
+        PrefetchState *m_state;
+        unsigned long long m_pos = 0;
+
+        PrefetchReader(const PrefetchReader &) = delete;
+        PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+        static tsize_t tiffReadProc(thandle_t fd, tdata_t buf, tsize_t size) {
+            PrefetchReader *self = static_cast<PrefetchReader *>(fd);
+            size_t nRead = 0;
+            if (self->m_fp) {
+                if (self->m_fp->seek(self->m_pos))
+                    nRead = self->m_fp->read(buf, static_cast<size_t>(size));
+            } else {
+                nRead = self->m_state->forwardRead(
+                    self->m_pos, buf, static_cast<size_t>(size));
+            }
+            self->m_pos += nRead;
+            return static_cast<tsize_t>(nRead);
+        }
+
+        static toff_t tiffSeekProc(thandle_t fd, toff_t off, int whence) {
+            PrefetchReader *self = static_cast<PrefetchReader *>(fd);
+            if (whence == SEEK_SET)
+                self->m_pos = off;
+            else if (whence == SEEK_CUR)
+                self->m_pos += off;
+            else
+                self->m_pos = self->m_state->fileSize + off;
+            return static_cast<toff_t>(self->m_pos);
+        }
+
+        static toff_t tiffSizeProc(thandle_t fd) {
+            return static_cast<PrefetchReader *>(fd)->m_state->fileSize;
+        }
+
+      public:
+        PrefetchReader(File *fp, PrefetchState *state)
+            : m_fp(fp), m_state(state) {}
+
+        TIFF *open(const std::string &filename) {
+            return TIFFClientOpen(
+                filename.c_str(), "r", static_cast<thandle_t>(this),
+                PrefetchReader::tiffReadProc, GTiffDataset::tiffWriteProc,
+                PrefetchReader::tiffSeekProc, GTiffDataset::tiffCloseProc,
+                PrefetchReader::tiffSizeProc, GTiffDataset::tiffMapProc,
+                GTiffDataset::tiffUnmapProc);
+        }
+    };
+
+    // State of a GTiffDataset::prefetch() call, shared with the tasks of the
+    // thread pool helping it. Tasks that start after prefetch() has returned
+    // find it closed and do nothing.
+    struct PrefetchState {
+        struct BlockToLoad {
+            const GTiffGrid *grid;
+            uint32_t blockId;
+            std::vector<unsigned char> data;
+        };
+
+        struct ReadRequest {
+            unsigned long long offset;
+            void *buffer;
+            size_t size;
+            size_t nRead;
+            bool done;
+        };
+
+        const std::string filename;
+        const toff_t fileSize;
+        std::vector<BlockToLoad> blocks{};
+        std::atomic<size_t> nextBlock{0};
+        std::atomic<bool> error{false};
+
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        std::deque<ReadRequest *> requests{};
+        size_t activeTasks = 0;
+        bool closed = false;
+
+        PrefetchState(const std::string &filenameIn, toff_t fileSizeIn)
+            : filename(filenameIn), fileSize(fileSizeIn) {}
+
+        // Decode the next block using hTIFF. Returns false if there is none
+        // left, or in case of error.
+        bool decodeNextBlock(TIFF *hTIFF);
+
+        // Called by a pool thread: wait for the prefetch() thread to read.
+        size_t forwardRead(unsigned long long offset, void *buffer,
+                           size_t size);
+
+        // Called by the prefetch() thread: perform the pending reads.
+        void serveReads(File *fp);
+
+        // Task run by a pool thread.
+        static void runTask(const std::shared_ptr<PrefetchState> &state);
+    };
+
   public:
     GTiffDataset(PJ_CONTEXT *ctx, std::unique_ptr<File> &&fp)
         : m_ctx(ctx), m_fp(std::move(fp)) {}
@@ -1006,6 +1237,10 @@ class GTiffDataset {
 
     std::unique_ptr<GTiffGrid> nextGrid();
 
+    bool prefetch(const std::vector<const GTiffGrid *> &grids, double west,
+                  double south, double east, double north,
+                  size_t &bytesLoaded);
+
     void reassign_context(PJ_CONTEXT *ctx) {
         m_ctx = ctx;
         m_fp->reassign_context(ctx);
@@ -1019,6 +1254,174 @@ GTiffDataset::~GTiffDataset() {
         TIFFClose(m_hTIFF);
 }
 
+// ---------------------------------------------------------------------------
+
+bool GTiffDataset::PrefetchState::decodeNextBlock(TIFF *hTIFF) {
+    if (error)
+        return false;
+    const size_t i = nextBlock++;
+    if (i >= blocks.size())
+        return false;
+    auto &block = blocks[i];
+    try {
+        if (!block.grid->readBlock(hTIFF, block.blockId, block.data)) {
+            error = true;
+        }
+    } catch (const std::exception &) {
+        error = true;
+    }
+    return !error;
+}
+
+// ---------------------------------------------------------------------------
+
+size_t GTiffDataset::PrefetchState::forwardRead(unsigned long long offset,
+                                                void *buffer, size_t size) {
+    ReadRequest request{offset, buffer, size, 0, false};
+    std::unique_lock<std::mutex> lock(mutex);
+    requests.push_back(&request);
+    cv.notify_all();
+    pj_cv_wait(cv, lock, [&request] { return request.done; });
+    return request.nRead;
+}
+
+// ---------------------------------------------------------------------------
+
+void GTiffDataset::PrefetchState::serveReads(File *fp) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!requests.empty()) {
+        ReadRequest *request = requests.front();
+        requests.pop_front();
+        lock.unlock();
+        if (fp->seek(request->offset))
+            request->nRead = fp->read(request->buffer, request->size);
+        lock.lock();
+        request->done = true;
+        cv.notify_all();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void GTiffDataset::PrefetchState::runTask(
+    const std::shared_ptr<PrefetchState> &state) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed)
+            return;
+        ++state->activeTasks;
+    }
+    PrefetchReader reader(nullptr, state.get());
+    TIFF *hTIFF = reader.open(state->filename);
+    if (hTIFF == nullptr) {
+        state->error = true;
+    } else {
+        while (state->decodeNextBlock(hTIFF)) {
+        }
+        TIFFClose(hTIFF);
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    --state->activeTasks;
+    state->cv.notify_all();
+}
+
+// ---------------------------------------------------------------------------
+
+// Load in the block cache the blocks of grids intersecting the area, up to
+// the size of the grid chunk cache. The calling thread decodes blocks, and
+// threads of the pool of the context, if any, help it, each using its own
+// TIFF handle. Only the calling thread uses the File and the context.
+bool GTiffDataset::prefetch(const std::vector<const GTiffGrid *> &grids,
+                            double west, double south, double east,
+                            double north, size_t &bytesLoaded) {
+    pj_load_ini(m_ctx);
+    const long long maxSize = m_ctx->gridChunkCache.max_size;
+
+    const auto oldPos = m_fp->tell();
+    m_fp->seek(0, SEEK_END);
+    const auto state = std::make_shared<PrefetchState>(
+        m_filename, static_cast<toff_t>(m_fp->tell()));
+    m_fp->seek(oldPos);
+
+    std::map<BlockCache::Key, std::vector<unsigned char>> prefetched;
+    unsigned long long totalSize = 0;
+    bool limitReached = false;
+    for (const auto grid : grids) {
+        std::vector<uint32_t> blockIds;
+        grid->getBlocksIntersecting(west, south, east, north, blockIds);
+        for (const auto blockId : blockIds) {
+            if (maxSize > 0 &&
+                totalSize + grid->blockSize() >
+                    static_cast<unsigned long long>(maxSize)) {
+                limitReached = true;
+                break;
+            }
+            totalSize += grid->blockSize();
+            const auto cached = m_cache.get(grid->ifdIdx(), blockId);
+            if (cached) {
+                prefetched[BlockCache::key(grid->ifdIdx(), blockId)] = *cached;
+            } else {
+                state->blocks.push_back(PrefetchState::BlockToLoad{
+                    grid, blockId, std::vector<unsigned char>()});
+            }
+        }
+    }
+    if (limitReached) {
+        pj_log(m_ctx, PJ_LOG_DEBUG,
+               "Prefetching of %s limited to %lld bytes by the grid chunk "
+               "cache size",
+               m_filename.c_str(), maxSize);
+    }
+
+    if (!state->blocks.empty()) {
+        const auto pool = pj_ctx_get_thread_pool(m_ctx);
+        if (pool) {
+            const size_t nTasks =
+                std::min(pool->maxThreads(), state->blocks.size() - 1);
+            for (size_t i = 0; i < nTasks; ++i) {
+                if (!pool->submit([state]() { PrefetchState::runTask(state); }))
+                    break;
+            }
+        }
+
+        PrefetchReader reader(m_fp.get(), state.get());
+        TIFF *hTIFF = reader.open(m_filename);
+        if (hTIFF == nullptr)
+            state->error = true;
+        while (true) {
+            state->serveReads(m_fp.get());
+            // Decode one block before serving reads again
+            if (hTIFF && state->decodeNextBlock(hTIFF))
+                continue;
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->requests.empty() && state->activeTasks == 0) {
+                state->closed = true;
+                break;
+            }
+            pj_cv_wait(state->cv, lock, [&state] {
+                return !state->requests.empty() || state->activeTasks == 0;
+            });
+        }
+        if (hTIFF)
+            TIFFClose(hTIFF);
+
+        if (state->error) {
+            pj_log(m_ctx, PJ_LOG_ERROR, _("Cannot prefetch blocks of %s"),
+                   m_filename.c_str());
+            return false;
+        }
+
+        for (auto &block : state->blocks) {
+            bytesLoaded += block.data.size();
+            prefetched[BlockCache::key(block.grid->ifdIdx(), block.blockId)] =
+                std::move(block.data);
+        }
+    }
+
+    m_cache.setPrefetched(std::move(prefetched));
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 class OneTimeTIFFTagInit {
 
@@ -1346,6 +1749,9 @@ class GTiffVGridShiftSet : public VerticalShiftGridSet {
         }
     }
 
+    bool prefetch(double west, double south, double east, double north,
+                  size_t &bytesLoaded) override;
+
     bool reopen(PJ_CONTEXT *ctx) override {
         pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
                m_name.c_str());
@@ -1460,6 +1866,8 @@ class GTiffVGrid : public VerticalShiftGrid {
 
     void insertGrid(PJ_CONTEXT *ctx, std::unique_ptr<GTiffVGrid> &&subgrid);
 
+    void collectGTiffGrids(std::vector<const GTiffGrid *> &grids) const;
+
     void reassign_context(PJ_CONTEXT *ctx) override {
         m_grid->reassign_context(ctx);
     }
@@ -1506,6 +1914,16 @@ void GTiffVGrid::insertGrid(PJ_CONTEXT *ctx,
 
 // ---------------------------------------------------------------------------
 
+void GTiffVGrid::collectGTiffGrids(
+    std::vector<const GTiffGrid *> &grids) const {
+    grids.push_back(m_grid.get());
+    for (const auto &child : m_children) {
+        static_cast<const GTiffVGrid *>(child.get())->collectGTiffGrids(grids);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 std::unique_ptr<GTiffVGridShiftSet>
 GTiffVGridShiftSet::open(PJ_CONTEXT *ctx, std::unique_ptr<File> fp,
                          const std::string &filename) {
@@ -1596,6 +2014,20 @@ GTiffVGridShiftSet::open(PJ_CONTEXT *ctx, std::unique_ptr<File> fp,
     }
     return set;
 }
+
+// ---------------------------------------------------------------------------
+
+bool GTiffVGridShiftSet::prefetch(double west, double south, double east,
+                                  double north, size_t &bytesLoaded) {
+    if (!m_GTiffDataset)
+        return false;
+    std::vector<const GTiffGrid *> grids;
+    for (const auto &grid : m_grids) {
+        static_cast<const GTiffVGrid *>(grid.get())->collectGTiffGrids(grids);
+    }
+    return m_GTiffDataset->prefetch(grids, west, south, east, north,
+                                    bytesLoaded);
+}
 #endif // TIFF_ENABLED
 
 // ---------------------------------------------------------------------------
@@ -1663,6 +2095,13 @@ VerticalShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 
 // ---------------------------------------------------------------------------
 
+bool VerticalShiftGridSet::prefetch(double, double, double, double,
+                                    size_t &) {
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 bool VerticalShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
@@ -2357,6 +2796,9 @@ class GTiffHGridShiftSet : public HorizontalShiftGridSet {
         }
     }
 
+    bool prefetch(double west, double south, double east, double north,
+                  size_t &bytesLoaded) override;
+
     bool reopen(PJ_CONTEXT *ctx) override {
         pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
                m_name.c_str());
@@ -2407,6 +2849,8 @@ class GTiffHGrid : public HorizontalShiftGrid {
 
     void insertGrid(PJ_CONTEXT *ctx, std::unique_ptr<GTiffHGrid> &&subgrid);
 
+    void collectGTiffGrids(std::vector<const GTiffGrid *> &grids) const;
+
     void reassign_context(PJ_CONTEXT *ctx) override {
         m_grid->reassign_context(ctx);
     }
@@ -2474,6 +2918,16 @@ void GTiffHGrid::insertGrid(PJ_CONTEXT *ctx,
 
 // ---------------------------------------------------------------------------
 
+void GTiffHGrid::collectGTiffGrids(
+    std::vector<const GTiffGrid *> &grids) const {
+    grids.push_back(m_grid.get());
+    for (const auto &child : m_children) {
+        static_cast<const GTiffHGrid *>(child.get())->collectGTiffGrids(grids);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 std::unique_ptr<GTiffHGridShiftSet>
 GTiffHGridShiftSet::open(PJ_CONTEXT *ctx, std::unique_ptr<File> fp,
                          const std::string &filename) {
@@ -2642,6 +3096,20 @@ GTiffHGridShiftSet::open(PJ_CONTEXT *ctx, std::unique_ptr<File> fp,
     }
     return set;
 }
+
+// ---------------------------------------------------------------------------
+
+bool GTiffHGridShiftSet::prefetch(double west, double south, double east,
+                                  double north, size_t &bytesLoaded) {
+    if (!m_GTiffDataset)
+        return false;
+    std::vector<const GTiffGrid *> grids;
+    for (const auto &grid : m_grids) {
+        static_cast<const GTiffHGrid *>(grid.get())->collectGTiffGrids(grids);
+    }
+    return m_GTiffDataset->prefetch(grids, west, south, east, north,
+                                    bytesLoaded);
+}
 #endif // TIFF_ENABLED
 
 // ---------------------------------------------------------------------------
@@ -2733,11 +3201,19 @@ HorizontalShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 
 // ---------------------------------------------------------------------------
 
+bool HorizontalShiftGridSet::prefetch(double, double, double, double,
+                                      size_t &) {
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 bool HorizontalShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
     auto newGS = open(ctx, m_name);
     m_grids.clear();
+    m_inverseGridSet.reset();
     if (newGS) {
         m_grids = std::move(newGS->m_grids);
     }
@@ -2784,6 +3260,9 @@ void HorizontalShiftGridSet::reassign_context(PJ_CONTEXT *ctx) {
     for (const auto &grid : m_grids) {
         grid->reassign_context(ctx);
     }
+    if (m_inverseGridSet) {
+        m_inverseGridSet->reassign_context(ctx);
+    }
 }
 
 #ifdef TIFF_ENABLED
@@ -2810,6 +3289,9 @@ class GTiffGenericGridShiftSet : public GenericShiftGridSet {
         }
     }
 
+    bool prefetch(double west, double south, double east, double north,
+                  size_t &bytesLoaded) override;
+
     bool reopen(PJ_CONTEXT *ctx) override {
         pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
                m_name.c_str());
@@ -2887,6 +3369,8 @@ class GTiffGenericGrid final : public GenericShiftGrid {
     void insertGrid(PJ_CONTEXT *ctx,
                     std::unique_ptr<GTiffGenericGrid> &&subgrid);
 
+    void collectGTiffGrids(std::vector<const GTiffGrid *> &grids) const;
+
     void reassign_context(PJ_CONTEXT *ctx) override {
         m_grid->reassign_context(ctx);
     }
@@ -2953,6 +3437,17 @@ void GTiffGenericGrid::insertGrid(PJ_CONTEXT *ctx,
         m_children.emplace_back(std::move(subgrid));
     }
 }
+
+// ---------------------------------------------------------------------------
+
+void GTiffGenericGrid::collectGTiffGrids(
+    std::vector<const GTiffGrid *> &grids) const {
+    grids.push_back(m_grid.get());
+    for (const auto &child : m_children) {
+        static_cast<const GTiffGenericGrid *>(child.get())
+            ->collectGTiffGrids(grids);
+    }
+}
 #endif // TIFF_ENABLED
 
 // ---------------------------------------------------------------------------
@@ -3041,6 +3536,22 @@ GTiffGenericGridShiftSet::open(PJ_CONTEXT *ctx, std::unique_ptr<File> fp,
     }
     return set;
 }
+
+// ---------------------------------------------------------------------------
+
+bool GTiffGenericGridShiftSet::prefetch(double west, double south,
+                                        double east, double north,
+                                        size_t &bytesLoaded) {
+    if (!m_GTiffDataset)
+        return false;
+    std::vector<const GTiffGrid *> grids;
+    for (const auto &grid : m_grids) {
+        static_cast<const GTiffGenericGrid *>(grid.get())
+            ->collectGTiffGrids(grids);
+    }
+    return m_GTiffDataset->prefetch(grids, west, south, east, north,
+                                    bytesLoaded);
+}
 #endif // TIFF_ENABLED
 
 // ---------------------------------------------------------------------------
@@ -3133,6 +3644,13 @@ GenericShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 
 // ---------------------------------------------------------------------------
 
+bool GenericShiftGridSet::prefetch(double, double, double, double,
+                                   size_t &) {
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 bool GenericShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
@@ -3311,9 +3829,12 @@ typedef struct {
     int32_t lam, phi;
 } ILP;
 
-// Apply bilinear interpolation for horizontal shift grids
+// Apply bilinear interpolation for horizontal shift grids.
+// If jacobianOut is not null, it receives the partial derivatives of the
+// shift (d(val.lam)/dlam, d(val.lam)/dphi, d(val.phi)/dlam, d(val.phi)/dphi)
 static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
-                                  bool compensateNTConvention) {
+                                  bool compensateNTConvention,
+                                  double *jacobianOut = nullptr) {
     PJ_LP val, frct;
     ILP indx;
     int in;
@@ -3369,6 +3890,23 @@ static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
         return val;
     }
 
+    if (jacobianOut) {
+        const double fx = frct.lam;
+        const double fy = frct.phi;
+        jacobianOut[0] = ((1 - fy) * (f10Long - f00Long) +
+                          fy * (f11Long - f01Long)) /
+                         extent.resX;
+        jacobianOut[1] = ((1 - fx) * (f01Long - f00Long) +
+                          fx * (f11Long - f10Long)) /
+                         extent.resY;
+        jacobianOut[2] =
+            ((1 - fy) * (f10Lat - f00Lat) + fy * (f11Lat - f01Lat)) /
+            extent.resX;
+        jacobianOut[3] =
+            ((1 - fx) * (f01Lat - f00Lat) + fx * (f11Lat - f10Lat)) /
+            extent.resY;
+    }
+
     double m10 = frct.lam;
     double m11 = m10;
     double m01 = 1. - frct.lam;
@@ -3385,6 +3923,29 @@ static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
 
 // ---------------------------------------------------------------------------
 
+void pj_inverse_grid_shift_step(const double jacobian[4], double &dx,
+                                double &dy) {
+    // We want to solve guess + shift(guess) = target. (dx, dy) is the
+    // residual at the current guess. Instead of subtracting it as is (fixed
+    // point iteration), apply a Newton step using the Jacobian of
+    // guess + shift(guess). As shift is bilinear within a grid cell, this
+    // converges in one or two steps.
+    const double a = 1 + jacobian[0];
+    const double b = jacobian[1];
+    const double c = jacobian[2];
+    const double d = 1 + jacobian[3];
+    const double det = a * d - b * c;
+    // Keep the fixed point step if the Jacobian is degenerate (or NaN)
+    if (!(std::fabs(det) > 1e-3))
+        return;
+    const double stepX = (d * dx - b * dy) / det;
+    const double stepY = (a * dy - c * dx) / det;
+    dx = stepX;
+    dy = stepY;
+}
+
+// ---------------------------------------------------------------------------
+
 #define MAX_ITERATIONS 10
 #define TOL 1e-12
 
@@ -3395,6 +3956,7 @@ static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
                                      const ListOfHGrids &grids,
                                      bool &shouldRetry) {
     PJ_LP t, tb, del, dif;
+    double jacobian[4] = {0, 0, 0, 0};
     int i = MAX_ITERATIONS;
     const double toltol = TOL * TOL;
 
@@ -3414,25 +3976,50 @@ static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
         tb.lam -= 2 * M_PI;
     tb.phi -= extent->south;
 
-    t = pj_hgrid_interpolate(tb, grid, true);
-    if (grid->hasChanged()) {
-        shouldRetry = gridset->reopen(ctx);
-        return t;
+    // If a precomputed inverse grid is available, use it for the first guess
+    bool hasGuessFromInverseGrid = false;
+    const auto invGridSet = gridset->inverseGridSet();
+    if (direction == PJ_INV && invGridSet) {
+        const auto invGrid = invGridSet->gridAt(in.lam, in.phi);
+        if (invGrid) {
+            const auto &invExtent = invGrid->extentAndRes();
+            PJ_LP tInv = in;
+            tInv.lam -= invExtent.west;
+            if (tInv.lam + epsilon < 0)
+                tInv.lam += 2 * M_PI;
+            else if (tInv.lam - epsilon > invExtent.east - invExtent.west)
+                tInv.lam -= 2 * M_PI;
+            tInv.phi -= invExtent.south;
+            const auto invShift = pj_hgrid_interpolate(tInv, invGrid, true);
+            if (invShift.lam != HUGE_VAL) {
+                t.lam = tb.lam + invShift.lam;
+                t.phi = tb.phi + invShift.phi;
+                hasGuessFromInverseGrid = true;
+            }
+        }
     }
-    if (t.lam == HUGE_VAL)
-        return t;
 
-    if (direction == PJ_FWD) {
-        in.lam += t.lam;
-        in.phi += t.phi;
-        return in;
-    }
+    if (!hasGuessFromInverseGrid) {
+        t = pj_hgrid_interpolate(tb, grid, true);
+        if (grid->hasChanged()) {
+            shouldRetry = gridset->reopen(ctx);
+            return t;
+        }
+        if (t.lam == HUGE_VAL)
+            return t;
 
-    t.lam = tb.lam - t.lam;
-    t.phi = tb.phi - t.phi;
+        if (direction == PJ_FWD) {
+            in.lam += t.lam;
+            in.phi += t.phi;
+            return in;
+        }
+
+        t.lam = tb.lam - t.lam;
+        t.phi = tb.phi - t.phi;
+    }
 
     do {
-        del = pj_hgrid_interpolate(t, grid, true);
+        del = pj_hgrid_interpolate(t, grid, true, jacobian);
         if (grid->hasChanged()) {
             shouldRetry = gridset->reopen(ctx);
             return t;
@@ -3467,6 +4054,7 @@ static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
 
         dif.lam = t.lam + del.lam - tb.lam;
         dif.phi = t.phi + del.phi - tb.phi;
+        pj_inverse_grid_shift_step(jacobian, dif.lam, dif.phi);
         t.lam -= dif.lam;
         t.phi -= dif.phi;
 
@@ -3527,6 +4115,352 @@ PJ_LP pj_hgrid_apply(PJ_CONTEXT *ctx, const ListOfHGrids &grids, PJ_LP lp,
     return out;
 }
 
+// ---------------------------------------------------------------------------
+
+bool pj_get_points_extent(const std::vector<PJ_COORD> &points, double &west,
+                          double &south, double &east, double &north) {
+    west = HUGE_VAL;
+    south = HUGE_VAL;
+    east = -HUGE_VAL;
+    north = -HUGE_VAL;
+    for (const auto &point : points) {
+        if (point.xyzt.x == HUGE_VAL || point.xyzt.y == HUGE_VAL ||
+            std::isnan(point.xyzt.x) || std::isnan(point.xyzt.y)) {
+            continue;
+        }
+        west = std::min(west, point.xyzt.x);
+        south = std::min(south, point.xyzt.y);
+        east = std::max(east, point.xyzt.x);
+        north = std::max(north, point.xyzt.y);
+    }
+    return west <= east;
+}
+
+// ---------------------------------------------------------------------------
+
+template <class ListOfGrids>
+static bool gridsPrefetch(const ListOfGrids &grids,
+                          const std::vector<PJ_COORD> &points,
+                          size_t &bytesLoaded) {
+    double west, south, east, north;
+    if (!pj_get_points_extent(points, west, south, east, north))
+        return true;
+    bool ret = true;
+    for (const auto &gridset : grids) {
+        if (!gridset->prefetch(west, south, east, north, bytesLoaded))
+            ret = false;
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+
+bool pj_grids_prefetch(const ListOfHGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded) {
+    return gridsPrefetch(grids, points, bytesLoaded);
+}
+
+// ---------------------------------------------------------------------------
+
+bool pj_grids_prefetch(const ListOfVGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded) {
+    return gridsPrefetch(grids, points, bytesLoaded);
+}
+
+// ---------------------------------------------------------------------------
+
+bool pj_grids_prefetch(const ListOfGenericGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded) {
+    return gridsPrefetch(grids, points, bytesLoaded);
+}
+
+// ---------------------------------------------------------------------------
+
+namespace {
+struct InverseShiftGrid {
+    const HorizontalShiftGrid *grid = nullptr;
+    // Pairs of (lat shift, long shift) in arc-seconds, with the NTv2
+    // convention (positive west longitude shift), line by line from south
+    // to north, and east to west within a line.
+    std::vector<float> shifts{};
+};
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+// Solve the inverse shift at each node of the top-level grids of gridset.
+static std::vector<InverseShiftGrid>
+computeInverseShiftGrids(PJ_CONTEXT *ctx, HorizontalShiftGridSet *gridset,
+                         const ListOfHGrids &grids) {
+    std::vector<InverseShiftGrid> res;
+    const int savedErrno = proj_context_errno(ctx);
+    constexpr double RAD_TO_SEC = 180.0 * 3600.0 / M_PI;
+    for (const auto &topGrid : gridset->grids()) {
+        InverseShiftGrid invGrid;
+        invGrid.grid = topGrid.get();
+        const int width = topGrid->width();
+        const int height = topGrid->height();
+        const auto &extent = topGrid->extentAndRes();
+        invGrid.shifts.resize(2 * static_cast<size_t>(width) * height);
+        for (int iy = 0; iy < height; ++iy) {
+            for (int ix = 0; ix < width; ++ix) {
+                PJ_LP target;
+                target.lam = extent.west + ix * extent.resX;
+                target.phi = extent.south + iy * extent.resY;
+                PJ_LP out;
+                out.lam = HUGE_VAL;
+                HorizontalShiftGridSet *gridsetForPoint = nullptr;
+                const auto grid = findGrid(grids, target, gridsetForPoint);
+                if (grid) {
+                    bool shouldRetry = false;
+                    out = pj_hgrid_apply_internal(ctx, target, PJ_INV, grid,
+                                                  gridsetForPoint, grids,
+                                                  shouldRetry);
+                }
+                float dlam = 0;
+                float dphi = 0;
+                if (out.lam != HUGE_VAL) {
+                    dlam = static_cast<float>(
+                        adjlon(out.lam - target.lam) * RAD_TO_SEC);
+                    dphi = static_cast<float>((out.phi - target.phi) *
+                                              RAD_TO_SEC);
+                } else if (topGrid->valueAt(ix, iy, true, dlam, dphi)) {
+                    // First order approximation of the inverse shift
+                    dlam = static_cast<float>(-dlam * RAD_TO_SEC);
+                    dphi = static_cast<float>(-dphi * RAD_TO_SEC);
+                }
+                const size_t idx =
+                    2 * (static_cast<size_t>(iy) * width + (width - 1 - ix));
+                invGrid.shifts[idx] = dphi;
+                invGrid.shifts[idx + 1] = -dlam;
+            }
+        }
+        res.emplace_back(std::move(invGrid));
+    }
+    proj_context_errno_set(ctx, savedErrno);
+    return res;
+}
+
+// ---------------------------------------------------------------------------
+
+static void writeNTv2Record(std::vector<char> &buffer, const char *key,
+                            const void *value, size_t valueSize) {
+    char record[16];
+    memset(record, ' ', 8);
+    memcpy(record, key, std::min<size_t>(strlen(key), 8));
+    memset(record + 8, 0, 8);
+    memcpy(record + 8, value, valueSize);
+    buffer.insert(buffer.end(), record, record + sizeof(record));
+}
+
+static void writeNTv2Record(std::vector<char> &buffer, const char *key,
+                            const char *value) {
+    char padded[8];
+    memset(padded, ' ', sizeof(padded));
+    memcpy(padded, value, std::min<size_t>(strlen(value), 8));
+    writeNTv2Record(buffer, key, padded, sizeof(padded));
+}
+
+static void writeNTv2Record(std::vector<char> &buffer, const char *key,
+                            int value) {
+    writeNTv2Record(buffer, key, &value, sizeof(value));
+}
+
+static void writeNTv2Record(std::vector<char> &buffer, const char *key,
+                            double value) {
+    writeNTv2Record(buffer, key, &value, sizeof(value));
+}
+
+// ---------------------------------------------------------------------------
+
+// Write inverse shift grids as a NTv2 file, in the native byte order.
+static bool
+writeInverseShiftGrids(PJ_CONTEXT *ctx, const std::string &filename,
+                       const std::vector<InverseShiftGrid> &grids) {
+    constexpr double RAD_TO_SEC = 180.0 * 3600.0 / M_PI;
+    std::vector<char> header;
+    writeNTv2Record(header, "NUM_OREC", 11);
+    writeNTv2Record(header, "NUM_SREC", 11);
+    writeNTv2Record(header, "NUM_FILE", static_cast<int>(grids.size()));
+    writeNTv2Record(header, "GS_TYPE", "SECONDS");
+    writeNTv2Record(header, "VERSION", "NTv2.0");
+    writeNTv2Record(header, "SYSTEM_F", "");
+    writeNTv2Record(header, "SYSTEM_T", "");
+    writeNTv2Record(header, "MAJOR_F", 0.0);
+    writeNTv2Record(header, "MINOR_F", 0.0);
+    writeNTv2Record(header, "MAJOR_T", 0.0);
+    writeNTv2Record(header, "MINOR_T", 0.0);
+
+#ifdef _WIN32
+    const int nPID = GetCurrentProcessId();
+#else
+    const int nPID = getpid();
+#endif
+    char szUniqueSuffix[128];
+    snprintf(szUniqueSuffix, sizeof(szUniqueSuffix), ".%d_%p.tmp", nPID,
+             static_cast<const void *>(&grids));
+    const std::string filenameTmp(filename + szUniqueSuffix);
+    auto f = FileManager::open(ctx, filenameTmp.c_str(), FileAccess::CREATE);
+    if (!f) {
+        pj_log(ctx, PJ_LOG_DEBUG, "Cannot create %s", filenameTmp.c_str());
+        return false;
+    }
+    bool ok = f->write(header.data(), header.size()) == header.size();
+
+    int gridIdx = 0;
+    std::vector<float> line;
+    for (const auto &invGrid : grids) {
+        const auto &extent = invGrid.grid->extentAndRes();
+        const int width = invGrid.grid->width();
+        const int height = invGrid.grid->height();
+        char gridName[16];
+        snprintf(gridName, sizeof(gridName), "INV%05d", gridIdx++ % 100000);
+        header.clear();
+        writeNTv2Record(header, "SUB_NAME", gridName);
+        writeNTv2Record(header, "PARENT", "NONE");
+        writeNTv2Record(header, "CREATED", "");
+        writeNTv2Record(header, "UPDATED", "");
+        writeNTv2Record(header, "S_LAT", extent.south * RAD_TO_SEC);
+        writeNTv2Record(header, "N_LAT", extent.north * RAD_TO_SEC);
+        writeNTv2Record(header, "E_LONG", -extent.east * RAD_TO_SEC);
+        writeNTv2Record(header, "W_LONG", -extent.west * RAD_TO_SEC);
+        writeNTv2Record(header, "LAT_INC", extent.resY * RAD_TO_SEC);
+        writeNTv2Record(header, "LONG_INC", extent.resX * RAD_TO_SEC);
+        writeNTv2Record(header, "GS_COUNT", width * height);
+        ok = ok && f->write(header.data(), header.size()) == header.size();
+
+        // 4 components per node: lat shift, long shift, lat error, long error
+        line.assign(4 * static_cast<size_t>(width), 0.0f);
+        for (int iy = 0; ok && iy < height; ++iy) {
+            const float *src =
+                invGrid.shifts.data() + 2 * static_cast<size_t>(iy) * width;
+            for (int ix = 0; ix < width; ++ix) {
+                line[4 * ix] = src[2 * ix];
+                line[4 * ix + 1] = src[2 * ix + 1];
+            }
+            const size_t lineSize = line.size() * sizeof(float);
+            ok = f->write(line.data(), lineSize) == lineSize;
+        }
+    }
+    header.clear();
+    writeNTv2Record(header, "END", 0.0);
+    ok = ok && f->write(header.data(), header.size()) == header.size();
+    f.reset();
+
+    if (!ok || !FileManager::rename(ctx, filenameTmp.c_str(),
+                                    filename.c_str())) {
+        pj_log(ctx, PJ_LOG_DEBUG, "Cannot write %s", filename.c_str());
+        FileManager::unlink(ctx, filenameTmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+// Return whether the grids of invGridSet match the top-level grids of gridset.
+static bool isInverseGridSetOf(const HorizontalShiftGridSet *invGridSet,
+                               const HorizontalShiftGridSet *gridset) {
+    const auto &invGrids = invGridSet->grids();
+    const auto &grids = gridset->grids();
+    if (invGrids.size() != grids.size())
+        return false;
+    for (size_t i = 0; i < grids.size(); ++i) {
+        const auto &extent = grids[i]->extentAndRes();
+        const auto &invExtent = invGrids[i]->extentAndRes();
+        const double epsilon =
+            (extent.resX + extent.resY) * REL_TOLERANCE_HGRIDSHIFT;
+        if (invGrids[i]->width() != grids[i]->width() ||
+            invGrids[i]->height() != grids[i]->height() ||
+            std::fabs(invExtent.west - extent.west) > epsilon ||
+            std::fabs(invExtent.south - extent.south) > epsilon ||
+            std::fabs(invExtent.resX - extent.resX) > epsilon ||
+            std::fabs(invExtent.resY - extent.resY) > epsilon) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+// Return the size of the file of a grid, or 0 if it cannot be opened.
+static unsigned long long getFileSize(PJ_CONTEXT *ctx,
+                                      const std::string &name) {
+    auto file = FileManager::open_resource_file(ctx, name.c_str());
+    if (!file) {
+        proj_context_errno_set(ctx, 0);
+        return 0;
+    }
+    file->seek(0, SEEK_END);
+    return file->tell();
+}
+
+// ---------------------------------------------------------------------------
+
+void pj_hgrid_init_inverse_grids(PJ_CONTEXT *ctx, const ListOfHGrids &grids) {
+    for (const auto &gridset : grids) {
+        if (gridset->m_inverseGridSet || gridset->grids().empty() ||
+            gridset->grids()[0]->isNullGrid()) {
+            continue;
+        }
+
+        // Name the cached file after the basename of the grid, and a hash of
+        // its full name and file size, to avoid collisions and not reuse
+        // the inverse of a grid that has been replaced.
+        const auto &name = gridset->name();
+        const auto fileSize = getFileSize(ctx, name);
+        uint32_t hash = 2166136261U; // FNV-1a
+        const auto hashBytes = [&hash](const void *data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= static_cast<const unsigned char *>(data)[i];
+                hash *= 16777619U;
+            }
+        };
+        hashBytes(name.data(), name.size());
+        hashBytes(&fileSize, sizeof(fileSize));
+        auto pos = name.find_last_of("/\\");
+        const std::string basename(pos == std::string::npos
+                                       ? name
+                                       : name.substr(pos + 1));
+        char szHash[16];
+        snprintf(szHash, sizeof(szHash), "_%08x", hash);
+        const std::string filename(
+            std::string(proj_context_get_user_writable_directory(ctx, true)) +
+            "/inverse_" + basename + szHash + ".gsb");
+
+        if (FileManager::exists(ctx, filename.c_str())) {
+            auto invGridSet = HorizontalShiftGridSet::open(ctx, filename);
+            if (invGridSet && isInverseGridSetOf(invGridSet.get(),
+                                                 gridset.get())) {
+                pj_log(ctx, PJ_LOG_DEBUG, "Using inverse grid %s",
+                       filename.c_str());
+                gridset->m_inverseGridSet = std::move(invGridSet);
+                continue;
+            }
+            proj_context_errno_set(ctx, 0);
+        }
+
+        pj_log(ctx, PJ_LOG_DEBUG, "Computing inverse grid %s",
+               filename.c_str());
+        const auto invGrids =
+            computeInverseShiftGrids(ctx, gridset.get(), grids);
+        if (!writeInverseShiftGrids(ctx, filename, invGrids)) {
+            continue;
+        }
+        auto invGridSet = HorizontalShiftGridSet::open(ctx, filename);
+        if (invGridSet &&
+            isInverseGridSetOf(invGridSet.get(), gridset.get())) {
+            gridset->m_inverseGridSet = std::move(invGridSet);
+        } else {
+            proj_context_errno_set(ctx, 0);
+        }
+    }
+}
+
 /********************************************/
 /*           proj_hgrid_value()             */
 /*                                          */
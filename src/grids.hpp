@@ -29,6 +29,7 @@
 #define GRIDS_HPP_INCLUDED
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "proj.h"
@@ -132,6 +133,11 @@ class PROJ_GCC_DLL VerticalShiftGridSet {
 
     PROJ_FOR_TEST virtual void reassign_context(PJ_CONTEXT *ctx);
     PROJ_FOR_TEST virtual bool reopen(PJ_CONTEXT *ctx);
+
+    // Load in memory the data needed to interpolate in the specified area
+    // (in radians for geographic grids), adding its size to bytesLoaded.
+    PROJ_FOR_TEST virtual bool prefetch(double west, double south, double east,
+                                        double north, size_t &bytesLoaded);
 };
 
 // ---------------------------------------------------------------------------
@@ -160,11 +166,19 @@ class PROJ_GCC_DLL HorizontalShiftGrid : public Grid {
 
 // ---------------------------------------------------------------------------
 
+class HorizontalShiftGridSet;
+typedef std::vector<std::unique_ptr<HorizontalShiftGridSet>> ListOfHGrids;
+
 class PROJ_GCC_DLL HorizontalShiftGridSet {
   protected:
     std::string m_name{};
     std::string m_format{};
     std::vector<std::unique_ptr<HorizontalShiftGrid>> m_grids{};
+    // Grids giving the inverse shift of the top-level grids of m_grids
+    std::unique_ptr<HorizontalShiftGridSet> m_inverseGridSet{};
+
+    friend PROJ_FOR_TEST void
+    pj_hgrid_init_inverse_grids(PJ_CONTEXT *ctx, const ListOfHGrids &grids);
 
     HorizontalShiftGridSet();
 
@@ -182,9 +196,17 @@ class PROJ_GCC_DLL HorizontalShiftGridSet {
     }
     PROJ_FOR_TEST const HorizontalShiftGrid *gridAt(double longitude,
                                                     double lat) const;
+    PROJ_FOR_TEST const HorizontalShiftGridSet *inverseGridSet() const {
+        return m_inverseGridSet.get();
+    }
 
     PROJ_FOR_TEST virtual void reassign_context(PJ_CONTEXT *ctx);
     PROJ_FOR_TEST virtual bool reopen(PJ_CONTEXT *ctx);
+
+    // Load in memory the data needed to interpolate in the specified area
+    // (in radians for geographic grids), adding its size to bytesLoaded.
+    PROJ_FOR_TEST virtual bool prefetch(double west, double south, double east,
+                                        double north, size_t &bytesLoaded);
 };
 
 // ---------------------------------------------------------------------------
@@ -249,14 +271,57 @@ class PROJ_GCC_DLL GenericShiftGridSet {
 
     PROJ_FOR_TEST virtual void reassign_context(PJ_CONTEXT *ctx);
     PROJ_FOR_TEST virtual bool reopen(PJ_CONTEXT *ctx);
+
+    // Load in memory the data needed to interpolate in the specified area
+    // (in radians for geographic grids), adding its size to bytesLoaded.
+    PROJ_FOR_TEST virtual bool prefetch(double west, double south, double east,
+                                        double north, size_t &bytesLoaded);
 };
 
 // ---------------------------------------------------------------------------
 
-typedef std::vector<std::unique_ptr<HorizontalShiftGridSet>> ListOfHGrids;
 typedef std::vector<std::unique_ptr<VerticalShiftGridSet>> ListOfVGrids;
 typedef std::vector<std::unique_ptr<GenericShiftGridSet>> ListOfGenericGrids;
 
+// ---------------------------------------------------------------------------
+
+// Grids of an operation, shared with the copies of the operation made by
+// pj_clone_instantiated() rather than opened again by each of them. As grids
+// cache the data they read, and report errors to the context they are bound
+// to, they must only be used with mutex locked, after binding them to the
+// context of the user with bindContext().
+template <class ListOfGrids> struct SharedGrids {
+    std::mutex mutex{};
+    ListOfGrids grids{};
+    PJ_CONTEXT *boundCtx = nullptr;
+
+    void bindContext(PJ_CONTEXT *ctx) {
+        if (boundCtx != ctx) {
+            for (auto &grid : grids)
+                grid->reassign_context(ctx);
+            boundCtx = ctx;
+        }
+    }
+};
+
+// Release a reference to shared grids. The last reference binds them to
+// ctx, the context of the object releasing it, so that they are not closed
+// through the context of a copy that may have been destroyed.
+template <class T>
+void pj_release_shared_grids(std::shared_ptr<T> &sharedGrids,
+                             PJ_CONTEXT *ctx) {
+    if (!sharedGrids)
+        return;
+    // Other references are released with the mutex locked too, so that
+    // the last one is always seen as such.
+    std::unique_lock<std::mutex> lock(sharedGrids->mutex);
+    if (sharedGrids.use_count() == 1) {
+        sharedGrids->bindContext(ctx);
+        lock.unlock();
+    }
+    sharedGrids.reset();
+}
+
 ListOfVGrids pj_vgrid_init(PJ *P, const char *grids);
 ListOfHGrids pj_hgrid_init(PJ *P, const char *grids);
 ListOfGenericGrids pj_generic_grid_init(PJ *P, const char *grids);
@@ -267,6 +332,28 @@ double pj_vgrid_value(PJ *P, const ListOfVGrids &, PJ_LP lp,
 PJ_LP pj_hgrid_apply(PJ_CONTEXT *ctx, const ListOfHGrids &grids, PJ_LP lp,
                      PJ_DIRECTION direction);
 
+// Compute the extent of the valid points, in their x and y coordinates.
+// Returns false if no point is valid.
+bool pj_get_points_extent(const std::vector<PJ_COORD> &points, double &west,
+                          double &south, double &east, double &north);
+
+// Load in memory the data of the grids needed to transform the points,
+// adding its size to bytesLoaded.
+bool pj_grids_prefetch(const ListOfHGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded);
+bool pj_grids_prefetch(const ListOfVGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded);
+bool pj_grids_prefetch(const ListOfGenericGrids &grids,
+                       const std::vector<PJ_COORD> &points,
+                       size_t &bytesLoaded);
+
+// Load, or compute and cache in the user writable directory, grids giving
+// the inverse shifts, used as the first guess of inverse transformations.
+PROJ_FOR_TEST void pj_hgrid_init_inverse_grids(PJ_CONTEXT *ctx,
+                                              const ListOfHGrids &grids);
+
 const GenericShiftGrid *pj_find_generic_grid(const ListOfGenericGrids &grids,
                                              const PJ_LP &input,
                                              GenericShiftGridSet *&gridSetOut);
@@ -274,6 +361,12 @@ bool pj_bilinear_interpolation_three_samples(
     PJ_CONTEXT *ctx, const GenericShiftGrid *grid, const PJ_LP &lp, int idx1,
     int idx2, int idx3, double &v1, double &v2, double &v3, bool &must_retry);
 
+// Given the residual (dx, dy) of the iterative resolution of an inverse
+// horizontal grid shift, and the Jacobian of the shift at the current guess,
+// replace (dx, dy) with the Newton correction to subtract from the guess.
+void pj_inverse_grid_shift_step(const double jacobian[4], double &dx,
+                                double &dy);
+
 NS_PROJ_END
 
 #endif // GRIDS_HPP_INCLUDED
@@ -33,6 +33,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <unordered_map>
+
 #include "filemanager.hpp"
 #include "geodesic.h"
 #include "proj.h"
@@ -419,16 +421,39 @@ paralist *pj_expand_init(PJ_CONTEXT *ctx, paralist *init) {
 /*      large enough to hold projection specific parameters.            */
 /************************************************************************/
 
+namespace {
+struct OperationNameHash {
+    size_t operator()(const char *name) const {
+        unsigned int len;
+        return pj_param_key(name, &len);
+    }
+};
+
+struct OperationNameEqual {
+    bool operator()(const char *a, const char *b) const {
+        return strcmp(a, b) == 0;
+    }
+};
+} // anonymous namespace
+
 static PJ_CONSTRUCTOR locate_constructor(const char *name) {
-    int i;
-    const char *s;
-    const PJ_OPERATIONS *operations;
-    operations = proj_list_operations();
-    for (i = 0; (s = operations[i].id) && strcmp(name, s); ++i)
-        ;
-    if (nullptr == s)
+    // Index of proj_list_operations(), built on first use. The first
+    // occurrence of a name wins, as with a sequential search.
+    static const std::unordered_map<const char *, PJ_CONSTRUCTOR,
+                                    OperationNameHash, OperationNameEqual>
+        constructors = [] {
+            std::unordered_map<const char *, PJ_CONSTRUCTOR,
+                               OperationNameHash, OperationNameEqual>
+                map;
+            for (const PJ_OPERATIONS *op = proj_list_operations(); op->id;
+                 ++op)
+                map.emplace(op->id, (PJ_CONSTRUCTOR)op->proj);
+            return map;
+        }();
+    const auto iter = constructors.find(name);
+    if (iter == constructors.end())
         return nullptr;
-    return (PJ_CONSTRUCTOR)operations[i].proj;
+    return iter->second;
 }
 
 PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
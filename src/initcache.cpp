@@ -52,6 +52,8 @@ paralist *pj_clone_paralist(const paralist *list) {
 
         newitem->used = 0;
         newitem->next = nullptr;
+        newitem->key_hash = list->key_hash;
+        newitem->key_len = list->key_len;
         strcpy(newitem->param, list->param);
 
         if (next_copy)
@@ -262,3 +262,58 @@ bool pj_inv4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+void pj_inv4d_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    /* Equivalent of pj_inv4d() called on each coordinate of coo whose first
+     * component is not HUGE_VAL, storing in errnos the error code of the
+     * coordinates that fail to transform. Operations providing array
+     * variants of their operators get them called on the whole array. */
+    PJ_CONTEXT *ctx = P->ctx;
+    const int last_errno = ctx->last_errno;
+
+    if (P->inv4d_array && P->skip_inv_prepare && P->skip_inv_finalize) {
+        P->inv4d_array(P, n, coo, errnos);
+        ctx->last_errno = last_errno;
+        return;
+    }
+
+    if (!P->inv_array) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            ctx->last_errno = 0;
+            if (!pj_inv4d(coo[i], P))
+                errnos[i] = ctx->last_errno;
+        }
+        ctx->last_errno = last_errno;
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0])
+            continue;
+        ctx->last_errno = 0;
+        if (!P->skip_inv_prepare)
+            inv_prepare(P, coo[i]);
+        if (HUGE_VAL == coo[i].v[0])
+            coo[i] = proj_coord_error();
+        errnos[i] = ctx->last_errno;
+    }
+
+    P->inv_array(P, n, coo, errnos);
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        ctx->last_errno = errnos[i];
+        if (!P->skip_inv_finalize)
+            inv_finalize(P, coo[i]);
+        if (ctx->last_errno) {
+            coo[i] = proj_coord_error();
+            errnos[i] = ctx->last_errno;
+        }
+    }
+    ctx->last_errno = last_errno;
+}
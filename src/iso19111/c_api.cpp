@@ -279,6 +279,26 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
     }
     return pj;
 }
+
+// ---------------------------------------------------------------------------
+
+/** Create an object holding a coordinate operation, like pj_obj_create(), but
+ * without instantiating it. The object can only be used to query the ISO19111
+ * definition of the operation, until it is replaced by the result of
+ * pj_obj_create() (see PJCoordOperation::instantiate()).
+ */
+PJ *pj_obj_create_deferred(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
+    if (!dynamic_cast<const CoordinateOperation *>(objIn.get()))
+        return pj_obj_create(ctx, objIn);
+    auto pj = pj_new();
+    if (pj) {
+        pj->ctx = ctx;
+        pj->descr = "ISO-19111 object";
+        pj->iso_obj = objIn;
+        pj->iso_obj_is_coordinate_operation = true;
+    }
+    return pj;
+}
 //! @endcond
 
 // ---------------------------------------------------------------------------
@@ -566,6 +586,14 @@ PJ *proj_clone(PJ_CONTEXT *ctx, const PJ *obj) {
         }
         return nullptr;
     }
+    if (obj->iso_obj_is_coordinate_operation) {
+        // Copy the instantiated operation when possible, which is much
+        // cheaper than exporting it as a PROJ string and instantiating it
+        // again.
+        auto newPj = pj_clone_instantiated(ctx, obj);
+        if (newPj)
+            return newPj;
+    }
     try {
         return pj_obj_create(ctx, NN_NO_CHECK(obj->iso_obj));
     } catch (const std::exception &e) {
@@ -8445,6 +8473,68 @@ void proj_operation_factory_context_set_allow_ballpark_transformations(
 
 // ---------------------------------------------------------------------------
 
+/** \brief Set the maximum number of threads that may be used to search for
+ * coordinate operations.
+ *
+ * When greater than 1, the candidate pivots of the search through the datums
+ * of the source and target CRS are explored concurrently. The result is
+ * identical to the one of the single-threaded search.
+ *
+ * @param ctx PROJ context, or NULL for default context
+ * @param factory_ctx Operation factory context. must not be NULL
+ * @param max_threads Maximum number of threads (default is 1). A value of 0
+ * or less means the number of hardware threads.
+ * @since 9.5
+ */
+void proj_operation_factory_context_set_max_threads(
+    PJ_CONTEXT *ctx, PJ_OPERATION_FACTORY_CONTEXT *factory_ctx,
+    int max_threads) {
+    SANITIZE_CTX(ctx);
+    if (!factory_ctx) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER_API_MISUSE);
+        proj_log_error(ctx, __FUNCTION__, "missing required input");
+        return;
+    }
+    try {
+        factory_ctx->operationContext->setMaxThreads(max_threads);
+    } catch (const std::exception &e) {
+        proj_log_error(ctx, __FUNCTION__, e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Set the maximum number of coordinate operations returned by
+ * proj_create_operations().
+ *
+ * The returned operations are the first ones of the list that would be
+ * returned without that limit.
+ *
+ * @param ctx PROJ context, or NULL for default context
+ * @param factory_ctx Operation factory context. must not be NULL
+ * @param max_result_count Maximum number of operations. A value of 0 or less
+ * means no limit (default).
+ * @since 9.5
+ */
+void proj_operation_factory_context_set_max_result_count(
+    PJ_CONTEXT *ctx, PJ_OPERATION_FACTORY_CONTEXT *factory_ctx,
+    int max_result_count) {
+    SANITIZE_CTX(ctx);
+    if (!factory_ctx) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER_API_MISUSE);
+        proj_log_error(ctx, __FUNCTION__, "missing required input");
+        return;
+    }
+    try {
+        factory_ctx->operationContext->setMaxResultCount(
+            max_result_count > 0 ? static_cast<size_t>(max_result_count) : 0);
+    } catch (const std::exception &e) {
+        proj_log_error(ctx, __FUNCTION__, e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 //! @cond Doxygen_Suppress
 /** \brief Opaque object representing a set of operation results. */
 struct PJ_OPERATION_LIST : PJ_OBJ_LIST {
@@ -8689,6 +8779,23 @@ PJ *proj_list_get(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result, int index) {
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+/** Same as proj_list_get(), but coordinate operations are returned as
+ * objects created by pj_obj_create_deferred().
+ */
+PJ *pj_list_get_deferred(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result,
+                         int index) {
+    SANITIZE_CTX(ctx);
+    if (!result || index < 0 || index >= proj_list_get_count(result)) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER_API_MISUSE);
+        return nullptr;
+    }
+    return pj_obj_create_deferred(ctx, result->objects[index]);
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 /** \brief Drops a reference on the result set.
  *
  * This method should be called one and exactly one for each function
@@ -9221,11 +9328,25 @@ PJ *proj_normalize_for_visualization(PJ_CONTEXT *ctx, const PJ *obj) {
                             std::swap(maxxDst, maxyDst);
                         }
                     }
-                    ctx->forceOver = alt.pj->over != 0;
-                    auto pjNormalized =
-                        pj_obj_create(ctx, co->normalizeForVisualization());
+                    // Operations not instantiated yet are only instantiated
+                    // when used, as in the original object
+                    PJ *pjNormalized;
+                    if (alt.instantiationDeferred) {
+                        pjNormalized = pj_obj_create_deferred(
+                            ctx, co->normalizeForVisualization());
+                    } else {
+                        ctx->forceOver = alt.pj->over != 0;
+                        pjNormalized =
+                            pj_obj_create(ctx, co->normalizeForVisualization());
+                        ctx->forceOver = false;
+                    }
+                    if (!pjNormalized)
+                        return nullptr;
                     pjNormalized->over = alt.pj->over;
-                    ctx->forceOver = false;
+                    pjNormalized->errorIfBestTransformationNotAvailable =
+                        alt.pj->errorIfBestTransformationNotAvailable;
+                    pjNormalized->warnIfBestTransformationNotAvailable =
+                        alt.pj->warnIfBestTransformationNotAvailable;
                     pjNew->alternativeCoordinateOperations.emplace_back(
                         alt.idxInOriginalList, minxSrc, minySrc, maxxSrc,
                         maxySrc, minxDst, minyDst, maxxDst, maxyDst,
@@ -9233,6 +9354,8 @@ PJ *proj_normalize_for_visualization(PJ_CONTEXT *ctx, const PJ *obj) {
                         alt.pseudoArea, alt.areaName.c_str(),
                         alt.pjSrcGeocentricToLonLat,
                         alt.pjDstGeocentricToLonLat);
+                    pjNew->alternativeCoordinateOperations.back()
+                        .instantiationDeferred = alt.instantiationDeferred;
                 }
             }
             return pjNew.release();
@@ -43,6 +43,7 @@
 
 #include "proj_json_streaming_writer.hpp"
 
+#include <atomic>
 #include <cmath> // M_PI
 #include <cstdlib>
 #include <memory>
@@ -70,17 +71,43 @@ namespace common {
 
 //! @cond Doxygen_Suppress
 struct UnitOfMeasure::Private {
+    // Interned strings when possible, so that units can be compared by
+    // address, or nullptr, in which case the string is stored below
+    const std::string *internedName_;
     std::string name_{};
     double toSI_ = 1.0;
     UnitOfMeasure::Type type_{UnitOfMeasure::Type::UNKNOWN};
+    const std::string *internedCodeSpace_;
     std::string codeSpace_{};
     std::string code_{};
 
     Private(const std::string &nameIn, double toSIIn,
             UnitOfMeasure::Type typeIn, const std::string &codeSpaceIn,
             const std::string &codeIn)
-        : name_(nameIn), toSI_(toSIIn), type_(typeIn), codeSpace_(codeSpaceIn),
-          code_(codeIn) {}
+        : internedName_(intern(nameIn)), toSI_(toSIIn), type_(typeIn),
+          internedCodeSpace_(intern(codeSpaceIn)), code_(codeIn) {
+        if (!internedName_)
+            name_ = nameIn;
+        if (!internedCodeSpace_)
+            codeSpace_ = codeSpaceIn;
+    }
+
+    Private(const Private &) = default;
+    Private &operator=(const Private &) = default;
+
+    const std::string &name() const {
+        return internedName_ ? *internedName_ : name_;
+    }
+
+    const std::string &codeSpace() const {
+        return internedCodeSpace_ ? *internedCodeSpace_ : codeSpace_;
+    }
+
+    bool hasSameName(const Private &other) const {
+        if (internedName_ && other.internedName_)
+            return internedName_ == other.internedName_;
+        return name() == other.name();
+    }
 };
 //! @endcond
 
@@ -138,7 +165,7 @@ UnitOfMeasureNNPtr UnitOfMeasure::create(const UnitOfMeasure &other) {
 // ---------------------------------------------------------------------------
 
 /** \brief Return the name of the unit of measure. */
-const std::string &UnitOfMeasure::name() PROJ_PURE_DEFN { return d->name_; }
+const std::string &UnitOfMeasure::name() PROJ_PURE_DEFN { return d->name(); }
 
 // ---------------------------------------------------------------------------
 
@@ -166,7 +193,7 @@ UnitOfMeasure::Type UnitOfMeasure::type() PROJ_PURE_DEFN { return d->type_; }
  * @return the code space, or empty string.
  */
 const std::string &UnitOfMeasure::codeSpace() PROJ_PURE_DEFN {
-    return d->codeSpace_;
+    return d->codeSpace();
 }
 
 // ---------------------------------------------------------------------------
@@ -308,7 +335,7 @@ void UnitOfMeasure::_exportToJSON(
  * The comparison is based on the name.
  */
 bool UnitOfMeasure::operator==(const UnitOfMeasure &other) PROJ_PURE_DEFN {
-    return name() == other.name();
+    return d->hasSameName(*(other.d));
 }
 
 // ---------------------------------------------------------------------------
@@ -318,7 +345,7 @@ bool UnitOfMeasure::operator==(const UnitOfMeasure &other) PROJ_PURE_DEFN {
  * The comparison is based on the name.
  */
 bool UnitOfMeasure::operator!=(const UnitOfMeasure &other) PROJ_PURE_DEFN {
-    return name() != other.name();
+    return !d->hasSameName(*(other.d));
 }
 
 // ---------------------------------------------------------------------------
@@ -618,10 +645,57 @@ struct IdentifiedObject::Private {
     std::string remarks{};
     bool isDeprecated{};
 
+    // Normalized forms of the name, computed on first use by
+    // canonicalNames(), as objects may be compared many times
+    struct CanonicalNames {
+        // Identifier::canonicalizeName(name)
+        std::string canonicalized{};
+        // Identifier::equivalentNameKey(name)
+        std::string equivalenceKey{};
+    };
+    mutable std::atomic<CanonicalNames *> canonicalNames_{nullptr};
+
+    Private() = default;
+
+    Private(const Private &other)
+        : name(other.name), identifiers(other.identifiers),
+          aliases(other.aliases), remarks(other.remarks),
+          isDeprecated(other.isDeprecated) {}
+
+    ~Private() { resetCanonicalNames(); }
+
+    Private &operator=(const Private &) = delete;
+
     void setIdentifiers(const PropertyMap &properties);
     void setName(const PropertyMap &properties);
     void setAliases(const PropertyMap &properties);
+
+    const CanonicalNames &canonicalNames() const;
+
+    // Must be called when the name is changed
+    void resetCanonicalNames() { delete canonicalNames_.exchange(nullptr); }
 };
+
+// ---------------------------------------------------------------------------
+
+const IdentifiedObject::Private::CanonicalNames &
+IdentifiedObject::Private::canonicalNames() const {
+    auto names = canonicalNames_.load(std::memory_order_acquire);
+    if (names) {
+        return *names;
+    }
+    const auto &l_name = *(name->description());
+    std::unique_ptr<CanonicalNames> newNames(new CanonicalNames());
+    newNames->canonicalized = Identifier::canonicalizeName(l_name);
+    newNames->equivalenceKey = Identifier::equivalentNameKey(l_name);
+    // Another thread may have computed them concurrently, in which case we
+    // use its result.
+    if (canonicalNames_.compare_exchange_strong(names, newNames.get(),
+                                                std::memory_order_acq_rel)) {
+        return *newNames.release();
+    }
+    return *names;
+}
 //! @endcond
 
 // ---------------------------------------------------------------------------
@@ -845,6 +919,7 @@ void IdentifiedObject::setProperties(
     const PropertyMap &properties) // throw(InvalidValueTypeException)
 {
     d->setName(properties);
+    d->resetCanonicalNames();
     d->setIdentifiers(properties);
     d->setAliases(properties);
 
@@ -871,6 +946,28 @@ void IdentifiedObject::setProperties(
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+// Makes the name string interned, if possible (see internal::intern()), for
+// objects whose names are drawn from a small set of values (operation
+// methods and parameters), so that they are stored once and compared by
+// address.
+void IdentifiedObject::internName() {
+    const auto &l_name = d->name;
+    const auto &l_description = l_name->description();
+    if (l_description.has_value() && l_name->code().empty() &&
+        !l_name->codeSpace().has_value() && !l_name->authority().has_value() &&
+        !l_name->version().has_value() && !l_name->uri().has_value()) {
+        const auto interned = internOptional(l_description);
+        if (interned && interned != &l_description) {
+            d->name = Identifier::createFromInternedDescription(*interned);
+            d->resetCanonicalNames();
+        }
+    }
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 //! @cond Doxygen_Suppress
 void IdentifiedObject::formatID(WKTFormatter *formatter) const {
     const bool isWKT2 = formatter->version() == WKTFormatter::Version::WKT2;
@@ -941,8 +1038,7 @@ bool IdentifiedObject::_isEquivalentTo(
         }
         // TODO test id etc
     } else {
-        if (!metadata::Identifier::isEquivalentName(
-                nameStr().c_str(), otherIdObj->nameStr().c_str())) {
+        if (!hasEquivalentNameTo(otherIdObj)) {
             return hasEquivalentNameToUsingAlias(otherIdObj, dbContext);
         }
     }
@@ -951,6 +1047,26 @@ bool IdentifiedObject::_isEquivalentTo(
 
 // ---------------------------------------------------------------------------
 
+// Returns Identifier::canonicalizeName(nameStr()), computed once.
+const std::string &IdentifiedObject::canonicalName() const {
+    return d->canonicalNames().canonicalized;
+}
+
+// ---------------------------------------------------------------------------
+
+// Same result as Identifier::isEquivalentName(nameStr(), other->nameStr()),
+// but using the normalized names of both objects, computed once.
+bool IdentifiedObject::hasEquivalentNameTo(
+    const IdentifiedObject *other) const {
+    if (&nameStr() == &other->nameStr()) {
+        return true;
+    }
+    return d->canonicalNames().equivalenceKey ==
+           other->d->canonicalNames().equivalenceKey;
+}
+
+// ---------------------------------------------------------------------------
+
 bool IdentifiedObject::hasEquivalentNameToUsingAlias(
     const IdentifiedObject *, const io::DatabaseContextPtr &) const {
     return false;
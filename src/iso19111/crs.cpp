@@ -2664,8 +2664,7 @@ GeodeticCRS::identify(const io::AuthorityFactoryPtr &authorityFactory) const {
                                                     GeographicCRS::EPSG_4267,
                                                     GeographicCRS::EPSG_4269};
         for (const auto &crs : candidatesCRS) {
-            const bool nameEquivalent = metadata::Identifier::isEquivalentName(
-                thisName.c_str(), crs->nameStr().c_str());
+            const bool nameEquivalent = hasEquivalentNameTo(crs.get());
             const bool nameEqual = thisName == crs->nameStr();
             const bool isEq =
                 _isEquivalentTo(crs.get(), crsCriterion, dbContext);
@@ -2830,9 +2829,7 @@ GeodeticCRS::identify(const io::AuthorityFactoryPtr &authorityFactory) const {
                             res.emplace_back(crsNN, 100);
                             return res;
                         }
-                        const bool eqName =
-                            metadata::Identifier::isEquivalentName(
-                                thisName.c_str(), crs->nameStr().c_str());
+                        const bool eqName = hasEquivalentNameTo(crs.get());
                         res.emplace_back(crsNN, eqName ? 90 : 70);
                         gotAbove25Pct = true;
                     } else {
@@ -5518,8 +5515,7 @@ CompoundCRS::identify(const io::AuthorityFactoryPtr &authorityFactory) const {
                     auto crs = util::nn_dynamic_pointer_cast<CompoundCRS>(obj);
                     assert(crs);
                     auto crsNN = NN_NO_CHECK(crs);
-                    const bool eqName = metadata::Identifier::isEquivalentName(
-                        thisName.c_str(), crs->nameStr().c_str());
+                    const bool eqName = hasEquivalentNameTo(crs.get());
                     foundEquivalentName |= eqName;
                     if (_isEquivalentTo(crs.get(), crsCriterion, dbContext)) {
                         if (crs->nameStr() == thisName) {
@@ -5621,8 +5617,7 @@ CompoundCRS::identify(const io::AuthorityFactoryPtr &authorityFactory) const {
                             candidatesVertCRS.front().first->nameStr()),
                     {candidatesHorizCRS.front().first,
                      candidatesVertCRS.front().first});
-                const bool eqName = metadata::Identifier::isEquivalentName(
-                    thisName.c_str(), newCRS->nameStr().c_str());
+                const bool eqName = hasEquivalentNameTo(newCRS.get());
                 res.emplace_back(
                     newCRS,
                     std::min(thisName == newCRS->nameStr() ? 100
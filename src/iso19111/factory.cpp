@@ -50,6 +50,7 @@
 
 #include "filemanager.hpp"
 #include "sqlite3_utils.hpp"
+#include "thread_pool.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -62,6 +63,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <sstream> // std::ostringstream
 #include <stdexcept>
 #include <string>
@@ -754,10 +756,12 @@ struct DatabaseContext::Private {
     // cppcheck-suppress functionStatic
     bool getCRSToCRSCoordOpFromCache(
         const std::string &code,
-        std::vector<operation::CoordinateOperationNNPtr> &list);
+        std::vector<operation::CoordinateOperationNNPtr> &list,
+        bool &hasSkippedOps);
     // cppcheck-suppress functionStatic
     void cache(const std::string &code,
-               const std::vector<operation::CoordinateOperationNNPtr> &list);
+               const std::vector<operation::CoordinateOperationNNPtr> &list,
+               bool hasSkippedOps);
 
     struct GridInfoCache {
         std::string fullFilename{};
@@ -782,6 +786,29 @@ struct DatabaseContext::Private {
     };
     const std::vector<VersionedAuthName> &getCacheAuthNameWithVersion();
 
+    // Rows of the queries of approximate searches of
+    // AuthorityFactory::createObjectsFromNameEx(), with the canonicalized form
+    // of their name.
+    struct NameCandidates {
+        SQLResultSet rows{};
+        std::vector<std::string> canonicalizedNames{};
+    };
+    using NameCandidatesPtr = std::shared_ptr<const NameCandidates>;
+
+    // cppcheck-suppress functionStatic
+    NameCandidatesPtr getNameCandidatesFromCache(const std::string &key);
+    // cppcheck-suppress functionStatic
+    void cache(const std::string &key, const NameCandidatesPtr &candidates);
+
+    // Arena from which objects are allocated, replaced by a new one once
+    // full, so that the memory of the previous one is released with its last
+    // object, once evicted from the caches
+    const util::ObjectArenaPtr &objectArena() {
+        if (objectArena_ && objectArena_->full())
+            objectArena_ = std::make_shared<util::ObjectArena>();
+        return objectArena_;
+    }
+
   private:
     friend class DatabaseContext;
 
@@ -814,8 +841,14 @@ struct DatabaseContext::Private {
     LRUCacheOfObjects cachePrimeMeridian_{CACHE_SIZE};
     LRUCacheOfObjects cacheCS_{CACHE_SIZE};
     LRUCacheOfObjects cacheExtent_{CACHE_SIZE};
-    lru11::Cache<std::string, std::vector<operation::CoordinateOperationNNPtr>>
-        cacheCRSToCrsCoordOp_{CACHE_SIZE};
+    struct CRSToCRSCoordOps {
+        std::vector<operation::CoordinateOperationNNPtr> list{};
+        // Whether operations less accurate than the requested maximum
+        // accuracy have been skipped
+        bool hasSkippedOps = false;
+    };
+    lru11::Cache<std::string, CRSToCRSCoordOps> cacheCRSToCrsCoordOp_{
+        CACHE_SIZE};
     lru11::Cache<std::string, GridInfoCache> cacheGridInfo_{CACHE_SIZE};
 
     std::map<std::string, std::vector<std::string>> cacheAllowedAuthorities_{};
@@ -823,8 +856,27 @@ struct DatabaseContext::Private {
     lru11::Cache<std::string, std::list<std::string>> cacheAliasNames_{
         CACHE_SIZE};
 
+    // Each entry may hold the names of a whole table, so keep few of them
+    lru11::Cache<std::string, NameCandidatesPtr> cacheNameCandidates_{16};
+
     std::vector<VersionedAuthName> cacheAuthNameWithVersion_{};
 
+    // Arena from which objects are allocated, if setUseObjectArena(true)
+    util::ObjectArenaPtr objectArena_{};
+
+    // Contexts on the same database(s) than this one, each used by a single
+    // thread at a time to help this one, and kept so that later calls reuse
+    // them and their caches
+    std::vector<DatabaseContextNNPtr> freeOtherThreadContexts_{};
+    size_t otherThreadContextCount_ = 0;
+
+    // Whether pjCtxt_ has been created for this context, and must be
+    // destroyed with it
+    bool ownsPjCtxt_ = false;
+
+    // Pool of the threads using the above contexts
+    std::unique_ptr<projThreadPool> threadPool_{};
+
     static void insertIntoCache(LRUCacheOfObjects &cache,
                                 const std::string &code,
                                 const util::BaseObjectPtr &obj);
@@ -937,7 +989,12 @@ DatabaseContext::Private::Private() = default;
 DatabaseContext::Private::~Private() {
     assert(recLevel_ == 0);
 
+    // Join the threads before destroying anything they could use
+    threadPool_.reset();
     closeDB();
+    if (ownsPjCtxt_) {
+        proj_context_destroy(pjCtxt_);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -987,6 +1044,7 @@ void DatabaseContext::Private::clearCaches() {
     cacheGridInfo_.clear();
     cacheAllowedAuthorities_.clear();
     cacheAliasNames_.clear();
+    cacheNameCandidates_.clear();
 }
 
 // ---------------------------------------------------------------------------
@@ -1024,16 +1082,27 @@ void DatabaseContext::Private::getFromCache(LRUCacheOfObjects &cache,
 
 bool DatabaseContext::Private::getCRSToCRSCoordOpFromCache(
     const std::string &code,
-    std::vector<operation::CoordinateOperationNNPtr> &list) {
-    return cacheCRSToCrsCoordOp_.tryGet(code, list);
+    std::vector<operation::CoordinateOperationNNPtr> &list,
+    bool &hasSkippedOps) {
+    CRSToCRSCoordOps ops;
+    if (!cacheCRSToCrsCoordOp_.tryGet(code, ops)) {
+        return false;
+    }
+    list = std::move(ops.list);
+    hasSkippedOps = ops.hasSkippedOps;
+    return true;
 }
 
 // ---------------------------------------------------------------------------
 
 void DatabaseContext::Private::cache(
     const std::string &code,
-    const std::vector<operation::CoordinateOperationNNPtr> &list) {
-    cacheCRSToCrsCoordOp_.insert(code, list);
+    const std::vector<operation::CoordinateOperationNNPtr> &list,
+    bool hasSkippedOps) {
+    CRSToCRSCoordOps ops;
+    ops.list = list;
+    ops.hasSkippedOps = hasSkippedOps;
+    cacheCRSToCrsCoordOp_.insert(code, ops);
 }
 
 // ---------------------------------------------------------------------------
@@ -1179,6 +1248,22 @@ void DatabaseContext::Private::cache(const std::string &code,
 
 // ---------------------------------------------------------------------------
 
+DatabaseContext::Private::NameCandidatesPtr
+DatabaseContext::Private::getNameCandidatesFromCache(const std::string &key) {
+    NameCandidatesPtr candidates;
+    cacheNameCandidates_.tryGet(key, candidates);
+    return candidates;
+}
+
+// ---------------------------------------------------------------------------
+
+void DatabaseContext::Private::cache(const std::string &key,
+                                     const NameCandidatesPtr &candidates) {
+    cacheNameCandidates_.insert(key, candidates);
+}
+
+// ---------------------------------------------------------------------------
+
 void DatabaseContext::Private::open(const std::string &databasePath,
                                     PJ_CONTEXT *ctx) {
     if (!ctx) {
@@ -3248,6 +3333,42 @@ void DatabaseContext::stopInsertStatementsSession() {
 
 // ---------------------------------------------------------------------------
 
+/** \brief Sets whether objects instantiated from this context are allocated
+ * from a memory arena.
+ *
+ * When enabled, the objects created by the AuthorityFactory methods are
+ * allocated from large chunks of memory owned by an arena, instead of
+ * requiring individual heap allocations. This speeds up the instantiation
+ * of many objects, at the expense of memory being released by whole arenas:
+ * once an arena reaches 1 MiB, a new one is used, and its memory is released
+ * once all objects allocated from it, including those cached by the context,
+ * have been destroyed.
+ *
+ * Disabled by default.
+ *
+ * @param enable Whether an arena should be used.
+ * @since 9.5
+ */
+void DatabaseContext::setUseObjectArena(bool enable) {
+    if (!enable) {
+        // Objects already allocated keep a reference to the arena
+        d->objectArena_.reset();
+    } else if (!d->objectArena_) {
+        d->objectArena_ = std::make_shared<util::ObjectArena>();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+//! @cond Doxygen_Suppress
+/** Returns the arena objects are currently allocated from, or nullptr. */
+const util::ObjectArenaPtr &DatabaseContext::getObjectArena() const {
+    return d->objectArena_;
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 //! @cond Doxygen_Suppress
 
 DatabaseContextNNPtr DatabaseContext::create(void *sqlite_handle) {
@@ -3258,6 +3379,75 @@ DatabaseContextNNPtr DatabaseContext::create(void *sqlite_handle) {
 
 // ---------------------------------------------------------------------------
 
+PJ_CONTEXT *DatabaseContext::getPJContext() const { return d->pjCtxt(); }
+
+// ---------------------------------------------------------------------------
+
+// Return a context on the same database(s) than this one, with its own
+// PJ_CONTEXT, so that it can be used by another thread concurrently with
+// this one. It must be given back with releaseForOtherThread() once that
+// thread is done with it.
+// Returns nullptr if the context cannot be replicated: when it has been
+// created from an existing SQLite handle, or during an insertion session.
+DatabaseContextPtr DatabaseContext::acquireForOtherThread() {
+    if (d->databasePath_.empty() || d->memoryDbHandle_) {
+        return nullptr;
+    }
+    if (!d->freeOtherThreadContexts_.empty()) {
+        auto otherThreadContext = d->freeOtherThreadContexts_.back();
+        d->freeOtherThreadContexts_.pop_back();
+        return otherThreadContext.as_nullable();
+    }
+    PJ_CONTEXT *ctx = proj_context_clone(d->pjCtxt());
+    if (!ctx) {
+        return nullptr;
+    }
+    DatabaseContextPtr otherThreadContext;
+    try {
+        otherThreadContext =
+            DatabaseContext::create(d->databasePath_,
+                                    d->auxiliaryDatabasePaths_, ctx)
+                .as_nullable();
+    } catch (const std::exception &) {
+        proj_context_destroy(ctx);
+        return nullptr;
+    }
+    otherThreadContext->d->ownsPjCtxt_ = true;
+    ++d->otherThreadContextCount_;
+    return otherThreadContext;
+}
+
+// ---------------------------------------------------------------------------
+
+// Give back a context returned by acquireForOtherThread(), once the other
+// thread is done with it.
+void DatabaseContext::releaseForOtherThread(
+    const DatabaseContextNNPtr &otherThreadContext) {
+    d->freeOtherThreadContexts_.push_back(otherThreadContext);
+}
+
+// ---------------------------------------------------------------------------
+
+// Return the pool of threads in which to use the contexts returned by
+// acquireForOtherThread(), with at least maxThreads threads, or nullptr.
+// The pool lives as long as this context.
+projThreadPool *DatabaseContext::getThreadPool(size_t maxThreads) {
+    if (!d->threadPool_ || d->threadPool_->maxThreads() < maxThreads) {
+        d->threadPool_.reset();
+        d->threadPool_.reset(new (std::nothrow) projThreadPool(maxThreads));
+    }
+    return d->threadPool_.get();
+}
+
+// ---------------------------------------------------------------------------
+
+/** Returns the number of contexts created by acquireForOtherThread(). */
+size_t DatabaseContext::getOtherThreadContextCount() const {
+    return d->otherThreadContextCount_;
+}
+
+// ---------------------------------------------------------------------------
+
 void *DatabaseContext::getSqliteHandle() const { return d->handle()->handle(); }
 
 // ---------------------------------------------------------------------------
@@ -3959,6 +4149,23 @@ struct AuthorityFactory::Private {
         return context_;
     }
 
+    // Arena of the context, to activate in the AuthorityFactory::createXXX()
+    // methods so that the objects they instantiate are allocated from it.
+    inline const util::ObjectArenaPtr &objectArena() const {
+        return context_->getPrivate()->objectArena();
+    }
+
+    // Active in the AuthorityFactory::createXXX() methods: objects are
+    // allocated from the arena of the context, if any, and their strings
+    // may be interned, as they come from the database.
+    struct InstantiationScope {
+        const util::ObjectArena::Scope arenaScope;
+        const internal::InterningScope interningScope{};
+
+        explicit InstantiationScope(const util::ObjectArenaPtr &arena)
+            : arenaScope(arena) {}
+    };
+
     // cppcheck-suppress functionStatic
     void setThis(AuthorityFactoryNNPtr factory) {
         thisFactory_ = factory.as_nullable();
@@ -4298,6 +4505,7 @@ AuthorityFactory::CRSInfo::CRSInfo()
 
 util::BaseObjectNNPtr
 AuthorityFactory::createObject(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
 
     auto res = d->runWithCodeParam("SELECT table_name, type FROM object_view "
                                    "WHERE auth_name = ? AND code = ?",
@@ -4406,6 +4614,7 @@ static FactoryException buildFactoryException(const char *type,
 
 metadata::ExtentNNPtr
 AuthorityFactory::createExtent(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         auto extent = d->context()->d->getExtentFromCache(cacheKey);
@@ -4461,6 +4670,7 @@ AuthorityFactory::createExtent(const std::string &code) const {
 
 UnitOfMeasureNNPtr
 AuthorityFactory::createUnitOfMeasure(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         auto uom = d->context()->d->getUOMFromCache(cacheKey);
@@ -4563,6 +4773,7 @@ static double normalizeMeasure(const std::string &uom_code,
 
 datum::PrimeMeridianNNPtr
 AuthorityFactory::createPrimeMeridian(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         auto pm = d->context()->d->getPrimeMeridianFromCache(cacheKey);
@@ -4654,6 +4865,7 @@ AuthorityFactory::identifyBodyFromSemiMajorAxis(double semi_major_axis,
 
 datum::EllipsoidNNPtr
 AuthorityFactory::createEllipsoid(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         auto ellps = d->context()->d->getEllipsoidFromCache(cacheKey);
@@ -4737,6 +4949,7 @@ AuthorityFactory::createGeodeticDatum(const std::string &code) const {
 void AuthorityFactory::createGeodeticDatumOrEnsemble(
     const std::string &code, datum::GeodeticReferenceFramePtr &outDatum,
     datum::DatumEnsemblePtr &outDatumEnsemble, bool turnEnsembleAsDatum) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         outDatumEnsemble = d->context()->d->getDatumEnsembleFromCache(cacheKey);
@@ -4867,6 +5080,7 @@ AuthorityFactory::createVerticalDatum(const std::string &code) const {
 void AuthorityFactory::createVerticalDatumOrEnsemble(
     const std::string &code, datum::VerticalReferenceFramePtr &outDatum,
     datum::DatumEnsemblePtr &outDatumEnsemble, bool turnEnsembleAsDatum) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     auto res =
         d->runWithCodeParam("SELECT name, publication_date, "
                             "frame_reference_epoch, ensemble_accuracy, anchor, "
@@ -4954,6 +5168,7 @@ void AuthorityFactory::createVerticalDatumOrEnsemble(
 datum::DatumEnsembleNNPtr
 AuthorityFactory::createDatumEnsemble(const std::string &code,
                                       const std::string &type) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     auto res = d->run(
         "SELECT 'geodetic_datum', name, ensemble_accuracy, deprecated FROM "
         "geodetic_datum WHERE "
@@ -5056,6 +5271,7 @@ static cs::MeridianPtr createMeridian(const std::string &val) {
 
 cs::CoordinateSystemNNPtr
 AuthorityFactory::createCoordinateSystem(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     {
         auto cs = d->context()->d->getCoordinateSystemFromCache(cacheKey);
@@ -5241,6 +5457,7 @@ cloneWithProps(const crs::GeodeticCRSNNPtr &geodCRS,
 crs::GeodeticCRSNNPtr
 AuthorityFactory::createGeodeticCRS(const std::string &code,
                                     bool geographicOnly) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     auto crs = d->context()->d->getCRSFromCache(cacheKey);
     if (crs) {
@@ -5361,6 +5578,7 @@ AuthorityFactory::createGeodeticCRS(const std::string &code,
 
 crs::VerticalCRSNNPtr
 AuthorityFactory::createVerticalCRS(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     auto crs = d->context()->d->getCRSFromCache(cacheKey);
     if (crs) {
@@ -5426,6 +5644,7 @@ AuthorityFactory::createVerticalCRS(const std::string &code) const {
 
 operation::ConversionNNPtr
 AuthorityFactory::createConversion(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
 
     static const char *sql =
         "SELECT name, description, "
@@ -5542,6 +5761,7 @@ AuthorityFactory::createConversion(const std::string &code) const {
 
 crs::ProjectedCRSNNPtr
 AuthorityFactory::createProjectedCRS(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     auto crs = d->context()->d->getCRSFromCache(cacheKey);
     if (crs) {
@@ -5681,6 +5901,7 @@ AuthorityFactory::Private::createProjectedCRSEnd(const std::string &code,
 
 crs::CompoundCRSNNPtr
 AuthorityFactory::createCompoundCRS(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     auto res =
         d->runWithCodeParam("SELECT name, horiz_crs_auth_name, horiz_crs_code, "
                             "vertical_crs_auth_name, vertical_crs_code, "
@@ -5736,6 +5957,7 @@ crs::CRSNNPtr AuthorityFactory::createCoordinateReferenceSystem(
 crs::CRSNNPtr
 AuthorityFactory::createCoordinateReferenceSystem(const std::string &code,
                                                   bool allowCompound) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     const auto cacheKey(d->authority() + code);
     auto crs = d->context()->d->getCRSFromCache(cacheKey);
     if (crs) {
@@ -5852,6 +6074,7 @@ AuthorityFactory::createCoordinateReferenceSystem(const std::string &code,
 
 coordinates::CoordinateMetadataNNPtr
 AuthorityFactory::createCoordinateMetadata(const std::string &code) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     auto res = d->runWithCodeParam(
         "SELECT crs_auth_name, crs_code, crs_text_definition, coordinate_epoch "
         "FROM coordinate_metadata WHERE auth_name = ? AND code = ?",
@@ -5950,6 +6173,7 @@ operation::CoordinateOperationNNPtr AuthorityFactory::createCoordinateOperation(
 operation::CoordinateOperationNNPtr AuthorityFactory::createCoordinateOperation(
     const std::string &code, bool allowConcatenated,
     bool usePROJAlternativeGridNames, const std::string &typeIn) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     std::string type(typeIn);
     if (type.empty()) {
         auto res = d->runWithCodeParam(
@@ -6765,6 +6989,40 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
     bool tryReverseOrder, bool reportOnlyIntersectingTransformations,
     const metadata::ExtentPtr &intersectingExtent1,
     const metadata::ExtentPtr &intersectingExtent2) const {
+    bool hasSkippedOps = false;
+    return createFromCoordinateReferenceSystemCodes(
+        sourceCRSAuthName, sourceCRSCode, targetCRSAuthName, targetCRSCode,
+        usePROJAlternativeGridNames, discardIfMissingGrid,
+        considerKnownGridsAsAvailable, discardSuperseded, tryReverseOrder,
+        reportOnlyIntersectingTransformations, intersectingExtent1,
+        intersectingExtent2, 0.0, hasSkippedOps);
+}
+
+// ---------------------------------------------------------------------------
+
+//! @cond Doxygen_Suppress
+
+// Same as above, except that, if maxAccuracy > 0, operations whose accuracy
+// recorded in the database is worse than maxAccuracy are not instantiated.
+// hasSkippedOps is then set if at least one of them would have been returned.
+// This is not done when discardIfMissingGrid is set, as we cannot know
+// whether a skipped operation would have been discarded or not.
+std::vector<operation::CoordinateOperationNNPtr>
+AuthorityFactory::createFromCoordinateReferenceSystemCodes(
+    const std::string &sourceCRSAuthName, const std::string &sourceCRSCode,
+    const std::string &targetCRSAuthName, const std::string &targetCRSCode,
+    bool usePROJAlternativeGridNames, bool discardIfMissingGrid,
+    bool considerKnownGridsAsAvailable, bool discardSuperseded,
+    bool tryReverseOrder, bool reportOnlyIntersectingTransformations,
+    const metadata::ExtentPtr &intersectingExtent1,
+    const metadata::ExtentPtr &intersectingExtent2, double maxAccuracy,
+    bool &hasSkippedOps) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
+
+    hasSkippedOps = false;
+    if (discardIfMissingGrid) {
+        maxAccuracy = 0.0;
+    }
 
     auto cacheKey(d->authority());
     cacheKey += sourceCRSAuthName.empty() ? "{empty}" : sourceCRSAuthName;
@@ -6777,6 +7035,10 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
     cacheKey += (discardSuperseded ? '1' : '0');
     cacheKey += (tryReverseOrder ? '1' : '0');
     cacheKey += (reportOnlyIntersectingTransformations ? '1' : '0');
+    if (maxAccuracy > 0) {
+        cacheKey += "acc=";
+        cacheKey += toString(maxAccuracy);
+    }
     for (const auto &extent : {intersectingExtent1, intersectingExtent2}) {
         if (extent) {
             const auto &geogExtent = extent->geographicElements();
@@ -6796,7 +7058,8 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
 
     std::vector<operation::CoordinateOperationNNPtr> list;
 
-    if (d->context()->d->getCRSToCRSCoordOpFromCache(cacheKey, list)) {
+    if (d->context()->d->getCRSToCRSCoordOpFromCache(cacheKey, list,
+                                                     hasSkippedOps)) {
         return list;
     }
 
@@ -6838,7 +7101,7 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
                 }
                 if (ok) {
                     list.emplace_back(conv);
-                    d->context()->d->cache(cacheKey, list);
+                    d->context()->d->cache(cacheKey, list, false);
                     return list;
                 }
             }
@@ -6854,7 +7117,8 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
               "extent.east_lon, "
               "ss.replacement_auth_name, ss.replacement_code, "
               "(gt.auth_name IS NOT NULL) AS replacement_is_grid_transform, "
-              "(ga.proj_grid_name IS NOT NULL) AS replacement_is_known_grid "
+              "(ga.proj_grid_name IS NOT NULL) AS replacement_is_known_grid, "
+              "cov.accuracy "
               "FROM "
               "coordinate_operation_view cov "
               "JOIN usage ON "
@@ -6881,7 +7145,7 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
               "target_crs_auth_name, target_crs_code, "
               "cov.auth_name, cov.code, cov.table_name, "
               "extent.south_lat, extent.west_lon, extent.north_lat, "
-              "extent.east_lon "
+              "extent.east_lon, cov.accuracy "
               "FROM "
               "coordinate_operation_view cov "
               "JOIN usage ON "
@@ -7032,6 +7296,7 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
     // This is for the "projinfo -s EPSG:32631 -t EPSG:2171" use case where we
     // still want to be able to use the Pulkovo datum shift if EPSG:32631
     // coordinates are used
+    const size_t accuracyIdx = discardSuperseded ? 15 : 11;
     i = 0;
     for (const auto &row : res) {
         size_t thisI = i;
@@ -7059,6 +7324,21 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
             }
         }
 
+        if (maxAccuracy > 0) {
+            // Do not bother instantiating operations that would be
+            // rejected by the caller afterwards.
+            const auto &accuracy = row[accuracyIdx];
+            if (!accuracy.empty()) {
+                try {
+                    if (c_locale_stod(accuracy) > maxAccuracy) {
+                        hasSkippedOps = true;
+                        continue;
+                    }
+                } catch (const std::exception &) {
+                }
+            }
+        }
+
         const auto &source_crs_auth_name = row[0];
         const auto &source_crs_code = row[1];
         const auto &target_crs_auth_name = row[2];
@@ -7092,10 +7372,12 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
             }
         }
     }
-    d->context()->d->cache(cacheKey, list);
+    d->context()->d->cache(cacheKey, list, hasSkippedOps);
     return list;
 }
 
+//! @endcond
+
 // ---------------------------------------------------------------------------
 
 //! @cond Doxygen_Suppress
@@ -8742,6 +9024,7 @@ AuthorityFactory::createObjectsFromNameEx(
     const std::string &searchedName,
     const std::vector<ObjectType> &allowedObjectTypes, bool approximateMatch,
     size_t limitResultCount) const {
+    const Private::InstantiationScope instantiationScope(d->objectArena());
     std::string searchedNameWithoutDeprecated(searchedName);
     bool deprecated = false;
     if (ends_with(searchedNameWithoutDeprecated, " (deprecated)")) {
@@ -9056,22 +9339,45 @@ AuthorityFactory::createObjectsFromNameEx(
             }
         }
     } else {
-        auto sqlRes = d->run(sql, params);
+        // In approximate mode, the query does not depend on the searched
+        // name, so cache its result together with the canonicalized names.
+        DatabaseContext::Private::NameCandidatesPtr candidates;
+        if (approximateMatch) {
+            const auto cacheKey(d->hasAuthorityRestriction()
+                                    ? sql + '\n' + d->authority()
+                                    : sql);
+            auto ctxPrivate = d->context()->getPrivate();
+            candidates = ctxPrivate->getNameCandidatesFromCache(cacheKey);
+            if (!candidates) {
+                using NameCandidates = DatabaseContext::Private::NameCandidates;
+                auto newCandidates = std::make_shared<NameCandidates>();
+                newCandidates->rows = d->run(sql, params);
+                newCandidates->canonicalizedNames.reserve(
+                    newCandidates->rows.size());
+                for (const auto &row : newCandidates->rows) {
+                    newCandidates->canonicalizedNames.emplace_back(
+                        metadata::Identifier::canonicalizeName(row[3]));
+                }
+                candidates = newCandidates;
+                ctxPrivate->cache(cacheKey, candidates);
+            }
+        }
+        const auto sqlRes = candidates ? SQLResultSet() : d->run(sql, params);
         bool isFirst = true;
         bool firstIsDeprecated = false;
         bool foundExactMatch = false;
         std::size_t hashCodeFirstMatch = 0;
-        for (const auto &row : sqlRes) {
+        size_t iRow = 0;
+        for (const auto &row : candidates ? candidates->rows : sqlRes) {
             const auto &name = row[3];
+            const size_t idxRow = iRow++;
             if (approximateMatch) {
                 bool match = ci_find(name, searchedNameWithoutDeprecated) !=
                              std::string::npos;
                 if (!match) {
-                    const auto canonicalizedName(
-                        metadata::Identifier::canonicalizeName(name));
-                    match =
-                        ci_find(canonicalizedName, canonicalizedSearchedName) !=
-                        std::string::npos;
+                    match = ci_find(candidates->canonicalizedNames[idxRow],
+                                    canonicalizedSearchedName) !=
+                            std::string::npos;
                 }
                 if (!match) {
                     continue;
@@ -9150,8 +9456,7 @@ AuthorityFactory::createObjectsFromNameEx(
                 throw std::runtime_error("Unsupported table_name");
             };
             const auto obj = getObject(table_name, code);
-            if (metadata::Identifier::canonicalizeName(obj->nameStr()) ==
-                canonicalizedSearchedName) {
+            if (obj->canonicalName() == canonicalizedSearchedName) {
                 foundExactMatch = true;
             }
 
@@ -9174,8 +9479,7 @@ AuthorityFactory::createObjectsFromNameEx(
         if (foundExactMatch && hashCodeFirstMatch != 0 && !approximateMatch) {
             std::list<PairObjectName> resTmp;
             for (const auto &pair : res) {
-                if (metadata::Identifier::canonicalizeName(
-                        pair.first->nameStr()) == canonicalizedSearchedName) {
+                if (pair.first->canonicalName() == canonicalizedSearchedName) {
                     resTmp.emplace_back(pair);
                 }
             }
@@ -43,8 +43,10 @@
 #include <exception>
 #include <iomanip> // std::setprecision
 #include <locale>
+#include <mutex>
 #include <sstream> // std::istringstream and std::ostringstream
 #include <string>
+#include <unordered_map>
 
 #include "sqlite3.h"
 
@@ -86,6 +88,10 @@ inline static bool EQUALN(const char *a, const char *b, size_t size) {
  * Case-insensitive equality test
  */
 bool ci_equal(const std::string &a, const std::string &b) noexcept {
+    if (&a == &b) {
+        // Typically interned strings
+        return true;
+    }
     const auto size = a.size();
     if (size != b.size()) {
         return false;
@@ -325,6 +331,91 @@ std::vector<std::string> split(const std::string &str,
 
 // ---------------------------------------------------------------------------
 
+/** Try to format val exactly as "%.15g" would, without going through
+ * a printf-like function.
+ *
+ * This succeeds when val is the nearest double of a decimal number with at
+ * most 15 significant digits that %.15g prints in fixed notation, which is
+ * the common case for parameter values coming from the database or from
+ * user input. As DBL_DIG is 15, such a decimal number is then also what
+ * %.15g outputs, so the result is byte-identical to the slow path.
+ *
+ * @param val value to format.
+ * @param szBuffer output buffer of at least 32 bytes.
+ * @return true in case of success, false if the caller must use the regular
+ * formatting path.
+ */
+bool formatShortestDouble15(double val, char *szBuffer) {
+    static const double powersOf10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr double MAX_MANTISSA = 1e15;
+
+    const double absVal = std::fabs(val);
+    // %.15g switches to exponential notation outside of [1e-4, 1e15[
+    if (!(absVal >= 1e-4 && absVal < MAX_MANTISSA)) {
+        return false;
+    }
+
+    int nDecimals = 0;
+    double mantissa = 0;
+    for (; nDecimals < static_cast<int>(sizeof(powersOf10) /
+                                        sizeof(powersOf10[0]));
+         ++nDecimals) {
+        const double scaled = absVal * powersOf10[nDecimals];
+        if (scaled >= MAX_MANTISSA) {
+            return false;
+        }
+        mantissa = std::round(scaled);
+        // Both operands are exactly representable, so the division is
+        // correctly rounded and yields the double nearest to the decimal
+        // number.
+        if (mantissa / powersOf10[nDecimals] == absVal) {
+            break;
+        }
+    }
+    if (nDecimals == static_cast<int>(sizeof(powersOf10) /
+                                      sizeof(powersOf10[0])) ||
+        mantissa == 0) {
+        return false;
+    }
+
+    auto intMantissa = static_cast<uint64_t>(mantissa);
+    while (nDecimals > 0 && (intMantissa % 10) == 0) {
+        intMantissa /= 10;
+        --nDecimals;
+    }
+
+    char szDigits[24];
+    int nDigits = 0;
+    do {
+        szDigits[nDigits++] = static_cast<char>('0' + (intMantissa % 10));
+        intMantissa /= 10;
+    } while (intMantissa != 0);
+
+    char *ptr = szBuffer;
+    if (val < 0) {
+        *ptr++ = '-';
+    }
+    if (nDigits <= nDecimals) {
+        *ptr++ = '0';
+        *ptr++ = '.';
+        for (int i = nDigits; i < nDecimals; ++i) {
+            *ptr++ = '0';
+        }
+    }
+    for (int i = nDigits - 1; i >= 0; --i) {
+        *ptr++ = szDigits[i];
+        if (i == nDecimals && i > 0 && nDigits > nDecimals) {
+            *ptr++ = '.';
+        }
+    }
+    *ptr = '\0';
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 #ifdef _WIN32
 
 // For some reason, sqlite3_snprintf() in the sqlite3 builds used on AppVeyor
@@ -339,6 +430,13 @@ std::string toString(int val) {
 }
 
 std::string toString(double val, int precision) {
+    if (precision == 15) {
+        char szBuffer[32];
+        if (formatShortestDouble15(val, szBuffer) &&
+            !strstr(szBuffer, "9999999999")) {
+            return szBuffer;
+        }
+    }
     std::ostringstream buffer;
     buffer.imbue(std::locale::classic());
     buffer << std::setprecision(precision);
@@ -370,6 +468,10 @@ std::string toString(double val, int precision) {
     // with forcing the C locale. sqlite3_snprintf() emulates a C locale.
     constexpr int BUF_SIZE = 32;
     char szBuffer[BUF_SIZE];
+    if (precision == 15 && formatShortestDouble15(val, szBuffer) &&
+        !strstr(szBuffer, "9999999999")) {
+        return szBuffer;
+    }
     sqlite3_snprintf(BUF_SIZE, szBuffer, "%.*g", precision, val);
     if (precision == 15 && strstr(szBuffer, "9999999999")) {
         sqlite3_snprintf(BUF_SIZE, szBuffer, "%.14g", val);
@@ -407,6 +509,64 @@ double getRoundedEpochInDecimalYear(double year) {
 
 // ---------------------------------------------------------------------------
 
+namespace {
+struct InternedStrings {
+    std::mutex mutex{};
+    // The value is the interned string, wrapped in an optional so that it
+    // can also be returned by internOptional()
+    std::unordered_map<std::string, util::optional<std::string>> map{};
+};
+} // namespace
+
+// Whether an InterningScope is active in the current thread
+static thread_local bool gInterningActive = false;
+
+static const util::optional<std::string> *internImpl(const std::string &str) {
+    // Function-level static, as objects statically initialized in other
+    // translation units use it
+    static InternedStrings interned;
+    std::lock_guard<std::mutex> lock(interned.mutex);
+    auto iter = interned.map.find(str);
+    if (iter == interned.map.end()) {
+        if (!gInterningActive) {
+            return nullptr;
+        }
+        iter = interned.map.emplace(str, util::optional<std::string>(str))
+                   .first;
+    }
+    return &(iter->second);
+}
+
+// ---------------------------------------------------------------------------
+
+const std::string *intern(const std::string &str) {
+    const auto interned = internImpl(str);
+    return interned ? &(**interned) : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+
+const util::optional<std::string> *
+internOptional(const util::optional<std::string> &str) {
+    static const util::optional<std::string> none{};
+    if (!str.has_value()) {
+        return &none;
+    }
+    return internImpl(*str);
+}
+
+// ---------------------------------------------------------------------------
+
+InterningScope::InterningScope() : previous_(gInterningActive) {
+    gInterningActive = true;
+}
+
+// ---------------------------------------------------------------------------
+
+InterningScope::~InterningScope() { gInterningActive = previous_; }
+
+// ---------------------------------------------------------------------------
+
 } // namespace internal
 
 NS_PROJ_END
@@ -895,12 +895,20 @@ ExtentPtr Extent::intersection(const ExtentNNPtr &other) const {
 struct Identifier::Private {
     optional<Citation> authority_{};
     std::string code_{};
+    // Interned when possible, as there are few distinct code spaces, or
+    // nullptr, in which case the code space is stored in codeSpace_
+    const optional<std::string> *internedCodeSpace_ = internOptional({});
     optional<std::string> codeSpace_{};
     optional<std::string> version_{};
     optional<std::string> description_{};
+    // Set instead of description_ for names of operation methods and
+    // parameters, when interned
+    const optional<std::string> *internedDescription_ = nullptr;
     optional<std::string> uri_{};
 
     Private() = default;
+    Private(const Private &) = default;
+    Private &operator=(const Private &) = default;
 
     Private(const std::string &codeIn, const PropertyMap &properties)
         : code_(codeIn) {
@@ -959,6 +967,10 @@ void Identifier::Private::setProperties(
     }
 
     properties.getStringValue(CODESPACE_KEY, codeSpace_);
+    internedCodeSpace_ = internOptional(codeSpace_);
+    if (internedCodeSpace_) {
+        codeSpace_ = util::optional<std::string>();
+    }
     properties.getStringValue(VERSION_KEY, version_);
     properties.getStringValue(DESCRIPTION_KEY, description_);
     properties.getStringValue(URI_KEY, uri_);
@@ -1013,6 +1025,16 @@ Identifier::createFromDescription(const std::string &descriptionIn) {
     id->d->description_ = descriptionIn;
     return id;
 }
+
+// ---------------------------------------------------------------------------
+
+// internedDescriptionIn must have been returned by internOptional()
+IdentifierNNPtr Identifier::createFromInternedDescription(
+    const optional<std::string> &internedDescriptionIn) {
+    auto id = Identifier::nn_make_shared<Identifier>();
+    id->d->internedDescription_ = &internedDescriptionIn;
+    return id;
+}
 //! @endcond
 
 // ---------------------------------------------------------------------------
@@ -1047,7 +1069,7 @@ const std::string &Identifier::code() PROJ_PURE_DEFN { return d->code_; }
  * @return the authority codespace, or empty.
  */
 const optional<std::string> &Identifier::codeSpace() PROJ_PURE_DEFN {
-    return d->codeSpace_;
+    return d->internedCodeSpace_ ? *d->internedCodeSpace_ : d->codeSpace_;
 }
 
 // ---------------------------------------------------------------------------
@@ -1071,7 +1093,8 @@ const optional<std::string> &Identifier::version() PROJ_PURE_DEFN {
  * @return the description or empty.
  */
 const optional<std::string> &Identifier::description() PROJ_PURE_DEFN {
-    return d->description_;
+    return d->internedDescription_ ? *d->internedDescription_
+                                   : d->description_;
 }
 
 // ---------------------------------------------------------------------------
@@ -1261,12 +1284,59 @@ std::string Identifier::canonicalizeName(const std::string &str) {
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+// Returns the characters that isEquivalentName() compares when given str, so
+// that isEquivalentName(a, b) is equivalent to
+// equivalentNameKey(a) == equivalentNameKey(b). This allows the key of names
+// that are compared many times to be computed only once.
+std::string Identifier::equivalentNameKey(const std::string &str) {
+    std::string res;
+    const char *a = str.c_str();
+    size_t i = 0;
+    char lastValidA = 0;
+    while (a[i] != 0) {
+        char aCh = a[i];
+        if (aCh == ' ' && a[i + 1] == '+' && a[i + 2] == ' ' && a[i + 3] != 0) {
+            i += 3;
+            continue;
+        }
+        if (isIgnoredChar(aCh)) {
+            ++i;
+            continue;
+        }
+        if (aCh == '1' && !(lastValidA >= '0' && lastValidA <= '9') &&
+            a[i + 1] == '9' && a[i + 2] >= '0' && a[i + 2] <= '9') {
+            i += 2;
+            lastValidA = '9';
+            continue;
+        }
+        if (static_cast<unsigned char>(aCh) > 127) {
+            const auto *replacement = get_ascii_replacement(a + i);
+            if (replacement) {
+                aCh = replacement->ascii;
+                i += strlen(replacement->utf8) - 1;
+            }
+        }
+        res.push_back(static_cast<char>(::tolower(aCh)));
+        lastValidA = aCh;
+        ++i;
+    }
+    return res;
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 /** \brief Returns whether two names are considered equivalent.
  *
  * Two names are equivalent by removing any space, underscore, dash, slash,
  * { or } character from them, and comparing in a case insensitive way.
  */
 bool Identifier::isEquivalentName(const char *a, const char *b) noexcept {
+    if (a == b) {
+        // Typically interned strings
+        return true;
+    }
     size_t i = 0;
     size_t j = 0;
     char lastValidA = 0;
@@ -53,14 +53,20 @@
 #include "proj_internal.h" // M_PI
 // clang-format on
 #include "proj_constants.h"
+#include "thread_pool.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 // #define TRACE_CREATE_OPERATIONS
@@ -184,6 +190,8 @@ struct CoordinateOperationContext::Private {
         std::make_shared<util::optional<common::DataEpoch>>()};
     std::shared_ptr<util::optional<common::DataEpoch>> targetCoordinateEpoch_{
         std::make_shared<util::optional<common::DataEpoch>>()};
+    int maxThreads_ = 1;
+    size_t maxResultCount_ = 0;
 
     Private() = default;
     Private(const Private &) = default;
@@ -495,6 +503,66 @@ CoordinateOperationContext::getTargetCoordinateEpoch() const {
 
 // ---------------------------------------------------------------------------
 
+/** \brief Set the maximum number of threads that may be used to search for
+ * coordinate operations.
+ *
+ * When it is greater than 1, and that an authority factory is set, the
+ * candidate pivots of the search through the datums of the source and target
+ * CRS are explored concurrently, each thread using its own database context.
+ * Those threads and database contexts are kept by the database context of the
+ * authority factory, and reused by later searches.
+ * The result is identical to the one of the single-threaded search.
+ *
+ * @param maxThreads Maximum number of threads (default is 1). A value of 0 or
+ * less means the number of hardware threads.
+ * @since 9.5
+ */
+void CoordinateOperationContext::setMaxThreads(int maxThreads) {
+    d->maxThreads_ = maxThreads;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Return the maximum number of threads that may be used to search
+ * for coordinate operations.
+ *
+ * @since 9.5
+ */
+int CoordinateOperationContext::getMaxThreads() const {
+    return d->maxThreads_;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Set the maximum number of coordinate operations returned by
+ * CoordinateOperationFactory::createOperations().
+ *
+ * The returned operations are the first ones of the sorted list that would
+ * be returned without that limit. Setting it allows the most expensive
+ * post-processing steps to stop as soon as enough operations are retained.
+ *
+ * @param maxResultCount Maximum number of operations (default is 0, meaning
+ * no limit).
+ * @since 9.5
+ */
+void CoordinateOperationContext::setMaxResultCount(size_t maxResultCount) {
+    d->maxResultCount_ = maxResultCount;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Return the maximum number of coordinate operations returned by
+ * CoordinateOperationFactory::createOperations().
+ *
+ * @return the maximum number of operations, or 0 if there is no limit.
+ * @since 9.5
+ */
+size_t CoordinateOperationContext::getMaxResultCount() const {
+    return d->maxResultCount_;
+}
+
+// ---------------------------------------------------------------------------
+
 /** \brief Creates a context for a coordinate operation.
  *
  * If a non null authorityFactory is provided, the resulting context should
@@ -543,6 +611,18 @@ CoordinateOperationContextNNPtr CoordinateOperationContext::clone() const {
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+CoordinateOperationContextNNPtr
+CoordinateOperationContext::cloneWithAuthorityFactory(
+    const io::AuthorityFactoryPtr &authorityFactory) const {
+    auto ctxt = clone();
+    ctxt->d->authorityFactory_ = authorityFactory;
+    return ctxt;
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 //! @cond Doxygen_Suppress
 struct CoordinateOperationFactory::Private {
 
@@ -1152,8 +1232,17 @@ struct FilterResults {
         // ...
         removeSyntheticNullTransforms();
         removeUninterestingOps();
-        removeDuplicateOps();
+
+        // The last removeSyntheticNullTransforms() may only remove the last
+        // operation, so when the number of results is limited, retaining one
+        // more operation than requested is enough to get the same first ones
+        // as without limit.
+        const size_t maxResultCount = context->getMaxResultCount();
+        removeDuplicateOps(maxResultCount ? maxResultCount + 1 : 0);
         removeSyntheticNullTransforms();
+        if (maxResultCount && res.size() > maxResultCount) {
+            res.erase(res.begin() + maxResultCount, res.end());
+        }
         return *this;
     }
 
@@ -1578,7 +1667,7 @@ struct FilterResults {
     // ----------------------------------------------------------------------
 
     // cppcheck-suppress functionStatic
-    void removeDuplicateOps() {
+    void removeDuplicateOps(size_t maxRetained) {
 
         if (res.size() <= 1) {
             return;
@@ -1594,6 +1683,11 @@ struct FilterResults {
         std::set<std::string> setPROJPlusExtent;
         std::vector<CoordinateOperationNNPtr> resTemp;
         for (const auto &op : res) {
+            // Operations after the maxRetained-th retained one are not
+            // returned, so avoid exporting them to PROJ strings.
+            if (maxRetained && resTemp.size() == maxRetained) {
+                break;
+            }
             auto formatter = io::PROJStringFormatter::create();
             try {
                 std::string key(op->exportToPROJString(formatter.get()));
@@ -1800,6 +1894,22 @@ getCandidateAuthorities(const io::AuthorityFactoryPtr &authFactory,
 
 // ---------------------------------------------------------------------------
 
+// Return the accuracy beyond which operations of the registry do not need
+// to be instantiated, because FilterResults would reject them anyway.
+// When the area of interest has a description, all candidates must be
+// considered to find one whose extent has the same description.
+static double
+getRegistryMaxAccuracy(const CoordinateOperationContextNNPtr &context) {
+    const auto &areaOfInterest = context->getAreaOfInterest();
+    if (areaOfInterest && areaOfInterest->description().has_value()) {
+        return 0.0;
+    }
+    const double desiredAccuracy = context->getDesiredAccuracy();
+    return desiredAccuracy > 0 ? desiredAccuracy : 0.0;
+}
+
+// ---------------------------------------------------------------------------
+
 // Look in the authority registry for operations from sourceCRS to targetCRS
 std::vector<CoordinateOperationNNPtr>
 CoordinateOperationFactory::Private::findOpsInRegistryDirect(
@@ -1820,6 +1930,7 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirect(
     buildCRSIds(targetCRS, context, targetIds);
 
     const auto gridAvailabilityUse = context.context->getGridAvailabilityUse();
+    const double maxAccuracy = getRegistryMaxAccuracy(context.context);
     for (const auto &idSrc : sourceIds) {
         const auto &srcAuthName = idSrc.first;
         const auto &srcCode = idSrc.second;
@@ -1830,11 +1941,13 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirect(
             const auto authorities(getCandidateAuthorities(
                 authFactory, srcAuthName, targetAuthName));
             std::vector<CoordinateOperationNNPtr> res;
+            bool hasSkippedOps = false;
             for (const auto &authority : authorities) {
                 const auto authName =
                     authority == "any" ? std::string() : authority;
                 const auto tmpAuthFactory = io::AuthorityFactory::create(
                     authFactory->databaseContext(), authName);
+                bool hasSkippedOpsTmp = false;
                 auto resTmp =
                     tmpAuthFactory->createFromCoordinateReferenceSystemCodes(
                         srcAuthName, srcCode, targetAuthName, targetCode,
@@ -1850,15 +1963,19 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirect(
                             CoordinateOperationContext::GridAvailabilityUse::
                                 KNOWN_AVAILABLE,
                         context.context->getDiscardSuperseded(), true, false,
-                        context.extent1, context.extent2);
+                        context.extent1, context.extent2, maxAccuracy,
+                        hasSkippedOpsTmp);
                 res.insert(res.end(), resTmp.begin(), resTmp.end());
+                hasSkippedOps |= hasSkippedOpsTmp;
                 if (authName == "PROJ") {
                     // Do not stop at the first transformations available in
                     // the PROJ namespace, but allow the next authority to
                     // continue
                     continue;
                 }
-                if (!res.empty()) {
+                // Operations skipped because of their accuracy would have
+                // been filtered out, but they still end the search.
+                if (!res.empty() || hasSkippedOps) {
                     resNonEmptyBeforeFiltering = true;
                     auto resFiltered =
                         FilterResults(res, context.context, context.extent1,
@@ -1895,6 +2012,7 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirectTo(
     buildCRSIds(targetCRS, context, ids);
 
     const auto gridAvailabilityUse = context.context->getGridAvailabilityUse();
+    const double maxAccuracy = getRegistryMaxAccuracy(context.context);
     for (const auto &id : ids) {
         const auto &targetAuthName = id.first;
         const auto &targetCode = id.second;
@@ -1902,11 +2020,13 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirectTo(
         const auto authorities(getCandidateAuthorities(
             authFactory, targetAuthName, targetAuthName));
         std::vector<CoordinateOperationNNPtr> res;
+        bool hasSkippedOps = false;
         for (const auto &authority : authorities) {
             const auto authName =
                 authority == "any" ? std::string() : authority;
             const auto tmpAuthFactory = io::AuthorityFactory::create(
                 authFactory->databaseContext(), authName);
+            bool hasSkippedOpsTmp = false;
             auto resTmp =
                 tmpAuthFactory->createFromCoordinateReferenceSystemCodes(
                     std::string(), std::string(), targetAuthName, targetCode,
@@ -1922,14 +2042,16 @@ CoordinateOperationFactory::Private::findOpsInRegistryDirectTo(
                         CoordinateOperationContext::GridAvailabilityUse::
                             KNOWN_AVAILABLE,
                     context.context->getDiscardSuperseded(), true, true,
-                    context.extent1, context.extent2);
+                    context.extent1, context.extent2, maxAccuracy,
+                    hasSkippedOpsTmp);
             res.insert(res.end(), resTmp.begin(), resTmp.end());
+            hasSkippedOps |= hasSkippedOpsTmp;
             if (authName == "PROJ") {
                 // Do not stop at the first transformations available in
                 // the PROJ namespace, but allow the next authority to continue
                 continue;
             }
-            if (!res.empty()) {
+            if (!res.empty() || hasSkippedOps) {
                 auto resFiltered =
                     FilterResults(res, context.context, context.extent1,
                                   context.extent2, false)
@@ -3079,11 +3201,16 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
         geodSrc->coordinateSystem()->axisList().size() == 3 &&
         geodDst->coordinateSystem()->axisList().size() == 3;
 
-    auto createTransformations = [&](const crs::CRSNNPtr &candidateSrcGeod,
+    auto createTransformations = [&](Context &stepContext,
+                                     std::vector<CoordinateOperationNNPtr>
+                                         &stepRes,
+                                     const crs::CRSNNPtr &candidateSrcGeod,
                                      const crs::CRSNNPtr &candidateDstGeod,
                                      const CoordinateOperationNNPtr &opFirst,
                                      bool isNullFirst,
                                      bool useOnlyDirectRegistryOp) {
+        const auto &stepDbContext =
+            stepContext.context->getAuthorityFactory()->databaseContext();
         bool resNonEmptyBeforeFiltering;
 
         // Deal with potential epoch change
@@ -3093,19 +3220,19 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
             !sourceEpoch->coordinateEpoch()._isEquivalentTo(
                 targetEpoch->coordinateEpoch())) {
             const auto pmoSrc =
-                context.context->getAuthorityFactory()
+                stepContext.context->getAuthorityFactory()
                     ->getPointMotionOperationsFor(
                         NN_NO_CHECK(
                             util::nn_dynamic_pointer_cast<crs::GeodeticCRS>(
                                 candidateSrcGeod)),
                         true);
             if (!pmoSrc.empty()) {
-                opsEpochChangeSrc =
-                    createOperations(candidateSrcGeod, sourceEpoch,
-                                     candidateSrcGeod, targetEpoch, context);
+                opsEpochChangeSrc = createOperations(
+                    candidateSrcGeod, sourceEpoch, candidateSrcGeod,
+                    targetEpoch, stepContext);
             } else {
                 const auto pmoDst =
-                    context.context->getAuthorityFactory()
+                    stepContext.context->getAuthorityFactory()
                         ->getPointMotionOperationsFor(
                             NN_NO_CHECK(
                                 util::nn_dynamic_pointer_cast<crs::GeodeticCRS>(
@@ -3114,7 +3241,7 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
                 if (!pmoDst.empty()) {
                     opsEpochChangeDst = createOperations(
                         candidateDstGeod, sourceEpoch, candidateDstGeod,
-                        targetEpoch, context);
+                        targetEpoch, stepContext);
                 }
             }
         }
@@ -3122,14 +3249,15 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
         const std::vector<CoordinateOperationNNPtr> opsSecond(
             useOnlyDirectRegistryOp
                 ? findOpsInRegistryDirect(candidateSrcGeod, candidateDstGeod,
-                                          context, resNonEmptyBeforeFiltering)
+                                          stepContext,
+                                          resNonEmptyBeforeFiltering)
                 : createOperations(candidateSrcGeod, targetEpoch,
-                                   candidateDstGeod, targetEpoch, context));
+                                   candidateDstGeod, targetEpoch, stepContext));
         const auto opsThird = createOperations(
             sourceAndTargetAre3D
-                ? candidateDstGeod->promoteTo3D(std::string(), dbContext)
+                ? candidateDstGeod->promoteTo3D(std::string(), stepDbContext)
                 : candidateDstGeod,
-            targetEpoch, targetCRS, targetEpoch, context);
+            targetEpoch, targetCRS, targetEpoch, stepContext);
         assert(!opsThird.empty());
         const CoordinateOperationNNPtr &opThird(opsThird[0]);
 
@@ -3195,9 +3323,9 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
                             auto newStep = step->shallowClone();
                             setCRSs(newStep.get(),
                                     newStep->sourceCRS()->promoteTo3D(
-                                        std::string(), dbContext),
+                                        std::string(), stepDbContext),
                                     newStep->targetCRS()->promoteTo3D(
-                                        std::string(), dbContext));
+                                        std::string(), stepDbContext));
                             newSteps.emplace_back(newStep);
                         }
                         opSecondCloned =
@@ -3206,9 +3334,9 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
                     } else {
                         setCRSs(opSecondCloned.get(),
                                 opSecondCloned->sourceCRS()->promoteTo3D(
-                                    std::string(), dbContext),
+                                    std::string(), stepDbContext),
                                 opSecondCloned->targetCRS()->promoteTo3D(
-                                    std::string(), dbContext));
+                                    std::string(), stepDbContext));
                     }
                 }
                 if (!isNullFirst) {
@@ -3250,7 +3378,7 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
                 logTrace("transformation " + debugStr);
 #endif
                 try {
-                    res.emplace_back(
+                    stepRes.emplace_back(
                         ConcatenatedOperation::createComputeMetadata(
                             subOps, disallowEmptyIntersection));
                 } catch (const InvalidOperationEmptyIntersection &) {
@@ -3312,16 +3440,22 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
         return 2;
     };
 
+    // Enumerate the (candidate source geodetic CRS, candidate target
+    // geodetic CRS) pairs in the order in which they must be tried.
+    struct Step {
+        const crs::GeodeticCRSNNPtr *candidateSrcGeod;
+        size_t idxSrc;
+        const crs::GeodeticCRSNNPtr *candidateDstGeod;
+        bool useOnlyDirectRegistryOp;
+    };
+    std::vector<Step> steps;
     for (int iter = 0; iter < nIters; ++iter) {
         const bool useOnlyDirectRegistryOp = (iter == 0 && nIters == 3);
+        size_t idxSrc = 0;
         for (const auto &candidateSrcGeod : candidatesSrcGeod) {
             if (candidateSrcGeod->nameStr() == sourceCRS->nameStr()) {
                 const auto typeSource =
                     (iter >= 1) ? getType(candidateSrcGeod) : -1;
-                auto sourceSrcGeodModified(sourceAndTargetAre3D
-                                               ? candidateSrcGeod->promoteTo3D(
-                                                     std::string(), dbContext)
-                                               : candidateSrcGeod);
                 for (const auto &candidateDstGeod : candidatesDstGeod) {
                     if (candidateDstGeod->nameStr() == targetCRS->nameStr()) {
                         if (iter == 1) {
@@ -3333,69 +3467,234 @@ void CoordinateOperationFactory::Private::createOperationsWithDatumPivot(
                                 continue;
                             }
                         }
-#ifdef TRACE_CREATE_OPERATIONS
-                        ENTER_BLOCK("iter=" + toString(iter) + ", try " +
-                                    objectAsStr(sourceCRS.get()) + "->" +
-                                    objectAsStr(candidateSrcGeod.get()) + "->" +
-                                    objectAsStr(candidateDstGeod.get()) + "->" +
-                                    objectAsStr(targetCRS.get()) + ")");
-#endif
-                        const auto opsFirst = createOperations(
-                            sourceCRS, sourceEpoch, sourceSrcGeodModified,
-                            sourceEpoch, context);
-                        assert(!opsFirst.empty());
-                        const bool isNullFirst =
-                            isNullTransformation(opsFirst[0]->nameStr());
-                        createTransformations(
-                            candidateSrcGeod, candidateDstGeod, opsFirst[0],
-                            isNullFirst, useOnlyDirectRegistryOp);
-                        if (!res.empty()) {
-                            if (hasResultSetOnlyResultsWithPROJStep(res)) {
-                                continue;
-                            }
-                            return;
-                        }
+                        steps.push_back(Step{&candidateSrcGeod, idxSrc,
+                                             &candidateDstGeod,
+                                             useOnlyDirectRegistryOp});
                     }
                 }
             }
+            ++idxSrc;
         }
 
+        idxSrc = 0;
         for (const auto &candidateSrcGeod : candidatesSrcGeod) {
             const bool bSameSrcName =
                 candidateSrcGeod->nameStr() == sourceCRS->nameStr();
+            for (const auto &candidateDstGeod : candidatesDstGeod) {
+                if (bSameSrcName &&
+                    candidateDstGeod->nameStr() == targetCRS->nameStr()) {
+                    continue;
+                }
+                steps.push_back(Step{&candidateSrcGeod, idxSrc,
+                                     &candidateDstGeod,
+                                     useOnlyDirectRegistryOp});
+            }
+            ++idxSrc;
+        }
+    }
+
+    // Operations from sourceCRS to each candidate source geodetic CRS. They
+    // only depend on the candidate, so they are computed once per thread.
+    using OpsFirstCache = std::vector<std::vector<CoordinateOperationNNPtr>>;
+
+    const auto runStep = [&](const Step &step, Context &stepContext,
+                             OpsFirstCache &opsFirstCache,
+                             std::vector<CoordinateOperationNNPtr> &stepRes) {
+        const auto &candidateSrcGeod = *(step.candidateSrcGeod);
+        const auto &candidateDstGeod = *(step.candidateDstGeod);
 #ifdef TRACE_CREATE_OPERATIONS
-            ENTER_BLOCK("");
+        ENTER_BLOCK("try " + objectAsStr(sourceCRS.get()) + "->" +
+                    objectAsStr(candidateSrcGeod.get()) + "->" +
+                    objectAsStr(candidateDstGeod.get()) + "->" +
+                    objectAsStr(targetCRS.get()) + ")");
 #endif
+        auto &opsFirst = opsFirstCache[step.idxSrc];
+        if (opsFirst.empty()) {
+            const auto &stepDbContext =
+                stepContext.context->getAuthorityFactory()->databaseContext();
             auto sourceSrcGeodModified(
                 sourceAndTargetAre3D
-                    ? candidateSrcGeod->promoteTo3D(std::string(), dbContext)
+                    ? candidateSrcGeod->promoteTo3D(std::string(),
+                                                    stepDbContext)
                     : candidateSrcGeod);
-            const auto opsFirst =
+            opsFirst =
                 createOperations(sourceCRS, sourceEpoch, sourceSrcGeodModified,
-                                 sourceEpoch, context);
+                                 sourceEpoch, stepContext);
             assert(!opsFirst.empty());
-            const bool isNullFirst =
-                isNullTransformation(opsFirst[0]->nameStr());
+        }
+        const bool isNullFirst = isNullTransformation(opsFirst[0]->nameStr());
+        createTransformations(stepContext, stepRes, candidateSrcGeod,
+                              candidateDstGeod, opsFirst[0], isNullFirst,
+                              step.useOnlyDirectRegistryOp);
+    };
 
-            for (const auto &candidateDstGeod : candidatesDstGeod) {
-                if (bSameSrcName &&
-                    candidateDstGeod->nameStr() == targetCRS->nameStr()) {
-                    continue;
+    // We stop at the first step after which we have results not only made
+    // of PROJ-synthetized steps.
+    const auto isResultFinal = [&res]() {
+        return !res.empty() && !hasResultSetOnlyResultsWithPROJStep(res);
+    };
+
+    OpsFirstCache opsFirstCache(candidatesSrcGeod.size());
+
+    size_t nThreads = 1;
+    if (steps.size() > 1) {
+        const int maxThreads = context.context->getMaxThreads();
+        nThreads = std::min(
+            steps.size(),
+            maxThreads > 0
+                ? static_cast<size_t>(maxThreads)
+                : std::max<size_t>(1, std::thread::hardware_concurrency()));
+    }
+
+    // Resources used by a thread of the pool of the database context, other
+    // than the calling one, to explore steps: DatabaseContext,
+    // AuthorityFactory and PJ_CONTEXT objects must not be used by several
+    // threads at once. The database context is given back at the end of the
+    // call, so that later calls reuse it.
+    struct Worker {
+        io::DatabaseContextNNPtr parentDbContext;
+        io::DatabaseContextNNPtr dbContext;
+        CoordinateOperationContextNNPtr opContext;
+        Context context;
+        OpsFirstCache opsFirstCache;
+
+        Worker(const io::DatabaseContextNNPtr &parentDbContextIn,
+               io::DatabaseContextNNPtr &&dbContextIn,
+               CoordinateOperationContextNNPtr &&opContextIn,
+               const Context &parentContext, size_t nCandidatesSrc)
+            : parentDbContext(parentDbContextIn),
+              dbContext(std::move(dbContextIn)),
+              opContext(std::move(opContextIn)),
+              context(parentContext.extent1, parentContext.extent2,
+                      opContext),
+              opsFirstCache(nCandidatesSrc) {
+            context.inCreateOperationsWithDatumPivotAntiRecursion = true;
+            context.inCreateOperationsGeogToVertWithAlternativeGeog =
+                parentContext.inCreateOperationsGeogToVertWithAlternativeGeog;
+            context.inCreateOperationsGeogToVertWithIntermediateVert =
+                parentContext.inCreateOperationsGeogToVertWithIntermediateVert;
+            context.skipHorizontalTransformation =
+                parentContext.skipHorizontalTransformation;
+            context.nRecLevelCreateOperations =
+                parentContext.nRecLevelCreateOperations;
+            context.geogCRSOfVertCRSStack = parentContext.geogCRSOfVertCRSStack;
+        }
+
+        ~Worker() {
+            try {
+                parentDbContext->releaseForOtherThread(dbContext);
+            } catch (const std::exception &) {
+            }
+        }
+
+        Worker(const Worker &) = delete;
+        Worker &operator=(const Worker &) = delete;
+    };
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t i = 1; i < nThreads; ++i) {
+        auto workerDbContext = dbContext->acquireForOtherThread();
+        if (!workerDbContext) {
+            break;
+        }
+        auto opContext = context.context->cloneWithAuthorityFactory(
+            io::AuthorityFactory::create(NN_NO_CHECK(workerDbContext),
+                                         authFactory->getAuthority())
+                .as_nullable());
+        workers.emplace_back(internal::make_unique<Worker>(
+            dbContext, NN_NO_CHECK(std::move(workerDbContext)),
+            std::move(opContext), context, candidatesSrcGeod.size()));
+    }
+    projThreadPool *threadPool =
+        workers.empty() ? nullptr : dbContext->getThreadPool(workers.size());
+    nThreads = threadPool ? workers.size() + 1 : 1;
+
+    if (nThreads == 1) {
+        for (const auto &step : steps) {
+            runStep(step, context, opsFirstCache, res);
+            if (isResultFinal()) {
+                return;
+            }
+        }
+        return;
+    }
+
+    // State of a wave shared with its tasks. A task may only start once the
+    // calling thread has explored all the steps of the wave by itself: it
+    // must then return without touching anything else.
+    struct WaveState {
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        bool closed = false;
+        size_t nRunningTasks = 0;
+    };
+
+    // Explore the steps by waves of nThreads steps, and merge the results of
+    // each wave in the order of the steps, so as to get the same result as
+    // the above sequential exploration.
+    for (size_t firstStep = 0; firstStep < steps.size();
+         firstStep += nThreads) {
+        const size_t nStepsInWave =
+            std::min(nThreads, steps.size() - firstStep);
+        std::vector<std::vector<CoordinateOperationNNPtr>> stepsRes(
+            nStepsInWave);
+        std::vector<std::exception_ptr> stepsException(nStepsInWave);
+        std::atomic<size_t> nextStep{0};
+        const auto explore = [&](Context &threadContext,
+                                 OpsFirstCache &threadOpsFirstCache) {
+            while (true) {
+                const size_t i = nextStep++;
+                if (i >= nStepsInWave)
+                    break;
+                try {
+                    runStep(steps[firstStep + i], threadContext,
+                            threadOpsFirstCache, stepsRes[i]);
+                } catch (...) {
+                    stepsException[i] = std::current_exception();
                 }
+            }
+        };
 
-#ifdef TRACE_CREATE_OPERATIONS
-                ENTER_BLOCK("try " + objectAsStr(sourceCRS.get()) + "->" +
-                            objectAsStr(candidateSrcGeod.get()) + "->" +
-                            objectAsStr(candidateDstGeod.get()) + "->" +
-                            objectAsStr(targetCRS.get()) + ")");
-#endif
-                createTransformations(candidateSrcGeod, candidateDstGeod,
-                                      opsFirst[0], isNullFirst,
-                                      useOnlyDirectRegistryOp);
-                if (!res.empty() && !hasResultSetOnlyResultsWithPROJStep(res)) {
-                    return;
+        const auto waveState = std::make_shared<WaveState>();
+        try {
+            for (size_t i = 1; i < nStepsInWave; ++i) {
+                Worker *worker = workers[i - 1].get();
+                if (!threadPool->submit([waveState, worker, &explore]() {
+                        {
+                            std::lock_guard<std::mutex> lock(waveState->mutex);
+                            if (waveState->closed)
+                                return;
+                            ++waveState->nRunningTasks;
+                        }
+                        explore(worker->context, worker->opsFirstCache);
+                        {
+                            std::lock_guard<std::mutex> lock(waveState->mutex);
+                            --waveState->nRunningTasks;
+                        }
+                        waveState->cv.notify_all();
+                    })) {
+                    break;
                 }
             }
+        } catch (const std::exception &) {
+            // Go on with the tasks that could be submitted
+        }
+        explore(context, opsFirstCache);
+        {
+            std::unique_lock<std::mutex> lock(waveState->mutex);
+            waveState->closed = true;
+            pj_cv_wait(waveState->cv, lock, [&waveState] {
+                return waveState->nRunningTasks == 0;
+            });
+        }
+
+        for (size_t i = 0; i < nStepsInWave; ++i) {
+            if (stepsException[i]) {
+                std::rethrow_exception(stepsException[i]);
+            }
+            res.insert(res.end(), stepsRes[i].begin(), stepsRes[i].end());
+            if (isResultFinal()) {
+                return;
+            }
         }
     }
 }
@@ -71,6 +71,8 @@ const char *BALLPARK_VERTICAL_TRANSFORMATION_NO_ELLIPSOID_VERT_HEIGHT =
 OperationParameterNNPtr createOpParamNameEPSGCode(int code) {
     const char *name = OperationParameter::getNameForEPSGCode(code);
     assert(name);
+    // Built-in name, which can thus be interned
+    const internal::InterningScope interningScope;
     return OperationParameter::create(createMapNameEPSGCode(name, code));
 }
 
@@ -593,6 +593,7 @@ OperationMethodNNPtr OperationMethod::create(
         OperationMethod::nn_make_shared<OperationMethod>());
     method->assignSelf(method);
     method->setProperties(properties);
+    method->internName();
     method->d->parameters_ = parameters;
     properties.getStringValue("proj_method", method->d->projMethodOverride_);
     return method;
@@ -1077,6 +1078,7 @@ OperationParameter::create(const util::PropertyMap &properties) {
         OperationParameter::nn_make_shared<OperationParameter>());
     op->assignSelf(op);
     op->setProperties(properties);
+    op->internName();
     return op;
 }
 
@@ -41,6 +41,7 @@
 
 #include "operation/oputils.hpp"
 #include "proj/internal/coordinatesystem_internal.hpp"
+#include "proj/internal/internal.hpp"
 #include "proj/internal/io_internal.hpp"
 
 #include <map>
@@ -311,86 +312,93 @@ DEFINE_WKT_CONSTANT(PARAMETRICDATUM);
 
 namespace common {
 
+// Built-in units, whose name and code space are interned
+static UnitOfMeasure builtinUnit(const std::string &name, double toSI,
+                                 UnitOfMeasure::Type type,
+                                 const std::string &codeSpace = std::string(),
+                                 const std::string &code = std::string()) {
+    const internal::InterningScope interningScope;
+    return UnitOfMeasure(name, toSI, type, codeSpace, code);
+}
+
 /** \brief "Empty"/"None", unit of measure of type NONE. */
-const UnitOfMeasure UnitOfMeasure::NONE("", 1.0, UnitOfMeasure::Type::NONE);
+const UnitOfMeasure UnitOfMeasure::NONE =
+    builtinUnit("", 1.0, UnitOfMeasure::Type::NONE);
 
 /** \brief Scale unity, unit of measure of type SCALE. */
-const UnitOfMeasure UnitOfMeasure::SCALE_UNITY("unity", 1.0,
-                                               UnitOfMeasure::Type::SCALE,
-                                               Identifier::EPSG, "9201");
+const UnitOfMeasure UnitOfMeasure::SCALE_UNITY =
+    builtinUnit("unity", 1.0, UnitOfMeasure::Type::SCALE, Identifier::EPSG,
+                "9201");
 
 /** \brief Parts-per-million, unit of measure of type SCALE. */
-const UnitOfMeasure UnitOfMeasure::PARTS_PER_MILLION("parts per million", 1e-6,
-                                                     UnitOfMeasure::Type::SCALE,
-                                                     Identifier::EPSG, "9202");
+const UnitOfMeasure UnitOfMeasure::PARTS_PER_MILLION =
+    builtinUnit("parts per million", 1e-6, UnitOfMeasure::Type::SCALE,
+                Identifier::EPSG, "9202");
 
 /** \brief Metre, unit of measure of type LINEAR (SI unit). */
-const UnitOfMeasure UnitOfMeasure::METRE("metre", 1.0,
-                                         UnitOfMeasure::Type::LINEAR,
-                                         Identifier::EPSG, "9001");
+const UnitOfMeasure UnitOfMeasure::METRE =
+    builtinUnit("metre", 1.0, UnitOfMeasure::Type::LINEAR, Identifier::EPSG,
+                "9001");
 
 /** \brief Foot, unit of measure of type LINEAR. */
-const UnitOfMeasure UnitOfMeasure::FOOT("foot", 0.3048,
-                                        UnitOfMeasure::Type::LINEAR,
-                                        Identifier::EPSG, "9002");
+const UnitOfMeasure UnitOfMeasure::FOOT =
+    builtinUnit("foot", 0.3048, UnitOfMeasure::Type::LINEAR, Identifier::EPSG,
+                "9002");
 
 /** \brief US survey foot, unit of measure of type LINEAR. */
-const UnitOfMeasure UnitOfMeasure::US_FOOT("US survey foot",
-                                           0.304800609601219241184,
-                                           UnitOfMeasure::Type::LINEAR,
-                                           Identifier::EPSG, "9003");
+const UnitOfMeasure UnitOfMeasure::US_FOOT =
+    builtinUnit("US survey foot", 0.304800609601219241184,
+                UnitOfMeasure::Type::LINEAR, Identifier::EPSG, "9003");
 
 /** \brief Degree, unit of measure of type ANGULAR. */
-const UnitOfMeasure UnitOfMeasure::DEGREE("degree", M_PI / 180.,
-                                          UnitOfMeasure::Type::ANGULAR,
-                                          Identifier::EPSG, "9122");
+const UnitOfMeasure UnitOfMeasure::DEGREE =
+    builtinUnit("degree", M_PI / 180., UnitOfMeasure::Type::ANGULAR,
+                Identifier::EPSG, "9122");
 
 /** \brief Arc-second, unit of measure of type ANGULAR. */
-const UnitOfMeasure UnitOfMeasure::ARC_SECOND("arc-second", M_PI / 180. / 3600.,
-                                              UnitOfMeasure::Type::ANGULAR,
-                                              Identifier::EPSG, "9104");
+const UnitOfMeasure UnitOfMeasure::ARC_SECOND =
+    builtinUnit("arc-second", M_PI / 180. / 3600., UnitOfMeasure::Type::ANGULAR,
+                Identifier::EPSG, "9104");
 
 /** \brief Grad, unit of measure of type ANGULAR. */
-const UnitOfMeasure UnitOfMeasure::GRAD("grad", M_PI / 200.,
-                                        UnitOfMeasure::Type::ANGULAR,
-                                        Identifier::EPSG, "9105");
+const UnitOfMeasure UnitOfMeasure::GRAD =
+    builtinUnit("grad", M_PI / 200., UnitOfMeasure::Type::ANGULAR,
+                Identifier::EPSG, "9105");
 
 /** \brief Radian, unit of measure of type ANGULAR (SI unit). */
-const UnitOfMeasure UnitOfMeasure::RADIAN("radian", 1.0,
-                                          UnitOfMeasure::Type::ANGULAR,
-                                          Identifier::EPSG, "9101");
+const UnitOfMeasure UnitOfMeasure::RADIAN =
+    builtinUnit("radian", 1.0, UnitOfMeasure::Type::ANGULAR, Identifier::EPSG,
+                "9101");
 
 /** \brief Microradian, unit of measure of type ANGULAR. */
-const UnitOfMeasure UnitOfMeasure::MICRORADIAN("microradian", 1e-6,
-                                               UnitOfMeasure::Type::ANGULAR,
-                                               Identifier::EPSG, "9109");
+const UnitOfMeasure UnitOfMeasure::MICRORADIAN =
+    builtinUnit("microradian", 1e-6, UnitOfMeasure::Type::ANGULAR,
+                Identifier::EPSG, "9109");
 
 /** \brief Second, unit of measure of type TIME (SI unit). */
-const UnitOfMeasure UnitOfMeasure::SECOND("second", 1.0,
-                                          UnitOfMeasure::Type::TIME,
-                                          Identifier::EPSG, "1040");
+const UnitOfMeasure UnitOfMeasure::SECOND =
+    builtinUnit("second", 1.0, UnitOfMeasure::Type::TIME, Identifier::EPSG,
+                "1040");
 
 /** \brief Year, unit of measure of type TIME */
-const UnitOfMeasure UnitOfMeasure::YEAR("year", 31556925.445,
-                                        UnitOfMeasure::Type::TIME,
-                                        Identifier::EPSG, "1029");
+const UnitOfMeasure UnitOfMeasure::YEAR =
+    builtinUnit("year", 31556925.445, UnitOfMeasure::Type::TIME,
+                Identifier::EPSG, "1029");
 
 /** \brief Metre per year, unit of measure of type LINEAR. */
-const UnitOfMeasure UnitOfMeasure::METRE_PER_YEAR("metres per year",
-                                                  1.0 / 31556925.445,
-                                                  UnitOfMeasure::Type::LINEAR,
-                                                  Identifier::EPSG, "1042");
+const UnitOfMeasure UnitOfMeasure::METRE_PER_YEAR =
+    builtinUnit("metres per year", 1.0 / 31556925.445,
+                UnitOfMeasure::Type::LINEAR, Identifier::EPSG, "1042");
 
 /** \brief Arc-second per year, unit of measure of type ANGULAR. */
-const UnitOfMeasure UnitOfMeasure::ARC_SECOND_PER_YEAR(
-    "arc-seconds per year", M_PI / 180. / 3600. / 31556925.445,
-    UnitOfMeasure::Type::ANGULAR, Identifier::EPSG, "1043");
+const UnitOfMeasure UnitOfMeasure::ARC_SECOND_PER_YEAR =
+    builtinUnit("arc-seconds per year", M_PI / 180. / 3600. / 31556925.445,
+                UnitOfMeasure::Type::ANGULAR, Identifier::EPSG, "1043");
 
 /** \brief Parts-per-million per year, unit of measure of type SCALE. */
-const UnitOfMeasure UnitOfMeasure::PPM_PER_YEAR("parts per million per year",
-                                                1e-6 / 31556925.445,
-                                                UnitOfMeasure::Type::SCALE,
-                                                Identifier::EPSG, "1036");
+const UnitOfMeasure UnitOfMeasure::PPM_PER_YEAR =
+    builtinUnit("parts per million per year", 1e-6 / 31556925.445,
+                UnitOfMeasure::Type::SCALE, Identifier::EPSG, "1036");
 
 } // namespace common
 
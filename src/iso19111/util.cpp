@@ -38,6 +38,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace NS_PROJ::internal;
 
@@ -710,5 +711,93 @@ bool IComparable::isEquivalentTo(
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+struct ObjectArena::Private {
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    // Size beyond which the arena is full(), so that a few chunks of memory
+    // are kept alive by a long-lived object
+    static constexpr size_t MAX_SIZE = 16 * CHUNK_SIZE;
+
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_{};
+    unsigned char *current_ = nullptr;
+    size_t remaining_ = 0;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+};
+
+// Arena in which objects are allocated by the current thread
+static thread_local const ObjectArenaPtr *gActiveObjectArena = nullptr;
+
+// ---------------------------------------------------------------------------
+
+ObjectArena::ObjectArena() : d(internal::make_unique<Private>()) {}
+
+// ---------------------------------------------------------------------------
+
+ObjectArena::~ObjectArena() = default;
+
+// ---------------------------------------------------------------------------
+
+void *ObjectArena::allocate(size_t size) {
+    // Chunks come from new[], and are thus suitably aligned for any
+    // fundamental type. Keep that property for each allocation.
+    constexpr size_t alignment = alignof(std::max_align_t);
+    size = (size + alignment - 1) & ~(alignment - 1);
+    if (size > d->remaining_) {
+        if (size > Private::CHUNK_SIZE / 4) {
+            // Big allocations get their own chunk, so as not to waste the
+            // end of the current one
+            d->chunks_.emplace_back(new unsigned char[size]);
+            d->used_ += size;
+            d->reserved_ += size;
+            return d->chunks_.back().get();
+        }
+        d->chunks_.emplace_back(new unsigned char[Private::CHUNK_SIZE]);
+        d->current_ = d->chunks_.back().get();
+        d->remaining_ = Private::CHUNK_SIZE;
+        d->reserved_ += Private::CHUNK_SIZE;
+    }
+    void *ptr = d->current_;
+    d->current_ += size;
+    d->remaining_ -= size;
+    d->used_ += size;
+    return ptr;
+}
+
+// ---------------------------------------------------------------------------
+
+size_t ObjectArena::usedSize() const noexcept { return d->used_; }
+
+// ---------------------------------------------------------------------------
+
+size_t ObjectArena::reservedSize() const noexcept { return d->reserved_; }
+
+// ---------------------------------------------------------------------------
+
+bool ObjectArena::full() const noexcept {
+    return d->reserved_ >= Private::MAX_SIZE;
+}
+
+// ---------------------------------------------------------------------------
+
+const ObjectArenaPtr &ObjectArena::active() noexcept {
+    static const ObjectArenaPtr none{};
+    return gActiveObjectArena ? *gActiveObjectArena : none;
+}
+
+// ---------------------------------------------------------------------------
+
+ObjectArena::Scope::Scope(const ObjectArenaPtr &arena)
+    : arena_(arena), previous_(gActiveObjectArena) {
+    gActiveObjectArena = &arena_;
+}
+
+// ---------------------------------------------------------------------------
+
+ObjectArena::Scope::~Scope() { gActiveObjectArena = previous_; }
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 } // namespace util
 NS_PROJ_END
@@ -210,6 +210,7 @@ set(SRC_LIBPROJ_CORE
   gauss.cpp
   generic_inverse.cpp
   geodesic.c
+  geod_batch.cpp
   init.cpp
   initcache.cpp
   internal.cpp
@@ -255,6 +256,8 @@ set(SRC_LIBPROJ_CORE
   networkfilemanager.cpp
   sqlite3_utils.hpp
   sqlite3_utils.cpp
+  thread_pool.hpp
+  thread_pool.cpp
   ${CMAKE_CURRENT_BINARY_DIR}/proj_config.h
 )
 
@@ -281,6 +284,7 @@ set(HEADERS_LIBPROJ
   proj_constants.h
   proj_symbol_rename.h
   geodesic.h
+  geod_batch.h
 )
 
 # Group source files for IDE source explorers (e.g. Visual Studio)
@@ -398,6 +402,7 @@ if("${CMAKE_C_COMPILER_ID}" STREQUAL "Intel")
   # Apply to source files that require this option
   set_source_files_properties(
     geodesic.c
+    geod_batch.cpp
     PROPERTIES COMPILE_FLAGS ${FP_PRECISE})
 endif()
 
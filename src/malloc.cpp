@@ -47,11 +47,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
 #include <new>
+#include <type_traits>
 
 #include "proj/internal/io_internal.hpp"
 
 #include "filemanager.hpp"
+#include "geodesic.h"
 #include "grids.hpp"
 #include "proj.h"
 #include "proj_internal.h"
@@ -100,6 +103,7 @@ void *free_params(PJ_CONTEXT *ctx, paralist *start, int errlev) {
 PJ *proj_destroy(PJ *P) {
     if (nullptr == P || !P->destructor)
         return nullptr;
+    pj_trans_states_evict(P);
     /* free projection parameters - all the hard work is done by */
     /* pj_default_destructor, which is supposed */
     /* to be called as the last step of the local destructor     */
@@ -111,7 +115,10 @@ PJ *proj_destroy(PJ *P) {
 
 /*****************************************************************************/
 // cppcheck-suppress uninitMemberVar
-PJconsts::PJconsts() : destructor(pj_default_destructor) {}
+PJconsts::PJconsts() : destructor(pj_default_destructor) {
+    static std::atomic<unsigned long long> nextInstanceId(1);
+    instance_id = nextInstanceId++;
+}
 /*****************************************************************************/
 
 /*****************************************************************************/
@@ -120,6 +127,95 @@ PJ *pj_new() {
     return new (std::nothrow) PJ();
 }
 
+/*****************************************************************************/
+static char *clone_string(const char *str, bool &ok) {
+    /*****************************************************************************/
+    if (nullptr == str)
+        return nullptr;
+    char *copy = strdup(str);
+    if (nullptr == copy)
+        ok = false;
+    return copy;
+}
+
+/*****************************************************************************/
+static PJ *clone_child(PJ_CONTEXT *ctx, const PJ *child, bool &ok) {
+    /*****************************************************************************/
+    if (nullptr == child)
+        return nullptr;
+    PJ *copy = pj_clone_instantiated(ctx, child);
+    if (nullptr == copy)
+        ok = false;
+    return copy;
+}
+
+// pj_clone_instantiated() copies PJconstsValues by assignment: members that
+// own resources must be added to PJconsts instead, and handled there.
+static_assert(std::is_trivially_copyable<PJconstsValues>::value,
+              "PJconstsValues must only hold plain values");
+
+/*****************************************************************************/
+PJ *pj_clone_instantiated(PJ_CONTEXT *ctx, const PJ *P) {
+    /*****************************************************************************
+        Copy an instantiated PJ object, with its operation specific state,
+        rather than instantiating it again from its definition.
+
+        Returns nullptr if P, or one of the PJ objects it owns, cannot be
+        copied that way: when it has an opaque object but no clone_opaque()
+        function, or holds state of the legacy pj_transform() API or of
+        proj_create_crs_to_crs().
+    ******************************************************************************/
+    if ((P->opaque && !P->clone_opaque) || P->hgrids_legacy ||
+        P->vgrids_legacy || !P->alternativeCoordinateOperations.empty())
+        return nullptr;
+
+    PJ *Q = pj_new();
+    if (nullptr == Q)
+        return nullptr;
+    Q->ctx = ctx;
+    static_cast<PJconstsValues &>(*Q) = *P;
+
+    // Members owning resources
+
+    bool ok = true;
+    Q->params = pj_clone_paralist(P->params);
+    for (paralist *src = P->params, *dst = Q->params; src && dst;
+         src = src->next, dst = dst->next)
+        dst->used = src->used;
+    Q->def_full = clone_string(P->def_full, ok);
+    Q->def_size = clone_string(P->def_size, ok);
+    Q->def_shape = clone_string(P->def_shape, ok);
+    Q->def_spherification = clone_string(P->def_spherification, ok);
+    Q->def_ellps = clone_string(P->def_ellps, ok);
+    if (P->geod) {
+        Q->geod = static_cast<struct geod_geodesic *>(
+            malloc(sizeof(struct geod_geodesic)));
+        if (Q->geod)
+            memcpy(Q->geod, P->geod, sizeof(struct geod_geodesic));
+        else
+            ok = false;
+    }
+
+    Q->axisswap = clone_child(ctx, P->axisswap, ok);
+    Q->cart = clone_child(ctx, P->cart, ok);
+    Q->cart_wgs84 = clone_child(ctx, P->cart_wgs84, ok);
+    Q->helmert = clone_child(ctx, P->helmert, ok);
+    Q->hgridshift = clone_child(ctx, P->hgridshift, ok);
+    Q->vgridshift = clone_child(ctx, P->vgridshift, ok);
+
+    Q->iso_obj = P->iso_obj;
+
+    if ((P->params && !Q->params) || !ok ||
+        (P->opaque && !P->clone_opaque(Q, P))) {
+        // Q->destructor is still pj_default_destructor(), which does not
+        // know about the opaque object, if any, of the operation.
+        pj_default_destructor(Q, 0);
+        return nullptr;
+    }
+    Q->destructor = P->destructor;
+    return Q;
+}
+
 /*****************************************************************************/
 PJ *pj_default_destructor(PJ *P, int errlev) { /* Destructor */
     /*****************************************************************************
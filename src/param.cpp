@@ -9,6 +9,19 @@
 #include "proj.h"
 #include "proj_internal.h"
 
+/* hash and length of the name of a parameter, i.e. of str up to the first
+ * '=' or its end (FNV-1a) */
+unsigned int pj_param_key(const char *str, unsigned int *key_len) {
+    unsigned int hash = 2166136261U;
+    const char *c = str;
+    for (; *c != '\0' && *c != '='; ++c) {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 16777619U;
+    }
+    *key_len = static_cast<unsigned int>(c - str);
+    return hash;
+}
+
 /* create parameter list entry */
 paralist *pj_mkparam(const char *str) {
     paralist *newitem;
@@ -20,6 +33,7 @@ paralist *pj_mkparam(const char *str) {
         if (*str == '+')
             ++str;
         (void)strcpy(newitem->param, str);
+        newitem->key_hash = pj_param_key(newitem->param, &newitem->key_len);
     }
     return newitem;
 }
@@ -64,6 +78,7 @@ paralist *pj_mkparam_ws(const char *str, const char **next_str) {
 
     newitem->used = 0;
     newitem->next = nullptr;
+    newitem->key_hash = pj_param_key(newitem->param, &newitem->key_len);
 
     return newitem;
 }
@@ -86,20 +101,21 @@ paralist *pj_param_exists(paralist *list, const char *parameter) {
     obviously not an issue).
     ***************************************************************************************/
     paralist *next = list;
-    const char *c = strchr(parameter, '=');
-    size_t len = strlen(parameter);
-    if (c)
-        len = c - parameter;
     if (list == nullptr)
         return nullptr;
 
+    /* Compare the hashes of the names first, which spares most string
+     * comparisons, as constructors query many absent parameters */
+    unsigned int len;
+    const unsigned int hash = pj_param_key(parameter, &len);
+    const bool is_step = 0 == strcmp(parameter, "step");
     for (next = list; next; next = next->next) {
-        if (0 == strncmp(parameter, next->param, len) &&
-            (next->param[len] == '=' || next->param[len] == 0)) {
+        if (next->key_hash == hash && next->key_len == len &&
+            0 == strncmp(parameter, next->param, len)) {
             next->used = 1;
             return next;
         }
-        if (0 == strcmp(parameter, "step"))
+        if (is_step)
             return nullptr;
     }
 
@@ -129,7 +145,6 @@ paralist *pj_param_exists(paralist *list, const char *parameter) {
 PROJVALUE pj_param(PJ_CONTEXT *ctx, paralist *pl, const char *opt) {
 
     int type;
-    unsigned l;
     PROJVALUE value = {0};
 
     if (ctx == nullptr)
@@ -170,8 +185,7 @@ PROJVALUE pj_param(PJ_CONTEXT *ctx, paralist *pl, const char *opt) {
 
     /* Found parameter - now find its value */
     pl->used |= 1;
-    l = (int)strlen(opt);
-    opt = pl->param + l;
+    opt = pl->param + pl->key_len;
     if (*opt == '=')
         ++opt;
 
@@ -97,7 +97,9 @@ Thomas Knudsen, thokn@sdfe.dk, 2016-05-20
 *
 ********************************************************************************/
 
+#include <limits>
 #include <math.h>
+#include <new>
 #include <stack>
 #include <stddef.h>
 #include <string.h>
@@ -132,10 +134,43 @@ struct Step {
     ~Step() { proj_destroy(pj); }
 };
 
+struct StepKernel {
+    PJ *pj = nullptr;
+    // Operator of the step called directly, bypassing pj_fwd4d()/pj_inv4d(),
+    // when their prepare and finalize stages are no-ops for the step.
+    PJ_OPERATOR op = nullptr;
+    // Whether the input coordinate must be checked before calling op, as
+    // the prepare stage would do
+    bool check_input = false;
+    // Whether a failed input check sets
+    // PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN, as the prepare stage
+    // of pj_inv4d() does
+    bool input_error = false;
+    // Whether pj_inv4d() rather than pj_fwd4d() must be called, when op is
+    // not set
+    bool inverse = false;
+};
+
+struct ExecStep {
+    const Step *step;
+    // First and last steps of steps[] replaced by step when it is fused, or
+    // step itself otherwise
+    const Step *first;
+    const Step *last;
+};
+
 struct Pipeline {
     char **argv = nullptr;
     char **current_argv = nullptr;
     std::vector<Step> steps{};
+    // Affine steps resulting from the fusion of consecutive steps of steps[]
+    std::vector<Step> fused_steps{};
+    // Steps run by the 4D entry points, in their order of execution, in the
+    // forward and reverse directions of the pipeline. Bound at pipeline
+    // creation from steps[], with runs of affine steps replaced by their
+    // fused_steps[] counterpart, or removed when they amount to the identity.
+    std::vector<StepKernel> fwd_kernels{};
+    std::vector<StepKernel> inv_kernels{};
     std::stack<double> stack[4];
 };
 
@@ -153,21 +188,108 @@ static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P);
 static PJ_LPZ pipeline_reverse_3d(PJ_XYZ xyz, PJ *P);
 static PJ_XY pipeline_forward(PJ_LP lp, PJ *P);
 static PJ_LP pipeline_reverse(PJ_XY xy, PJ *P);
+static void push(PJ_COORD &point, PJ *P);
+static void pop(PJ_COORD &point, PJ *P);
 
 static void pipeline_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
     for (auto &step : pipeline->steps)
         proj_assign_context(step.pj, ctx);
+    for (auto &step : pipeline->fused_steps)
+        proj_assign_context(step.pj, ctx);
 }
 
-static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
+static bool pipeline_prepare_for_area(PJ *P, PJ_DIRECTION direction,
+                                      const std::vector<PJ_COORD> &pointsIn,
+                                      size_t &bytesLoaded) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
-    for (auto &step : pipeline->steps) {
-        if (!step.omit_fwd) {
-            if (!step.pj->inverted)
-                pj_fwd4d(point, step.pj);
+    std::vector<PJ_COORD> points(pointsIn);
+    // Emulate the stack of push and pop steps, for all points at once
+    std::stack<std::vector<double>> stack[4];
+    bool ret = true;
+
+    const auto prepareStep = [&points, &stack, &ret,
+                              &bytesLoaded](PJ *stepPJ, bool stepInverse) {
+        const auto stepFunc = stepInverse ? stepPJ->inv4d : stepPJ->fwd4d;
+        if (stepFunc == push || stepFunc == pop) {
+            const auto pushpop = static_cast<struct PushPop *>(stepPJ->opaque);
+            const bool flags[] = {pushpop->v1, pushpop->v2, pushpop->v3,
+                                  pushpop->v4};
+            for (int i = 0; i < 4; ++i) {
+                if (!flags[i])
+                    continue;
+                if (stepFunc == push) {
+                    std::vector<double> values;
+                    values.reserve(points.size());
+                    for (const auto &point : points)
+                        values.push_back(point.v[i]);
+                    stack[i].push(std::move(values));
+                } else if (!stack[i].empty()) {
+                    const auto &values = stack[i].top();
+                    for (size_t j = 0; j < points.size(); ++j) {
+                        if (points[j].xyzt.x != HUGE_VAL)
+                            points[j].v[i] = values[j];
+                    }
+                    stack[i].pop();
+                }
+            }
+            return;
+        }
+
+        if (!pj_prepare_for_area(stepPJ, stepInverse ? PJ_INV : PJ_FWD,
+                                 points, bytesLoaded)) {
+            ret = false;
+        }
+        for (auto &point : points) {
+            if (point.xyzt.x == HUGE_VAL)
+                continue;
+            if (stepInverse)
+                pj_inv4d(point, stepPJ);
             else
-                pj_inv4d(point, step.pj);
+                pj_fwd4d(point, stepPJ);
+        }
+    };
+
+    if (direction == PJ_FWD) {
+        for (auto &step : pipeline->steps) {
+            if (!step.omit_fwd)
+                prepareStep(step.pj, step.pj->inverted);
+        }
+    } else {
+        for (auto iterStep = pipeline->steps.rbegin();
+             iterStep != pipeline->steps.rend(); ++iterStep) {
+            const auto &step = *iterStep;
+            if (!step.omit_inv)
+                prepareStep(step.pj, !step.pj->inverted);
+        }
+    }
+    return ret;
+}
+
+static inline void run_kernels(const std::vector<StepKernel> &kernels,
+                               PJ_COORD &point, PJ *P) {
+    for (const auto &kernel : kernels) {
+        if (kernel.op) {
+            if (kernel.check_input &&
+                (point.v[0] == HUGE_VAL || point.v[1] == HUGE_VAL ||
+                 point.v[2] == HUGE_VAL)) {
+                if (kernel.input_error)
+                    proj_errno_set(
+                        kernel.pj,
+                        PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN);
+                point = proj_coord_error();
+                break;
+            }
+            kernel.op(point, kernel.pj);
+            if (point.xyzt.x == HUGE_VAL || P->ctx->last_errno) {
+                point = proj_coord_error();
+                break;
+            }
+        } else {
+            if (kernel.inverse)
+                pj_inv4d(point, kernel.pj);
+            else
+                pj_fwd4d(point, kernel.pj);
             if (point.xyzt.x == HUGE_VAL) {
                 break;
             }
@@ -175,23 +297,69 @@ static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
     }
 }
 
+static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    run_kernels(pipeline->fwd_kernels, point, P);
+}
+
 static void pipeline_reverse_4d(PJ_COORD &point, PJ *P) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
-    for (auto iterStep = pipeline->steps.rbegin();
-         iterStep != pipeline->steps.rend(); ++iterStep) {
-        const auto &step = *iterStep;
-        if (!step.omit_inv) {
-            if (step.pj->inverted)
-                pj_fwd4d(point, step.pj);
+    run_kernels(pipeline->inv_kernels, point, P);
+}
+
+/* Array variant of run_kernels(): each step is applied to all the
+ * coordinates before moving to the next one, so that steps providing array
+ * operators get called once for the whole array. */
+static void run_kernels_array(const std::vector<StepKernel> &kernels,
+                              size_t n, PJ_COORD *coo, int *errnos, PJ *P) {
+    PJ_CONTEXT *ctx = P->ctx;
+    for (const auto &kernel : kernels) {
+        const bool stepHasArrayOp =
+            kernel.inverse ? (kernel.pj->inv4d_array || kernel.pj->inv_array)
+                           : (kernel.pj->fwd4d_array || kernel.pj->fwd_array);
+        if (!kernel.op || stepHasArrayOp) {
+            if (kernel.inverse)
+                pj_inv4d_array(kernel.pj, n, coo, errnos);
             else
-                pj_inv4d(point, step.pj);
-            if (point.xyzt.x == HUGE_VAL) {
-                break;
+                pj_fwd4d_array(kernel.pj, n, coo, errnos);
+            continue;
+        }
+        for (size_t i = 0; i < n; i++) {
+            auto &point = coo[i];
+            if (point.xyzt.x == HUGE_VAL)
+                continue;
+            ctx->last_errno = 0;
+            if (kernel.check_input &&
+                (point.v[1] == HUGE_VAL || point.v[2] == HUGE_VAL)) {
+                if (kernel.input_error)
+                    proj_errno_set(
+                        kernel.pj,
+                        PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN);
+                point = proj_coord_error();
+                errnos[i] = ctx->last_errno;
+                continue;
+            }
+            kernel.op(point, kernel.pj);
+            if (point.xyzt.x == HUGE_VAL || ctx->last_errno) {
+                point = proj_coord_error();
+                errnos[i] = ctx->last_errno;
             }
         }
     }
 }
 
+static void pipeline_forward_4d_array(PJ *P, size_t n, PJ_COORD *coo,
+                                      int *errnos) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    run_kernels_array(pipeline->fwd_kernels, n, coo, errnos, P);
+}
+
+static void pipeline_reverse_4d_array(PJ *P, size_t n, PJ_COORD *coo,
+                                      int *errnos) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    run_kernels_array(pipeline->inv_kernels, n, coo, errnos, P);
+}
+
 static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
@@ -278,6 +446,58 @@ static PJ *destructor(PJ *P, int errlev) {
     return pj_default_destructor(P, errlev);
 }
 
+static bool pipeline_clone_opaque(PJ *dst, const PJ *src) {
+    auto srcPipeline = static_cast<const struct Pipeline *>(src->opaque);
+    auto pipeline = new (std::nothrow) Pipeline();
+    if (nullptr == pipeline)
+        return false;
+
+    const auto cloneSteps = [dst](const std::vector<Step> &srcSteps,
+                                  std::vector<Step> &dstSteps) {
+        dstSteps.reserve(srcSteps.size());
+        for (const auto &step : srcSteps) {
+            PJ *Q = pj_clone_instantiated(dst->ctx, step.pj);
+            if (nullptr == Q)
+                return false;
+            if (step.pj->parent)
+                Q->parent = dst;
+            dstSteps.emplace_back(Q, step.omit_fwd, step.omit_inv);
+        }
+        return true;
+    };
+    if (!cloneSteps(srcPipeline->steps, pipeline->steps) ||
+        !cloneSteps(srcPipeline->fused_steps, pipeline->fused_steps)) {
+        delete pipeline;
+        return false;
+    }
+
+    // Bind the kernels to the copies of the steps they were bound to
+    const auto clonedStep = [srcPipeline, pipeline](const PJ *pj) -> PJ * {
+        for (size_t i = 0; i < srcPipeline->steps.size(); ++i) {
+            if (srcPipeline->steps[i].pj == pj)
+                return pipeline->steps[i].pj;
+        }
+        for (size_t i = 0; i < srcPipeline->fused_steps.size(); ++i) {
+            if (srcPipeline->fused_steps[i].pj == pj)
+                return pipeline->fused_steps[i].pj;
+        }
+        return nullptr;
+    };
+    const auto cloneKernels = [&clonedStep](
+                                  const std::vector<StepKernel> &srcKernels,
+                                  std::vector<StepKernel> &dstKernels) {
+        for (auto kernel : srcKernels) {
+            kernel.pj = clonedStep(kernel.pj);
+            dstKernels.push_back(kernel);
+        }
+    };
+    cloneKernels(srcPipeline->fwd_kernels, pipeline->fwd_kernels);
+    cloneKernels(srcPipeline->inv_kernels, pipeline->inv_kernels);
+
+    dst->opaque = pipeline;
+    return true;
+}
+
 /* count the number of args in pipeline definition, and mark all args as used */
 static size_t argc_params(paralist *params) {
     size_t argc = 0;
@@ -358,6 +578,251 @@ static void set_ellipsoid(PJ *P) {
     proj_errno_restore(P, err);
 }
 
+/* Whether pj_fwd4d() on Q amounts to calling its forward function */
+static bool fwd_io_is_neutral(const PJ *Q) {
+    if (Q->axisswap || Q->helmert)
+        return false;
+    if (!Q->skip_fwd_prepare && Q->left == PJ_IO_UNITS_RADIANS)
+        return false;
+    if (Q->skip_fwd_finalize)
+        return true;
+    switch (Q->right) {
+    case PJ_IO_UNITS_WHATEVER:
+    case PJ_IO_UNITS_DEGREES:
+        return true;
+    case PJ_IO_UNITS_CARTESIAN:
+        return !Q->is_geocent && Q->fr_meter == 1;
+    case PJ_IO_UNITS_PROJECTED:
+        return Q->fr_meter == 1 && Q->vfr_meter == 1 && Q->x0 == 0 &&
+               Q->y0 == 0 && Q->z0 == 0;
+    case PJ_IO_UNITS_RADIANS:
+        return Q->vfr_meter == 1 && Q->z0 == 0 && !Q->is_long_wrap_set;
+    case PJ_IO_UNITS_CLASSIC:
+        break;
+    }
+    return false;
+}
+
+/* Whether pj_inv4d() on Q amounts to calling its inverse function */
+static bool inv_io_is_neutral(const PJ *Q) {
+    if (Q->axisswap || Q->helmert)
+        return false;
+    if (!Q->skip_inv_finalize && Q->left == PJ_IO_UNITS_RADIANS)
+        return false;
+    if (Q->skip_inv_prepare)
+        return true;
+    switch (Q->right) {
+    case PJ_IO_UNITS_WHATEVER:
+    case PJ_IO_UNITS_DEGREES:
+        return true;
+    case PJ_IO_UNITS_CARTESIAN:
+        return !Q->is_geocent && Q->to_meter == 1;
+    case PJ_IO_UNITS_PROJECTED:
+        return Q->to_meter == 1 && Q->vto_meter == 1 && Q->x0 == 0 &&
+               Q->y0 == 0 && Q->z0 == 0;
+    case PJ_IO_UNITS_RADIANS:
+        return Q->vto_meter == 1 && Q->z0 == 0;
+    case PJ_IO_UNITS_CLASSIC:
+        break;
+    }
+    return false;
+}
+
+/* Get the affine map applied by a step when the pipeline runs forward */
+static bool get_step_affine_coeffs(const Step &step, PJ_AFFINE_COEFFS &coeffs) {
+    const PJ *Q = step.pj;
+    if (step.omit_fwd || step.omit_inv || Q->get_affine_coeffs == nullptr)
+        return false;
+    if (!fwd_io_is_neutral(Q) || !inv_io_is_neutral(Q))
+        return false;
+    return Q->get_affine_coeffs(Q, Q->inverted ? PJ_INV : PJ_FWD, coeffs);
+}
+
+/* Compose a then b, i.e. return b(a(x)) */
+static PJ_AFFINE_COEFFS compose_affine_coeffs(const PJ_AFFINE_COEFFS &a,
+                                              const PJ_AFFINE_COEFFS &b) {
+    PJ_AFFINE_COEFFS res;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            res.matrix[i][j] = b.matrix[i][0] * a.matrix[0][j] +
+                               b.matrix[i][1] * a.matrix[1][j] +
+                               b.matrix[i][2] * a.matrix[2][j];
+        }
+        res.offset[i] = b.matrix[i][0] * a.offset[0] +
+                        b.matrix[i][1] * a.offset[1] +
+                        b.matrix[i][2] * a.offset[2] + b.offset[i];
+    }
+    res.tscale = b.tscale * a.tscale;
+    res.toff = b.tscale * a.toff + b.toff;
+    return res;
+}
+
+static bool is_identity_affine_coeffs(const PJ_AFFINE_COEFFS &coeffs) {
+    // Tolerate the rounding error of chained unit conversions, like
+    // deg -> rad -> deg
+    constexpr double EPS = 4 * std::numeric_limits<double>::epsilon();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            if (fabs(coeffs.matrix[i][j] - (i == j ? 1.0 : 0.0)) > EPS)
+                return false;
+        }
+        if (coeffs.offset[i] != 0)
+            return false;
+    }
+    return fabs(coeffs.tscale - 1.0) <= EPS && coeffs.toff == 0;
+}
+
+static StepKernel bind_step_kernel(const Step &step, bool inverse) {
+    StepKernel kernel;
+    PJ *Q = step.pj;
+    kernel.pj = Q;
+    kernel.inverse = inverse;
+    if (!inverse) {
+        if (Q->fwd4d && fwd_io_is_neutral(Q)) {
+            kernel.op = Q->fwd4d;
+            kernel.check_input = !Q->skip_fwd_prepare;
+        }
+    } else {
+        if (Q->inv4d && inv_io_is_neutral(Q)) {
+            kernel.op = Q->inv4d;
+            kernel.check_input = !Q->skip_inv_prepare;
+            kernel.input_error = true;
+        }
+    }
+    return kernel;
+}
+
+/* Bind the kernel of a step run in the direction of the pipeline given by
+ * inverse. The input check of a fused step is the one of the first step it
+ * replaces in that direction. */
+static StepKernel bind_exec_step_kernel(const ExecStep &exec, bool inverse) {
+    const auto step = exec.step;
+    auto kernel = bind_step_kernel(*step, (step->pj->inverted != 0) != inverse);
+    if (step != exec.first) {
+        const auto first = inverse ? exec.last : exec.first;
+        const auto firstKernel =
+            bind_step_kernel(*first, (first->pj->inverted != 0) != inverse);
+        kernel.check_input = firstKernel.check_input;
+        kernel.input_error = firstKernel.input_error;
+    }
+    return kernel;
+}
+
+/* Replace runs of consecutive affine steps (affine, axisswap, unitconvert,
+ * static helmert...) by a single affine step, and remove the ones that amount
+ * to the identity, so that the 4D entry points run fewer steps per point.
+ * Runs whose first step checks its input in either direction are not removed,
+ * so that invalid input still fails. Return the list of steps to run. */
+static std::vector<ExecStep> fuse_affine_steps(PJ *P) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    auto &steps = pipeline->steps;
+    const size_t nsteps = steps.size();
+    const bool needInverse = P->inv4d != nullptr;
+
+    // For each step of steps[], index in fused_steps[] of the step replacing
+    // it (and the following ones of its run), -1 to run it as is, or -2 to
+    // skip it.
+    std::vector<int> replacement(nsteps, -1);
+    // For each step of fused_steps[], index in steps[] of the last step it
+    // replaces
+    std::vector<size_t> fusedLast;
+
+    size_t i = 0;
+    while (i < nsteps) {
+        PJ_AFFINE_COEFFS coeffs;
+        if (!get_step_affine_coeffs(steps[i], coeffs)) {
+            ++i;
+            continue;
+        }
+        size_t j = i + 1;
+        PJ_AFFINE_COEFFS next;
+        while (j < nsteps && get_step_affine_coeffs(steps[j], next)) {
+            coeffs = compose_affine_coeffs(coeffs, next);
+            ++j;
+        }
+
+        const bool checksInput =
+            bind_step_kernel(steps[i], steps[i].pj->inverted != 0)
+                .check_input ||
+            bind_step_kernel(steps[j - 1], steps[j - 1].pj->inverted == 0)
+                .check_input;
+        if (!checksInput && is_identity_affine_coeffs(coeffs)) {
+            proj_log_trace(P, "Pipeline: steps %d to %d cancel out",
+                           static_cast<int>(i + 1), static_cast<int>(j));
+            for (size_t k = i; k < j; ++k)
+                replacement[k] = -2;
+        } else if (j - i >= 2) {
+            const int err = proj_errno_reset(P);
+            PJ *fused = pj_create_affine(P->ctx, coeffs);
+            proj_errno_restore(P, err);
+            if (fused && needInverse && !pj_has_inverse(fused)) {
+                proj_destroy(fused);
+                fused = nullptr;
+            }
+            if (fused) {
+                proj_log_trace(P, "Pipeline: steps %d to %d fused",
+                               static_cast<int>(i + 1), static_cast<int>(j));
+                fused->parent = P;
+                fused->left = pj_left(steps[i].pj);
+                fused->right = pj_right(steps[j - 1].pj);
+                fused->skip_fwd_prepare = 1;
+                fused->skip_fwd_finalize = 1;
+                fused->skip_inv_prepare = 1;
+                fused->skip_inv_finalize = 1;
+                replacement[i] = static_cast<int>(pipeline->fused_steps.size());
+                for (size_t k = i + 1; k < j; ++k)
+                    replacement[k] = -2;
+                pipeline->fused_steps.emplace_back(fused, false, false);
+                fusedLast.push_back(j - 1);
+            }
+        }
+        i = j;
+    }
+
+    std::vector<ExecStep> execSteps;
+    for (i = 0; i < nsteps; ++i) {
+        if (replacement[i] == -1) {
+            execSteps.push_back({&steps[i], &steps[i], &steps[i]});
+        } else if (replacement[i] >= 0) {
+            execSteps.push_back({&pipeline->fused_steps[replacement[i]],
+                                 &steps[i], &steps[fusedLast[replacement[i]]]});
+        }
+    }
+    return execSteps;
+}
+
+/* Bind the steps run for each point by the 4D entry points */
+static void bind_kernels(PJ *P) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    const auto execSteps = fuse_affine_steps(P);
+
+    // The values saved by push steps are only stacked for a single
+    // coordinate, so pipelines using them are run point by point.
+    bool hasPushPop = false;
+    for (const auto &exec : execSteps) {
+        const auto Q = exec.step->pj;
+        if (Q->fwd4d == push || Q->fwd4d == pop)
+            hasPushPop = true;
+    }
+    if (!hasPushPop) {
+        P->fwd4d_array = pipeline_forward_4d_array;
+        if (P->inv4d)
+            P->inv4d_array = pipeline_reverse_4d_array;
+    }
+
+    pipeline->fwd_kernels.clear();
+    for (const auto &exec : execSteps) {
+        if (!exec.step->omit_fwd)
+            pipeline->fwd_kernels.push_back(bind_exec_step_kernel(exec, false));
+    }
+
+    pipeline->inv_kernels.clear();
+    for (auto iter = execSteps.rbegin(); iter != execSteps.rend(); ++iter) {
+        if (!iter->step->omit_inv)
+            pipeline->inv_kernels.push_back(bind_exec_step_kernel(*iter, true));
+    }
+}
+
 PJ *OPERATION(pipeline, 0) {
     int i, nsteps = 0, argc;
     int i_pipeline = -1, i_first_step = -1, i_current_step;
@@ -387,6 +852,8 @@ PJ *OPERATION(pipeline, 0) {
     P->inv = pipeline_reverse;
     P->destructor = destructor;
     P->reassign_context = pipeline_reassign_context;
+    P->clone_opaque = pipeline_clone_opaque;
+    P->prepare_for_area = pipeline_prepare_for_area;
 
     /* Currently, the pipeline driver is a raw bit mover, enabling other
      * operations */
@@ -635,6 +1102,9 @@ PJ *OPERATION(pipeline, 0) {
     /* Now, correspondingly determine forward output (= reverse input) data type
      */
     P->right = pj_right(pipeline->steps.back().pj);
+
+    bind_kernels(P);
+
     return P;
 }
 
@@ -691,6 +1161,7 @@ static PJ *setup_pushpop(PJ *P) {
     P->opaque = pushpop;
     if (nullptr == P->opaque)
         return destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
+    P->clone_opaque = pj_clone_plain_opaque<struct PushPop>;
 
     if (pj_param_exists(P->params, "v_1"))
         pushpop->v1 = true;
@@ -203,6 +203,10 @@ typedef union PJ_COORD PJ_COORD;
 struct PJ_AREA;
 typedef struct PJ_AREA PJ_AREA;
 
+/* Execution state of a thread using transformations shared between threads */
+struct PJ_TRANS_STATE;
+typedef struct PJ_TRANS_STATE PJ_TRANS_STATE;
+
 struct P5_FACTORS {          /* Common designation */
     double meridional_scale; /* h */
     double parallel_scale;   /* k */
@@ -417,6 +421,12 @@ void PROJ_DLL proj_context_set_search_paths(PJ_CONTEXT *ctx, int count_paths,
                                             const char *const *paths);
 void PROJ_DLL proj_context_set_ca_bundle_path(PJ_CONTEXT *ctx,
                                               const char *path);
+void PROJ_DLL proj_context_set_pipeline_cache_size(PJ_CONTEXT *ctx,
+                                                   size_t max_entries);
+void PROJ_DLL proj_context_get_pipeline_cache_stats(PJ_CONTEXT *ctx,
+                                                    size_t *out_hits,
+                                                    size_t *out_misses,
+                                                    size_t *out_entries);
 /*! @cond Doxygen_Suppress */
 void PROJ_DLL proj_context_use_proj4_init_rules(PJ_CONTEXT *ctx, int enable);
 int PROJ_DLL proj_context_get_use_proj4_init_rules(PJ_CONTEXT *ctx,
@@ -640,6 +650,19 @@ int PROJ_DLL proj_trans_bounds(PJ_CONTEXT *context, PJ *P,
                                double xmax, double ymax, double *out_xmin,
                                double *out_ymin, double *out_xmax,
                                double *out_ymax, int densify_pts);
+int PROJ_DLL proj_prepare_for_area(PJ *P, PJ_DIRECTION direction, double xmin,
+                                   double ymin, double xmax, double ymax,
+                                   size_t *out_bytes_loaded);
+int PROJ_DLL proj_trans_array_approx(PJ *P, PJ_DIRECTION direction, size_t n,
+                                     PJ_COORD *coord, double max_error_xy,
+                                     double max_error_z);
+PJ_TRANS_STATE PROJ_DLL *proj_trans_state_create(PJ_CONTEXT *ctx);
+void PROJ_DLL proj_trans_state_destroy(PJ_TRANS_STATE *state);
+PJ_COORD PROJ_DLL proj_trans_shared(const PJ *P, PJ_TRANS_STATE *state,
+                                    PJ_DIRECTION direction, PJ_COORD coord);
+int PROJ_DLL proj_trans_array_shared(const PJ *P, PJ_TRANS_STATE *state,
+                                     PJ_DIRECTION direction, size_t n,
+                                     PJ_COORD *coord);
 /*! @cond Doxygen_Suppress */
 
 /* Initializers */
@@ -1369,6 +1392,14 @@ void PROJ_DLL proj_operation_factory_context_set_discard_superseded(
 void PROJ_DLL proj_operation_factory_context_set_allow_ballpark_transformations(
     PJ_CONTEXT *ctx, PJ_OPERATION_FACTORY_CONTEXT *factory_ctx, int allow);
 
+void PROJ_DLL proj_operation_factory_context_set_max_threads(
+    PJ_CONTEXT *ctx, PJ_OPERATION_FACTORY_CONTEXT *factory_ctx,
+    int max_threads);
+
+void PROJ_DLL proj_operation_factory_context_set_max_result_count(
+    PJ_CONTEXT *ctx, PJ_OPERATION_FACTORY_CONTEXT *factory_ctx,
+    int max_result_count);
+
 /* ------------------------------------------------------------------------- */
 
 PJ_OBJ_LIST PROJ_DLL *
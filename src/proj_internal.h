@@ -76,6 +76,9 @@
 #include "proj/common.hpp"
 #include "proj/coordinateoperation.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -212,8 +215,19 @@ struct projCppContext;
 void PROJ_DLL
 proj_context_delete_cpp_context(struct projCppContext *cppContext);
 
+struct projPipelineCache;
+void pj_pipeline_cache_destroy(struct projPipelineCache *cache);
+
+struct projThreadPool;
+void pj_thread_pool_destroy(struct projThreadPool *pool);
+
 bool pj_fwd4d(PJ_COORD &coo, PJ *P);
 bool pj_inv4d(PJ_COORD &coo, PJ *P);
+void pj_fwd4d_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos);
+void pj_inv4d_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos);
+bool pj_prepare_for_area(PJ *P, PJ_DIRECTION direction,
+                         const std::vector<PJ_COORD> &points,
+                         size_t &bytesLoaded);
 
 PJ_COORD PROJ_DLL pj_approx_2D_trans(PJ *P, PJ_DIRECTION direction,
                                      PJ_COORD coo);
@@ -302,12 +316,34 @@ PJ_OPERATOR:
     A function taking a reference to a PJ_COORD and a pointer-to-PJ as args,
 applying the PJ to the PJ_COORD, and modifying in-place the passed PJ_COORD.
 
+PJ_ARRAY_OPERATOR:
+
+    A function taking a pointer-to-PJ, a number of coordinates, a pointer to
+an array of PJ_COORD and a pointer to an array of error codes, applying the PJ
+to each PJ_COORD whose first component is not HUGE_VAL and modifying them
+in-place. Coordinates that fail to transform get their first component set to
+HUGE_VAL and their error code stored in the error codes array, which is left
+untouched for the other coordinates.
+
 *****************************************************************************/
 typedef PJ *(*PJ_CONSTRUCTOR)(PJ *);
 typedef PJ *(*PJ_DESTRUCTOR)(PJ *, int);
 typedef void (*PJ_OPERATOR)(PJ_COORD &, PJ *);
+typedef void (*PJ_ARRAY_OPERATOR)(PJ *, size_t, PJ_COORD *, int *);
 /****************************************************************************/
 
+/* Coefficients of an affine map, as applied by the affine, axisswap,
+ * unitconvert and static helmert operations:
+ *     out[i] = offset[i] + sum_j(matrix[i][j] * in[j]) for x, y, z
+ *     out_t = toff + tscale * in_t
+ */
+struct PJ_AFFINE_COEFFS {
+    double matrix[3][3];
+    double offset[3];
+    double tscale;
+    double toff;
+};
+
 /* datum_type values */
 #define PJD_UNKNOWN 0
 #define PJD_3PARAM 1
@@ -362,6 +398,11 @@ struct PJCoordOperation {
     // geographic ones in lon, lat order
     PJ *pjDstGeocentricToLonLat = nullptr;
 
+    // Whether pj only holds the ISO19111 definition of the operation, its
+    // instantiation being deferred until instantiate() is called, before the
+    // first use of the operation to transform coordinates.
+    bool instantiationDeferred = false;
+
     PJCoordOperation(int idxInOriginalListIn, double minxSrcIn,
                      double minySrcIn, double maxxSrcIn, double maxySrcIn,
                      double minxDstIn, double minyDstIn, double maxxDstIn,
@@ -394,7 +435,8 @@ struct PJCoordOperation {
           pjDstGeocentricToLonLat(
               other.pjDstGeocentricToLonLat
                   ? proj_clone(ctx, other.pjDstGeocentricToLonLat)
-                  : nullptr) {}
+                  : nullptr),
+          instantiationDeferred(other.instantiationDeferred) {}
 
     PJCoordOperation(PJCoordOperation &&other)
         : idxInOriginalList(other.idxInOriginalList), minxSrc(other.minxSrc),
@@ -409,7 +451,8 @@ struct PJCoordOperation {
           srcIsLonLatDegree(other.srcIsLonLatDegree),
           srcIsLatLonDegree(other.srcIsLatLonDegree),
           dstIsLonLatDegree(other.dstIsLonLatDegree),
-          dstIsLatLonDegree(other.dstIsLatLonDegree) {
+          dstIsLatLonDegree(other.dstIsLatLonDegree),
+          instantiationDeferred(other.instantiationDeferred) {
         pj = other.pj;
         other.pj = nullptr;
         pjSrcGeocentricToLonLat = other.pjSrcGeocentricToLonLat;
@@ -439,6 +482,8 @@ struct PJCoordOperation {
 
     bool isInstantiable() const;
 
+    void instantiate();
+
   private:
     static constexpr int INSTANTIABLE_STATUS_UNKNOWN =
         -1; // must be different from 0(=false) and 1(=true)
@@ -452,39 +497,14 @@ enum class TMercAlgo {
     PODER_ENGSAGER,
 };
 
-/* base projection data structure */
-struct PJconsts {
-
-    /*************************************************************************************
-
-                         G E N E R A L   P A R A M E T E R   S T R U C T
-
-    **************************************************************************************
-
-        TODO: Need some description here - especially about the thread
-    context... This is the struct behind the PJ typedef
-
-    **************************************************************************************/
+/* Members of the base projection data structure that are plain values, and
+ * are thus copied by assignment by pj_clone_instantiated(). Members owning
+ * resources, or that must not be shared between copies, belong to PJconsts
+ * itself. */
+struct PJconstsValues {
 
-    PJ_CONTEXT *ctx = nullptr;
     const char *short_name = nullptr; /* From pj_list.h */
     const char *descr = nullptr; /* From pj_list.h or individual PJ_*.c file */
-    paralist *params = nullptr;  /* Parameter list */
-    char *def_full =
-        nullptr; /* Full textual definition (usually 0 - set by proj_pj_info) */
-    PJconsts *parent = nullptr; /* Parent PJ of pipeline steps - nullptr if not
-                                   a pipeline step */
-
-    /* For debugging / logging purposes */
-    char *def_size =
-        nullptr; /* Shape and size parameters extracted from params */
-    char *def_shape = nullptr;
-    char *def_spherification = nullptr;
-    char *def_ellps = nullptr;
-
-    struct geod_geodesic *geod = nullptr; /* For geodesic computations */
-    void *opaque =
-        nullptr;      /* Projection specific parameters, Defined in PJ_*.c */
     int inverted = 0; /* Tell high level API functions to swap inv/fwd */
 
     /*************************************************************************************
@@ -508,9 +528,34 @@ struct PJconsts {
     PJ_LPZ (*inv3d)(PJ_XYZ, PJ *) = nullptr;
     PJ_OPERATOR fwd4d = nullptr;
     PJ_OPERATOR inv4d = nullptr;
+    // Optional array variants of the highest dimensional forward and inverse
+    // operators, used by pj_fwd4d_array() and pj_inv4d_array() in place of
+    // them, between the prepare and finalize stages.
+    PJ_ARRAY_OPERATOR fwd_array = nullptr;
+    PJ_ARRAY_OPERATOR inv_array = nullptr;
+    // Optional array variants of fwd4d and inv4d, used by pj_fwd4d_array()
+    // and pj_inv4d_array() in place of them, when the prepare and finalize
+    // stages are skipped.
+    PJ_ARRAY_OPERATOR fwd4d_array = nullptr;
+    PJ_ARRAY_OPERATOR inv4d_array = nullptr;
 
-    PJ_DESTRUCTOR destructor = nullptr;
     void (*reassign_context)(PJ *, PJ_CONTEXT *) = nullptr;
+    // Load the resources (grids) needed to transform the points, expressed
+    // in the input units of the operation for the direction.
+    bool (*prepare_for_area)(PJ *, PJ_DIRECTION,
+                             const std::vector<PJ_COORD> &,
+                             size_t &) = nullptr;
+    // Return the coefficients of the operation in the given direction, when
+    // it is an affine map of the coordinates. Used by the pipeline to fuse
+    // adjacent steps.
+    bool (*get_affine_coeffs)(const PJ *, PJ_DIRECTION,
+                              PJ_AFFINE_COEFFS &) = nullptr;
+    // Copy the operation specific state of src, the source of a
+    // pj_clone_instantiated() call, into dst, allocating dst->opaque, which
+    // must be left null on failure. Operations having an opaque object but
+    // no such function are cloned by instantiating them again from their
+    // definition.
+    bool (*clone_opaque)(PJ *dst, const PJ *src) = nullptr;
 
     /*************************************************************************************
 
@@ -585,15 +630,6 @@ struct PJconsts {
         PJ_IO_UNITS_WHATEVER; /* Flags for input/output coordinate types */
     enum pj_io_units right = PJ_IO_UNITS_WHATEVER;
 
-    /* These PJs are used for implementing cs2cs style coordinate handling in
-     * the 4D API */
-    PJ *axisswap = nullptr;
-    PJ *cart = nullptr;
-    PJ *cart_wgs84 = nullptr;
-    PJ *helmert = nullptr;
-    PJ *hgridshift = nullptr;
-    PJ *vgridshift = nullptr;
-
     /*************************************************************************************
 
                        C A R T O G R A P H I C       O F F S E T S
@@ -635,11 +671,7 @@ struct PJconsts {
     double datum_params[7] = {0, 0, 0, 0,
                               0, 0, 0}; /* Parameters for 3PARAM and 7PARAM */
 
-    int has_geoid_vgrids = 0;      /* used by legacy transform.cpp */
-    void *hgrids_legacy = nullptr; /* used by legacy transform.cpp. Is a pointer
-                                      to a ListOfHGrids* */
-    void *vgrids_legacy = nullptr; /* used by legacy transform.cpp. Is a pointer
-                                      to a ListOfVGrids* */
+    int has_geoid_vgrids = 0; /* used by legacy transform.cpp */
 
     double from_greenwich = 0.0;   /* prime meridian offset (in radians) */
     double long_wrap_center = 0.0; /* 0.0 for -180 to 180, actually in radians*/
@@ -650,11 +682,78 @@ struct PJconsts {
      ISO-19111 interface
     **************************************************************************************/
 
-    NS_PROJ::util::BaseObjectPtr iso_obj{};
     bool iso_obj_is_coordinate_operation = false;
     double coordinateEpoch = 0;
     bool hasCoordinateEpoch = false;
 
+    // cache pj_get_type() result to help for repeated calls to proj_factors()
+    mutable PJ_TYPE type = PJ_TYPE_UNKNOWN;
+
+    /*************************************************************************************
+     proj_create_crs_to_crs() alternative coordinate operations
+    **************************************************************************************/
+    bool errorIfBestTransformationNotAvailable = false;
+    bool warnIfBestTransformationNotAvailable =
+        true; /* to remove in PROJ 10? */
+    bool skipNonInstantiable = true;
+};
+
+struct PJTransStateEvictions;
+
+/* base projection data structure */
+struct PJconsts : PJconstsValues {
+
+    /*************************************************************************************
+
+                         G E N E R A L   P A R A M E T E R   S T R U C T
+
+    **************************************************************************************
+
+        TODO: Need some description here - especially about the thread
+    context... This is the struct behind the PJ typedef
+
+    **************************************************************************************/
+
+    PJ_CONTEXT *ctx = nullptr;
+    paralist *params = nullptr; /* Parameter list */
+    char *def_full =
+        nullptr; /* Full textual definition (usually 0 - set by proj_pj_info) */
+    PJconsts *parent = nullptr; /* Parent PJ of pipeline steps - nullptr if not
+                                   a pipeline step */
+
+    /* For debugging / logging purposes */
+    char *def_size =
+        nullptr; /* Shape and size parameters extracted from params */
+    char *def_shape = nullptr;
+    char *def_spherification = nullptr;
+    char *def_ellps = nullptr;
+
+    struct geod_geodesic *geod = nullptr; /* For geodesic computations */
+    void *opaque =
+        nullptr; /* Projection specific parameters, Defined in PJ_*.c */
+
+    PJ_DESTRUCTOR destructor = nullptr;
+
+    /* These PJs are used for implementing cs2cs style coordinate handling in
+     * the 4D API */
+    PJ *axisswap = nullptr;
+    PJ *cart = nullptr;
+    PJ *cart_wgs84 = nullptr;
+    PJ *helmert = nullptr;
+    PJ *hgridshift = nullptr;
+    PJ *vgridshift = nullptr;
+
+    void *hgrids_legacy = nullptr; /* used by legacy transform.cpp. Is a pointer
+                                      to a ListOfHGrids* */
+    void *vgrids_legacy = nullptr; /* used by legacy transform.cpp. Is a pointer
+                                      to a ListOfVGrids* */
+
+    /*************************************************************************************
+     ISO-19111 interface
+    **************************************************************************************/
+
+    NS_PROJ::util::BaseObjectPtr iso_obj{};
+
     // cached results
     mutable std::string lastWKT{};
     mutable std::string lastPROJString{};
@@ -662,18 +761,23 @@ struct PJconsts {
     mutable bool gridsNeededAsked = false;
     mutable std::vector<NS_PROJ::operation::GridDescription> gridsNeeded{};
 
-    // cache pj_get_type() result to help for repeated calls to proj_factors()
-    mutable PJ_TYPE type = PJ_TYPE_UNKNOWN;
-
     /*************************************************************************************
      proj_create_crs_to_crs() alternative coordinate operations
     **************************************************************************************/
     std::vector<PJCoordOperation> alternativeCoordinateOperations{};
     int iCurCoordOp = -1;
-    bool errorIfBestTransformationNotAvailable = false;
-    bool warnIfBestTransformationNotAvailable =
-        true; /* to remove in PROJ 10? */
-    bool skipNonInstantiable = true;
+
+    // Identifier unique to each PJ object created during the lifetime of the
+    // process, which PJ_TRANS_STATE indexes the copies of objects with.
+    unsigned long long instance_id = 0;
+
+    // Evictions of the PJ_TRANS_STATE objects holding a copy of this object,
+    // notified when it is destroyed. hasTransStates is only set once this
+    // object has been used with a state, so that destroying other objects
+    // does not take any lock.
+    mutable std::atomic<bool> hasTransStates{false};
+    mutable std::mutex transStatesMutex{};
+    mutable std::vector<std::weak_ptr<PJTransStateEvictions>> transStates{};
 
     /*************************************************************************************
 
@@ -689,6 +793,11 @@ struct PJconsts {
 /* Parameter list (a copy of the +proj=... etc. parameters) */
 struct ARG_list {
     paralist *next;
+    /* Hash and length of the parameter name, i.e. the part of param before
+     * any '=', set by pj_param_key() when the item is created, so that
+     * lookups seldom need to compare strings */
+    unsigned int key_hash;
+    unsigned int key_len;
     char used;
 #if (defined(__GNUC__) && __GNUC__ >= 8) ||                                    \
     (defined(__clang__) && __clang_major__ >= 9)
@@ -825,6 +934,13 @@ struct pj_ctx {
     int pipelineInitRecursiongCounter =
         0; // to avoid potential infinite recursion in pipeline.cpp
 
+    size_t pipelineCacheSize = 0; // see proj_context_set_pipeline_cache_size()
+    struct projPipelineCache *pipelineCache =
+        nullptr; // created by pj_create_internal() when first needed
+
+    struct projThreadPool *threadPool =
+        nullptr; // created by pj_ctx_get_thread_pool() when first needed
+
     pj_ctx() = default;
     pj_ctx(const pj_ctx &);
     ~pj_ctx();
@@ -889,6 +1005,7 @@ PROJVALUE PROJ_DLL pj_param(PJ_CONTEXT *ctx, paralist *, const char *);
 paralist PROJ_DLL *pj_param_exists(paralist *list, const char *parameter);
 paralist PROJ_DLL *pj_mkparam(const char *);
 paralist *pj_mkparam_ws(const char *str, const char **next_str);
+unsigned int pj_param_key(const char *str, unsigned int *key_len);
 
 int PROJ_DLL pj_ell_set(PJ_CONTEXT *ctx, paralist *, double *, double *);
 int pj_datum_set(PJ_CONTEXT *, paralist *, PJ *);
@@ -929,6 +1046,18 @@ const struct PJ_DATUMS PROJ_DLL *pj_get_datums_ref(void);
 
 PJ *pj_new(void);
 PJ *pj_default_destructor(PJ *P, int errlev);
+PJ *pj_clone_instantiated(PJ_CONTEXT *ctx, const PJ *P);
+void pj_trans_states_evict(const PJ *P);
+
+/* Implementation of PJ::clone_opaque for operations whose opaque object is a
+ * plain structure allocated with malloc() or calloc() */
+template <class T> bool pj_clone_plain_opaque(PJ *dst, const PJ *src) {
+    dst->opaque = malloc(sizeof(T));
+    if (nullptr == dst->opaque)
+        return false;
+    memcpy(dst->opaque, src->opaque, sizeof(T));
+    return true;
+}
 
 double PROJ_DLL pj_atof(const char *nptr);
 double pj_strtod(const char *nptr, char **endptr);
@@ -942,6 +1071,7 @@ std::string pj_double_quote_string_param_if_needed(const std::string &str);
 
 PJ *pj_create_internal(PJ_CONTEXT *ctx, const char *definition);
 PJ *pj_create_argv_internal(PJ_CONTEXT *ctx, int argc, char **argv);
+PJ *pj_create_affine(PJ_CONTEXT *ctx, const PJ_AFFINE_COEFFS &coeffs);
 
 // For use by projinfo
 void pj_load_ini(PJ_CONTEXT *ctx);
@@ -974,6 +1104,10 @@ PJ_LP pj_generic_inverse_2d(PJ_XY xy, PJ *P, PJ_LP lpInitial,
                             double deltaXYTolerance);
 
 PJ *pj_obj_create(PJ_CONTEXT *ctx, const NS_PROJ::util::BaseObjectNNPtr &objIn);
+PJ *pj_obj_create_deferred(PJ_CONTEXT *ctx,
+                           const NS_PROJ::util::BaseObjectNNPtr &objIn);
+PJ *pj_list_get_deferred(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result,
+                         int index);
 
 /*****************************************************************************/
 /*                                                                           */
@@ -28,12 +28,18 @@
 
 /*! @cond Doxygen_Suppress */
 
+#ifndef FROM_PROJ_CPP
+#define FROM_PROJ_CPP
+#endif
+
 #include <limits>
 #include <string>
 #include <vector>
 
 #include "proj_json_streaming_writer.hpp"
 
+#include "proj/internal/internal.hpp"
+
 #include <cmath>
 #include <sqlite3.h>
 #include <stdarg.h>
@@ -260,6 +266,12 @@ void CPLJSonStreamingWriter::Add(double dfVal, int nPrecision) {
         // like 2005. See https://github.com/OSGeo/PROJ/issues/3297
         Print(CPLSPrintf("%d", static_cast<int>(dfVal)));
     } else {
+        char szBuffer[32];
+        if (nPrecision == 15 &&
+            internal::formatShortestDouble15(dfVal, szBuffer)) {
+            Print(szBuffer);
+            return;
+        }
         char szFormatting[10];
         snprintf(szFormatting, sizeof(szFormatting), "%%.%dg", nPrecision);
         Print(CPLSPrintf(szFormatting, dfVal));
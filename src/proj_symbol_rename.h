@@ -52,6 +52,8 @@
 #define proj_context_get_database_path internal_proj_context_get_database_path
 #define proj_context_get_database_structure                                    \
     internal_proj_context_get_database_structure
+#define proj_context_get_pipeline_cache_stats                                  \
+    internal_proj_context_get_pipeline_cache_stats
 #define proj_context_get_url_endpoint internal_proj_context_get_url_endpoint
 #define proj_context_get_use_proj4_init_rules                                  \
     internal_proj_context_get_use_proj4_init_rules
@@ -68,6 +70,8 @@
 #define proj_context_set_file_finder internal_proj_context_set_file_finder
 #define proj_context_set_network_callbacks                                     \
     internal_proj_context_set_network_callbacks
+#define proj_context_set_pipeline_cache_size                                   \
+    internal_proj_context_set_pipeline_cache_size
 #define proj_context_set_search_paths internal_proj_context_set_search_paths
 #define proj_context_set_sqlite3_vfs_name                                      \
     internal_proj_context_set_sqlite3_vfs_name
@@ -404,6 +408,7 @@
 #define proj_operation_factory_context_set_use_proj_alternative_grid_names     \
     internal_proj_operation_factory_context_set_use_proj_alternative_grid_names
 #define proj_pj_info internal_proj_pj_info
+#define proj_prepare_for_area internal_proj_prepare_for_area
 #define proj_prime_meridian_get_parameters                                     \
     internal_proj_prime_meridian_get_parameters
 #define proj_query_geodetic_crs_from_datum                                     \
@@ -418,10 +423,15 @@
 #define proj_torad internal_proj_torad
 #define proj_trans internal_proj_trans
 #define proj_trans_array internal_proj_trans_array
+#define proj_trans_array_approx internal_proj_trans_array_approx
+#define proj_trans_array_shared internal_proj_trans_array_shared
 #define proj_trans_bounds internal_proj_trans_bounds
 #define proj_trans_generic internal_proj_trans_generic
 #define proj_trans_get_last_used_operation                                     \
     internal_proj_trans_get_last_used_operation
+#define proj_trans_shared internal_proj_trans_shared
+#define proj_trans_state_create internal_proj_trans_state_create
+#define proj_trans_state_destroy internal_proj_trans_state_destroy
 #define proj_unit_list_destroy internal_proj_unit_list_destroy
 #define proj_uom_get_info_from_database internal_proj_uom_get_info_from_database
 #define proj_xy_dist internal_proj_xy_dist
@@ -84,6 +84,7 @@ PJ *PJ_PROJECTION(lcc) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_lcc_data>;
 
     Q->phi1 = pj_param(P->ctx, P->params, "rlat_1").f;
     if (pj_param(P->ctx, P->params, "tlat_2").i)
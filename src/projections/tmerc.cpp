@@ -225,6 +225,23 @@ static PJ *destructor(PJ *P, int errlev) {
     return pj_default_destructor(P, errlev);
 }
 
+static bool clone_opaque(PJ *dst, const PJ *src) {
+    auto Q =
+        static_cast<struct tmerc_data *>(malloc(sizeof(struct tmerc_data)));
+    if (nullptr == Q)
+        return false;
+    memcpy(Q, src->opaque, sizeof(struct tmerc_data));
+    if (Q->approx.en) {
+        Q->approx.en = pj_enfn(src->n);
+        if (nullptr == Q->approx.en) {
+            free(Q);
+            return false;
+        }
+    }
+    dst->opaque = Q;
+    return true;
+}
+
 static PJ *setup_approx(PJ *P) {
     auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->approx);
 
@@ -614,6 +631,282 @@ static PJ_LP auto_e_inv(PJ_XY xy, PJ *P) {
         return approx_e_inv(xy, P);
 }
 
+/*****************************************************************************/
+//
+//                  Batched Poder/Engsager functions
+//
+// The array variants of the exact algorithm transform the coordinates by
+// batches of TMERC_BATCH_SIZE points. The transcendental functions are
+// evaluated point by point, but the Clenshaw summations are run in lockstep
+// for all the points of a batch, which lets the compiler vectorize them.
+// Each point goes through the very same sequence of floating point
+// operations as in exact_e_fwd() and exact_e_inv(), so that results are
+// identical to the ones of the scalar functions. Incomplete batches are
+// padded by repeating their last point.
+//
+/*****************************************************************************/
+
+#define TMERC_BATCH_SIZE 16
+
+/* gatg() applied to TMERC_BATCH_SIZE arguments at once */
+static void gatg_batch(const double *p1, int len_p1, const double *B,
+                       const double *cos_2B, const double *sin_2B,
+                       double *res) {
+    double two_cos_2B[TMERC_BATCH_SIZE];
+    double h[TMERC_BATCH_SIZE], h1[TMERC_BATCH_SIZE], h2[TMERC_BATCH_SIZE];
+
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        two_cos_2B[k] = 2 * cos_2B[k];
+        h[k] = 0;
+        h1[k] = p1[len_p1 - 1];
+        h2[k] = 0;
+    }
+    for (int j = len_p1 - 2; j >= 0; j--) {
+        const double c = p1[j];
+        for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+            h[k] = -h2[k] + two_cos_2B[k] * h1[k] + c;
+            h2[k] = h1[k];
+            h1[k] = h[k];
+        }
+    }
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++)
+        res[k] = B[k] + h[k] * sin_2B[k];
+}
+
+/* clenS() applied to TMERC_BATCH_SIZE arguments at once */
+static void clenS_batch(const double *a, int size,
+                        const double *sin_arg_r, const double *cos_arg_r,
+                        const double *sinh_arg_i, const double *cosh_arg_i,
+                        double *R, double *I) {
+    double r[TMERC_BATCH_SIZE], i[TMERC_BATCH_SIZE];
+    double hr[TMERC_BATCH_SIZE], hr1[TMERC_BATCH_SIZE];
+    double hi[TMERC_BATCH_SIZE], hi1[TMERC_BATCH_SIZE];
+
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        r[k] = 2 * cos_arg_r[k] * cosh_arg_i[k];
+        i[k] = -2 * sin_arg_r[k] * sinh_arg_i[k];
+        hr[k] = a[size - 1];
+        hr1[k] = 0;
+        hi[k] = 0;
+        hi1[k] = 0;
+    }
+    for (int j = size - 2; j >= 0; j--) {
+        const double c = a[j];
+        for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+            const double hr2 = hr1[k];
+            const double hi2 = hi1[k];
+            hr1[k] = hr[k];
+            hi1[k] = hi[k];
+            hr[k] = -hr2 + r[k] * hr1[k] - i[k] * hi1[k] + c;
+            hi[k] = -hi2 + i[k] * hr1[k] + r[k] * hi1[k];
+        }
+    }
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        const double rr = sin_arg_r[k] * cosh_arg_i[k];
+        const double ii = cos_arg_r[k] * sinh_arg_i[k];
+        R[k] = rr * hr[k] - ii * hi[k];
+        I[k] = rr * hi[k] + ii * hr[k];
+    }
+}
+
+/* Ellipsoidal, forward, for the coordinates of coo indexed by idx */
+static void exact_e_fwd_batch(PJ *P, PJ_COORD *coo, const size_t *idx,
+                              int *errnos) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->exact);
+    double phi[TMERC_BATCH_SIZE], cos_2phi[TMERC_BATCH_SIZE],
+        sin_2phi[TMERC_BATCH_SIZE];
+    double Cn[TMERC_BATCH_SIZE], Ce[TMERC_BATCH_SIZE];
+    double sin_arg_r[TMERC_BATCH_SIZE], cos_arg_r[TMERC_BATCH_SIZE];
+    double sinh_arg_i[TMERC_BATCH_SIZE], cosh_arg_i[TMERC_BATCH_SIZE];
+    double dCn[TMERC_BATCH_SIZE], dCe[TMERC_BATCH_SIZE];
+
+    /* ell. LAT, LNG -> Gaussian LAT, LNG */
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        phi[k] = coo[idx[k]].lp.phi;
+        cos_2phi[k] = cos(2 * phi[k]);
+        sin_2phi[k] = sin(2 * phi[k]);
+    }
+    gatg_batch(Q->cbg, PROJ_ETMERC_ORDER, phi, cos_2phi, sin_2phi, Cn);
+
+    /* Gaussian LAT, LNG -> compl. sph. LAT, then ell. norm. N, E */
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        const double lam = coo[idx[k]].lp.lam;
+        const double sin_Cn = sin(Cn[k]);
+        const double cos_Cn = cos(Cn[k]);
+        const double sin_Ce = sin(lam);
+        const double cos_Ce = cos(lam);
+
+        const double cos_Cn_cos_Ce = cos_Cn * cos_Ce;
+        Cn[k] = atan2(sin_Cn, cos_Cn_cos_Ce);
+
+        const double inv_denom_tan_Ce = 1. / hypot(sin_Cn, cos_Cn_cos_Ce);
+        const double tan_Ce = sin_Ce * cos_Cn * inv_denom_tan_Ce;
+        Ce[k] = asinh(tan_Ce);
+
+        /* See exact_e_fwd() for the derivation of the following */
+        const double two_inv_denom_tan_Ce = 2 * inv_denom_tan_Ce;
+        const double two_inv_denom_tan_Ce_square =
+            two_inv_denom_tan_Ce * inv_denom_tan_Ce;
+        const double tmp_r = cos_Cn_cos_Ce * two_inv_denom_tan_Ce_square;
+        sin_arg_r[k] = sin_Cn * tmp_r;
+        cos_arg_r[k] = cos_Cn_cos_Ce * tmp_r - 1;
+        sinh_arg_i[k] = tan_Ce * two_inv_denom_tan_Ce;
+        cosh_arg_i[k] = two_inv_denom_tan_Ce_square - 1;
+    }
+    clenS_batch(Q->gtu, PROJ_ETMERC_ORDER, sin_arg_r, cos_arg_r, sinh_arg_i,
+                cosh_arg_i, dCn, dCe);
+
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        PJ_XY &xy = coo[idx[k]].xy;
+        const double N = Cn[k] + dCn[k];
+        const double E = Ce[k] + dCe[k];
+        if (fabs(E) <= 2.623395162778) {
+            xy.y = Q->Qn * N + Q->Zb; /* Northing */
+            xy.x = Q->Qn * E;         /* Easting  */
+        } else {
+            errnos[idx[k]] = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+            xy.x = xy.y = HUGE_VAL;
+        }
+    }
+}
+
+/* Ellipsoidal, inverse, for the coordinates of coo indexed by idx, which
+ * must all be within the 150 degrees limit checked by exact_e_inv() */
+static void exact_e_inv_batch(PJ *P, PJ_COORD *coo, const size_t *idx) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->exact);
+    double Cn[TMERC_BATCH_SIZE], Ce[TMERC_BATCH_SIZE];
+    double sin_arg_r[TMERC_BATCH_SIZE], cos_arg_r[TMERC_BATCH_SIZE];
+    double sinh_arg_i[TMERC_BATCH_SIZE], cosh_arg_i[TMERC_BATCH_SIZE];
+    double dCn[TMERC_BATCH_SIZE], dCe[TMERC_BATCH_SIZE];
+    double cos_2_Cn[TMERC_BATCH_SIZE], sin_2_Cn[TMERC_BATCH_SIZE];
+    double phi[TMERC_BATCH_SIZE];
+
+    /* normalize N, E, then norm. N, E -> compl. sph. LAT, LNG */
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        const PJ_XY xy = coo[idx[k]].xy;
+        Cn[k] = (xy.y - Q->Zb) / Q->Qn;
+        Ce[k] = xy.x / Q->Qn;
+        sin_arg_r[k] = sin(2 * Cn[k]);
+        cos_arg_r[k] = cos(2 * Cn[k]);
+
+        const double exp_2_Ce = exp(2 * Ce[k]);
+        const double half_inv_exp_2_Ce = 0.5 / exp_2_Ce;
+        sinh_arg_i[k] = 0.5 * exp_2_Ce - half_inv_exp_2_Ce;
+        cosh_arg_i[k] = 0.5 * exp_2_Ce + half_inv_exp_2_Ce;
+    }
+    clenS_batch(Q->utg, PROJ_ETMERC_ORDER, sin_arg_r, cos_arg_r, sinh_arg_i,
+                cosh_arg_i, dCn, dCe);
+
+    /* compl. sph. LAT -> Gaussian LAT, LNG */
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        const double N = Cn[k] + dCn[k];
+        const double E = Ce[k] + dCe[k];
+        const double sin_Cn = sin(N);
+        const double cos_Cn = cos(N);
+
+        /* See exact_e_inv() for the derivation of the following */
+        const double sinhCe = sinh(E);
+        Ce[k] = atan2(sinhCe, cos_Cn);
+        const double modulus_Ce = hypot(sinhCe, cos_Cn);
+        Cn[k] = atan2(sin_Cn, modulus_Ce);
+
+        const double tmp = 2 * modulus_Ce / (sinhCe * sinhCe + 1);
+        sin_2_Cn[k] = sin_Cn * tmp;
+        cos_2_Cn[k] = tmp * modulus_Ce - 1.;
+    }
+
+    /* Gaussian LAT, LNG -> ell. LAT, LNG */
+    gatg_batch(Q->cgb, PROJ_ETMERC_ORDER, Cn, cos_2_Cn, sin_2_Cn, phi);
+    for (int k = 0; k < TMERC_BATCH_SIZE; k++) {
+        PJ_LP &lp = coo[idx[k]].lp;
+        lp.phi = phi[k];
+        lp.lam = Ce[k];
+    }
+}
+
+/* Forward transformation of an array of coordinates. With use_approx, the
+ * points selected for the approximate algorithm by auto_e_fwd() are
+ * transformed one at a time. */
+static void e_fwd_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos,
+                        bool use_approx) {
+    size_t idx[TMERC_BATCH_SIZE];
+    int m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].xy.x == HUGE_VAL)
+            continue;
+        if (use_approx && !(fabs(coo[i].lp.lam) > 3 * DEG_TO_RAD)) {
+            P->ctx->last_errno = 0;
+            coo[i].xy = approx_e_fwd(coo[i].lp, P);
+            if (coo[i].xy.x == HUGE_VAL)
+                errnos[i] = P->ctx->last_errno;
+            continue;
+        }
+        idx[m++] = i;
+        if (m == TMERC_BATCH_SIZE) {
+            exact_e_fwd_batch(P, coo, idx, errnos);
+            m = 0;
+        }
+    }
+    if (m > 0) {
+        for (int k = m; k < TMERC_BATCH_SIZE; k++)
+            idx[k] = idx[m - 1];
+        exact_e_fwd_batch(P, coo, idx, errnos);
+    }
+}
+
+/* Inverse transformation of an array of coordinates. With use_approx, the
+ * points selected for the approximate algorithm by auto_e_inv() are
+ * transformed one at a time. */
+static void e_inv_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos,
+                        bool use_approx) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->exact);
+    size_t idx[TMERC_BATCH_SIZE];
+    int m = 0;
+    for (size_t i = 0; i < n; i++) {
+        const PJ_XY xy = coo[i].xy;
+        if (xy.x == HUGE_VAL)
+            continue;
+        if (use_approx && !(fabs(xy.x) > 0.053 - 0.022 * xy.y * xy.y)) {
+            P->ctx->last_errno = 0;
+            coo[i].lp = approx_e_inv(xy, P);
+            if (coo[i].lp.lam == HUGE_VAL)
+                errnos[i] = P->ctx->last_errno;
+            continue;
+        }
+        if (!(fabs(xy.x / Q->Qn) <= 2.623395162778)) { /* 150 degrees */
+            errnos[i] = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+            coo[i].lp.phi = coo[i].lp.lam = HUGE_VAL;
+            continue;
+        }
+        idx[m++] = i;
+        if (m == TMERC_BATCH_SIZE) {
+            exact_e_inv_batch(P, coo, idx);
+            m = 0;
+        }
+    }
+    if (m > 0) {
+        for (int k = m; k < TMERC_BATCH_SIZE; k++)
+            idx[k] = idx[m - 1];
+        exact_e_inv_batch(P, coo, idx);
+    }
+}
+
+static void exact_e_fwd_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    e_fwd_array(P, n, coo, errnos, false);
+}
+
+static void exact_e_inv_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    e_inv_array(P, n, coo, errnos, false);
+}
+
+static void auto_e_fwd_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    e_fwd_array(P, n, coo, errnos, true);
+}
+
+static void auto_e_inv_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    e_inv_array(P, n, coo, errnos, true);
+}
+
 static PJ *setup(PJ *P, TMercAlgo eAlg) {
 
     struct tmerc_data *Q =
@@ -621,6 +914,7 @@ static PJ *setup(PJ *P, TMercAlgo eAlg) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = Q;
+    P->clone_opaque = clone_opaque;
 
     if (P->es == 0)
         eAlg = TMercAlgo::EVENDEN_SNYDER;
@@ -644,6 +938,8 @@ static PJ *setup(PJ *P, TMercAlgo eAlg) {
         setup_exact(P);
         P->inv = exact_e_inv;
         P->fwd = exact_e_fwd;
+        P->inv_array = exact_e_inv_array;
+        P->fwd_array = exact_e_fwd_array;
         break;
     }
 
@@ -655,6 +951,8 @@ static PJ *setup(PJ *P, TMercAlgo eAlg) {
 
         P->inv = auto_e_inv;
         P->fwd = auto_e_fwd;
+        P->inv_array = auto_e_inv_array;
+        P->fwd_array = auto_e_fwd_array;
         break;
     }
     }
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Pool of worker threads attached to a context
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "thread_pool.hpp"
+#include "proj_internal.h"
+
+#include <new>
+#include <system_error>
+
+// ---------------------------------------------------------------------------
+
+projThreadPool::projThreadPool(size_t maxThreads) : m_maxThreads(maxThreads) {}
+
+// ---------------------------------------------------------------------------
+
+projThreadPool::~projThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_tasks.clear();
+    }
+    m_cv.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+bool projThreadPool::submit(std::function<void()> &&task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_idleThreads <= m_tasks.size() && m_threads.size() < m_maxThreads) {
+        try {
+            m_threads.emplace_back(&projThreadPool::run, this);
+        } catch (const std::system_error &) {
+            // Go on with the threads already started
+        }
+    }
+    if (m_threads.empty())
+        return false;
+    m_tasks.emplace_back(std::move(task));
+    m_cv.notify_one();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+void projThreadPool::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        ++m_idleThreads;
+        pj_cv_wait(m_cv, lock,
+                   [this] { return m_stop || !m_tasks.empty(); });
+        --m_idleThreads;
+        if (m_stop)
+            return;
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void pj_thread_pool_destroy(projThreadPool *pool) { delete pool; }
+
+// ---------------------------------------------------------------------------
+
+projThreadPool *pj_ctx_get_thread_pool(PJ_CONTEXT *ctx) {
+    if (ctx == nullptr || ctx == pj_get_default_ctx())
+        return nullptr;
+    if (ctx->threadPool == nullptr) {
+        // The calling thread does its share of the work. Keep at least one
+        // thread, so that it can wait for I/O while the other one computes.
+        const unsigned nCPUs = std::thread::hardware_concurrency();
+        ctx->threadPool =
+            new (std::nothrow) projThreadPool(nCPUs > 2 ? nCPUs - 1 : 1);
+    }
+    return ctx->threadPool;
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Pool of worker threads attached to a context
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef THREAD_POOL_HPP_INCLUDED
+#define THREAD_POOL_HPP_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "proj.h"
+
+//! @cond Doxygen_Suppress
+
+// ---------------------------------------------------------------------------
+
+// Pool of worker threads owned by a context, obtained with
+// pj_ctx_get_thread_pool(). Threads are started on demand, up to a maximum
+// count, and joined when the context is destroyed.
+//
+// Tasks that have not started when the pool is destroyed are discarded. The
+// thread submitting tasks must thus never wait for a task that has not
+// started: it is expected to process the same work itself, tasks only
+// helping it when pool threads are available.
+struct projThreadPool {
+    explicit projThreadPool(size_t maxThreads);
+    ~projThreadPool();
+
+    size_t maxThreads() const { return m_maxThreads; }
+
+    // Queue a task. Returns false if no thread could run it.
+    bool submit(std::function<void()> &&task);
+
+  private:
+    const size_t m_maxThreads;
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::deque<std::function<void()>> m_tasks{};
+    std::vector<std::thread> m_threads{};
+    size_t m_idleThreads = 0;
+    bool m_stop = false;
+
+    projThreadPool(const projThreadPool &) = delete;
+    projThreadPool &operator=(const projThreadPool &) = delete;
+
+    void run();
+};
+
+// ---------------------------------------------------------------------------
+
+// Wait until pred() is true. condition_variable::wait() is avoided, as
+// binaries built with GCC >= 12 would then require libstdc++ >= 12.
+template <class Predicate>
+void pj_cv_wait(std::condition_variable &cv,
+                std::unique_lock<std::mutex> &lock, Predicate pred) {
+    while (!cv.wait_for(lock, std::chrono::seconds(1), pred)) {
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Return the thread pool of the context, or nullptr if it has none. The
+// default context has no thread pool, as its threads would have to be joined
+// when the library is unloaded.
+projThreadPool *pj_ctx_get_thread_pool(PJ_CONTEXT *ctx);
+
+//! @endcond
+
+#endif // THREAD_POOL_HPP_INCLUDED
@@ -176,11 +176,50 @@ static void computeReverseParameters(PJ *P) {
     }
 }
 
+static bool get_affine_coeffs(const PJ *P, PJ_DIRECTION direction,
+                              PJ_AFFINE_COEFFS &coeffs) {
+    const struct pj_opaque_affine *Q =
+        (const struct pj_opaque_affine *)P->opaque;
+    const double off[3] = {Q->xoff, Q->yoff, Q->zoff};
+    if (direction == PJ_FWD) {
+        const struct pj_affine_coeffs *C = &(Q->forward);
+        const double m[3][3] = {{C->s11, C->s12, C->s13},
+                                {C->s21, C->s22, C->s23},
+                                {C->s31, C->s32, C->s33}};
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j)
+                coeffs.matrix[i][j] = m[i][j];
+            coeffs.offset[i] = off[i];
+        }
+        coeffs.tscale = C->tscale;
+        coeffs.toff = Q->toff;
+        return true;
+    }
+
+    if (P->inv4d == nullptr)
+        return false;
+    const struct pj_affine_coeffs *C = &(Q->reverse);
+    const double m[3][3] = {{C->s11, C->s12, C->s13},
+                            {C->s21, C->s22, C->s23},
+                            {C->s31, C->s32, C->s33}};
+    for (int i = 0; i < 3; ++i) {
+        coeffs.offset[i] = 0;
+        for (int j = 0; j < 3; ++j) {
+            coeffs.matrix[i][j] = m[i][j];
+            coeffs.offset[i] -= m[i][j] * off[j];
+        }
+    }
+    coeffs.tscale = C->tscale;
+    coeffs.toff = -C->tscale * Q->toff;
+    return true;
+}
+
 PJ *PJ_TRANSFORMATION(affine, 0 /* no need for ellipsoid */) {
     struct pj_opaque_affine *Q = initQ();
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = (void *)Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_opaque_affine>;
 
     P->fwd4d = forward_4d;
     P->inv4d = reverse_4d;
@@ -188,6 +227,7 @@ PJ *PJ_TRANSFORMATION(affine, 0 /* no need for ellipsoid */) {
     P->inv3d = reverse_3d;
     P->fwd = forward_2d;
     P->inv = reverse_2d;
+    P->get_affine_coeffs = get_affine_coeffs;
 
     P->left = PJ_IO_UNITS_WHATEVER;
     P->right = PJ_IO_UNITS_WHATEVER;
@@ -222,6 +262,37 @@ PJ *PJ_TRANSFORMATION(affine, 0 /* no need for ellipsoid */) {
     return P;
 }
 
+/*****************************************************************************/
+PJ *pj_create_affine(PJ_CONTEXT *ctx, const PJ_AFFINE_COEFFS &coeffs) {
+    /*****************************************************************************
+        Instantiate an affine operation directly from its coefficients, without
+        a round-trip through their textual representation.
+    ******************************************************************************/
+    PJ *P = pj_create_internal(ctx, "proj=affine");
+    if (nullptr == P)
+        return nullptr;
+
+    struct pj_opaque_affine *Q = (struct pj_opaque_affine *)P->opaque;
+    Q->xoff = coeffs.offset[0];
+    Q->yoff = coeffs.offset[1];
+    Q->zoff = coeffs.offset[2];
+    Q->toff = coeffs.toff;
+    Q->forward.s11 = coeffs.matrix[0][0];
+    Q->forward.s12 = coeffs.matrix[0][1];
+    Q->forward.s13 = coeffs.matrix[0][2];
+    Q->forward.s21 = coeffs.matrix[1][0];
+    Q->forward.s22 = coeffs.matrix[1][1];
+    Q->forward.s23 = coeffs.matrix[1][2];
+    Q->forward.s31 = coeffs.matrix[2][0];
+    Q->forward.s32 = coeffs.matrix[2][1];
+    Q->forward.s33 = coeffs.matrix[2][2];
+    Q->forward.tscale = coeffs.tscale;
+
+    computeReverseParameters(P);
+
+    return P;
+}
+
 /* Arcsecond to radians */
 #define ARCSEC_TO_RAD (DEG_TO_RAD / 3600.0)
 
@@ -230,6 +301,7 @@ PJ *PJ_TRANSFORMATION(geogoffset, 0 /* no need for ellipsoid */) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = (void *)Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_opaque_affine>;
 
     P->fwd4d = forward_4d;
     P->inv4d = reverse_4d;
@@ -234,6 +234,11 @@ struct GridSet : public GridSetPrototype<Grid> {
         return iter->second.get();
     }
 
+    bool prefetch(double minx, double miny, double maxx, double maxy,
+                  size_t &bytesLoaded) {
+        return realGridSet->prefetch(minx, miny, maxx, maxy, bytesLoaded);
+    }
+
   private:
     GridSet(const GridSet &) = delete;
     GridSet &operator=(const GridSet &) = delete;
@@ -358,6 +363,24 @@ static void forward_4d(PJ_COORD &coo, PJ *P) {
     }
 }
 
+// Array variant of forward_4d(), so that time series at a station share
+// the grid lookups.
+static void forward_array(PJ *P, size_t n, PJ_COORD *coo, int *errnos) {
+    auto *Q = (struct defmodelData *)P->opaque;
+
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].xyzt.x != HUGE_VAL && coo[i].xyzt.t == HUGE_VAL) {
+            coo[i] = proj_coord_error();
+            errnos[i] = PROJ_ERR_COORD_TRANSFM_MISSING_TIME;
+        }
+    }
+    if (n == 0)
+        return;
+    Q->evaluator->forward(Q->evaluatorIface, n, &coo[0].xyzt.x, 4,
+                          &coo[0].xyzt.y, 4, &coo[0].xyzt.z, 4,
+                          &coo[0].xyzt.t, 4);
+}
+
 static void reverse_4d(PJ_COORD &coo, PJ *P) {
     auto *Q = (struct defmodelData *)P->opaque;
 
@@ -385,6 +408,17 @@ static void reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     }
 }
 
+static bool prepare_for_area(PJ *P, PJ_DIRECTION,
+                             const std::vector<PJ_COORD> &points,
+                             size_t &bytesLoaded) {
+    auto *Q = (struct defmodelData *)P->opaque;
+    double minx, miny, maxx, maxy;
+    if (!NS_PROJ::pj_get_points_extent(points, minx, miny, maxx, maxy))
+        return true;
+    return Q->evaluator->prefetch(Q->evaluatorIface, minx, miny, maxx, maxy,
+                                  bytesLoaded);
+}
+
 PJ *PJ_TRANSFORMATION(defmodel, 1) {
     // Pass a dummy ellipsoid definition that will be overridden just afterwards
     auto cart = proj_create(P->ctx, "+proj=cart +a=1");
@@ -398,6 +432,7 @@ PJ *PJ_TRANSFORMATION(defmodel, 1) {
     P->opaque = (void *)Q;
     P->destructor = destructor;
     P->reassign_context = reassign_context;
+    P->prepare_for_area = prepare_for_area;
 
     const char *model = pj_param(P->ctx, P->params, "smodel").s;
     if (!model) {
@@ -437,6 +472,7 @@ PJ *PJ_TRANSFORMATION(defmodel, 1) {
 
     P->fwd4d = forward_4d;
     P->inv4d = reverse_4d;
+    P->fwd_array = forward_array;
 
     if (Q->evaluator->isGeographicCRS()) {
         P->left = PJ_IO_UNITS_RADIANS;
@@ -536,6 +536,14 @@ template <class Grid = GridPrototype> struct GridSetPrototype {
     const Grid *gridAt(double /*x */, double /* y */) {
         throw UnimplementedException("gridAt unimplemented");
     }
+
+    // Optional. Load in memory the data needed to evaluate the grids in the
+    // specified area, adding its size to bytesLoaded.
+    // cppcheck-suppress functionStatic
+    bool prefetch(double /* minx */, double /* miny */, double /* maxx */,
+                  double /* maxy */, size_t & /* bytesLoaded */) {
+        return true;
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -600,19 +608,47 @@ class Evaluator {
      */
     bool forward(EvaluatorIface &iface, double x, double y, double z, double t,
                  double &x_out, double &y_out, double &z_out) {
-        return forward(iface, x, y, z, t, false, x_out, y_out, z_out);
+        return forward(iface, x, y, z, t, false, nullptr, x_out, y_out,
+                       z_out);
     }
 
+    /** Evaluate displacement of an array of count positions, in place.
+     * The i-th position is read from x[i * strideX], y[i * strideY],
+     * z[i * strideZ] and t[i * strideT] (strides being expressed in number
+     * of doubles), and is overwritten with the result, or with HUGE_VAL if
+     * it cannot be transformed.
+     * Positions sharing the same (x,y) (time series at a station) share the
+     * grid lookups and interpolation, and positions sharing the same epoch
+     * share the evaluation of time functions, whatever their order in the
+     * arrays.
+     * Returns the number of positions successfully transformed.
+     */
+    size_t forward(EvaluatorIface &iface, size_t count, double *x,
+                   size_t strideX, double *y, size_t strideY, double *z,
+                   size_t strideZ, const double *t, size_t strideT);
+
     /** Apply inverse transformation. */
     bool inverse(EvaluatorIface &iface, double x, double y, double z, double t,
                  double &x_out, double &y_out, double &z_out);
 
+    /** Open the grids of the components whose extent intersects the area
+     * (minx, miny, maxx, maxy), expressed like the positions passed to
+     * forward(), and load in memory the data needed to evaluate them in
+     * that area. The size of the data loaded is added to bytesLoaded.
+     */
+    bool prefetch(EvaluatorIface &iface, double minx, double miny,
+                  double maxx, double maxy, size_t &bytesLoaded);
+
     /** Clear grid cache */
     void clearGridCache();
 
     /** Return whether the definition CRS is a geographic CRS */
     bool isGeographicCRS() const { return mIsGeographicCRS; }
 
+    /** Return the number of evaluations of the time functions of the
+     * components so far. Mostly for testing. */
+    size_t timeFunctionEvaluationCount() const;
+
   private:
     std::unique_ptr<MasterFile> mModel;
     const double mA;
@@ -622,9 +658,15 @@ class Evaluator {
     const bool mIsAddition;             /* addition vs geocentric */
     const bool mIsGeographicCRS;
 
+    bool isValidEpoch(double t) const;
+
+    bool evaluateSpatial(EvaluatorIface &iface,
+                         ComponentEx<Grid, GridSet> &compEx, double x, double y,
+                         bool forInverseComputation);
+
     bool forward(EvaluatorIface &iface, double x, double y, double z, double t,
-                 bool forInverseComputation, double &x_out, double &y_out,
-                 double &z_out);
+                 bool forInverseComputation, const double *tfactors,
+                 double &x_out, double &y_out, double &z_out);
 
     std::vector<std::unique_ptr<ComponentEx<Grid, GridSet>>> mComponents{};
 };
@@ -181,9 +181,28 @@ template <class Grid, class GridSet> struct ComponentEx {
     std::unique_ptr<GridSet> gridSet{};
     std::map<const Grid *, GridEx<Grid>> mapGrids{};
 
+    /** Result of the grid interpolation at the last evaluated position.
+     * This only depends on the position, not on the epoch, so it can be
+     * reused for all epochs of a time series at a given station. */
+    struct SpatialEvaluation {
+        bool valid = false;
+        bool forInverseComputation = false;
+        double x = 0;
+        double y = 0;
+        // Whether the component does not apply at this position
+        bool skip = false;
+        // Interpolated horizontal offsets, either (dlam, dphi) or (de, dn)
+        // depending on the horizontal offset unit
+        double dx = 0;
+        double dy = 0;
+        double dz = 0;
+    };
+    SpatialEvaluation lastSpatialEvaluation{};
+
   private:
     mutable double mCachedDt = 0;
     mutable double mCachedValue = 0;
+    mutable size_t mEvaluationCount = 0;
 
     static DisplacementType getDisplacementType(const std::string &s) {
         if (s == STR_HORIZONTAL)
@@ -207,12 +226,16 @@ template <class Grid, class GridSet> struct ComponentEx {
             return mCachedValue;
         mCachedDt = dt;
         mCachedValue = component.timeFunction()->evaluateAt(dt);
+        ++mEvaluationCount;
         return mCachedValue;
     }
 
+    size_t evaluationCount() const { return mEvaluationCount; }
+
     void clearGridCache() {
         gridSet.reset();
         mapGrids.clear();
+        lastSpatialEvaluation.valid = false;
     }
 };
 
@@ -762,6 +785,50 @@ void Evaluator<Grid, GridSet, EvaluatorIface>::clearGridCache() {
 
 // ---------------------------------------------------------------------------
 
+template <class Grid, class GridSet, class EvaluatorIface>
+bool Evaluator<Grid, GridSet, EvaluatorIface>::prefetch(
+    EvaluatorIface &iface, double minx, double miny, double maxx, double maxy,
+    size_t &bytesLoaded) {
+    bool ret = true;
+    for (auto &compEx : mComponents) {
+        const auto &comp = compEx->component;
+        const auto &extent = comp.extent();
+        const double compMinx = extent.minxNormalized(mIsGeographicCRS);
+        const double compMiny = extent.minyNormalized(mIsGeographicCRS);
+        const double compMaxx = extent.maxxNormalized(mIsGeographicCRS);
+        const double compMaxy = extent.maxyNormalized(mIsGeographicCRS);
+        if (maxx < compMinx || minx > compMaxx || maxy < compMiny ||
+            miny > compMaxy) {
+            continue;
+        }
+        if (compEx->gridSet == nullptr) {
+            compEx->gridSet = iface.open(comp.spatialModel().filename);
+            if (compEx->gridSet == nullptr) {
+                ret = false;
+                continue;
+            }
+        }
+        if (!compEx->gridSet->prefetch(
+                std::max(minx, compMinx), std::max(miny, compMiny),
+                std::min(maxx, compMaxx), std::min(maxy, compMaxy),
+                bytesLoaded)) {
+            ret = false;
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+
+template <class Grid, class GridSet, class EvaluatorIface>
+bool Evaluator<Grid, GridSet, EvaluatorIface>::isValidEpoch(double t) const {
+    const auto &timeExtent = mModel->timeExtent();
+    return t >= timeExtent.first.toDecimalYear() &&
+           t <= timeExtent.last.toDecimalYear();
+}
+
+// ---------------------------------------------------------------------------
+
 #ifdef DEBUG_DEFMODEL
 
 static std::string shortName(const Component &comp) {
@@ -819,10 +886,230 @@ static bool bboxCheck(double &x, double &y, bool forInverseComputation,
 
 // ---------------------------------------------------------------------------
 
+template <class Grid, class GridSet, class EvaluatorIface>
+bool Evaluator<Grid, GridSet, EvaluatorIface>::evaluateSpatial(
+    EvaluatorIface &iface, ComponentEx<Grid, GridSet> &compEx, double x,
+    double y, bool forInverseComputation) {
+
+    auto &res = compEx.lastSpatialEvaluation;
+    if (res.valid && res.x == x && res.y == y &&
+        res.forInverseComputation == forInverseComputation) {
+        return true;
+    }
+    res.valid = false;
+    res.forInverseComputation = forInverseComputation;
+    res.x = x;
+    res.y = y;
+    res.skip = true;
+    res.dx = 0;
+    res.dy = 0;
+    res.dz = 0;
+
+    const double EPS = mIsGeographicCRS ? 1e-10 : 1e-5;
+
+    const auto &comp = compEx.component;
+    const auto &extent = comp.extent();
+    double xForGrid = x;
+    double yForGrid = y;
+    const double minx = extent.minxNormalized(mIsGeographicCRS);
+    const double maxx = extent.maxxNormalized(mIsGeographicCRS);
+    const double miny = extent.minyNormalized(mIsGeographicCRS);
+    const double maxy = extent.maxyNormalized(mIsGeographicCRS);
+    const double extraMarginForInverse = 0;
+    if (!bboxCheck(xForGrid, yForGrid, forInverseComputation, minx, miny, maxx,
+                   maxy, EPS, extraMarginForInverse)) {
+#ifdef DEBUG_DEFMODEL
+        iface.log(
+            "Skipping component " + shortName(comp) +
+            " due to point being outside of its declared spatial extent.");
+#endif
+        res.valid = true;
+        return true;
+    }
+    xForGrid = std::max(xForGrid, minx);
+    yForGrid = std::max(yForGrid, miny);
+    xForGrid = std::min(xForGrid, maxx);
+    yForGrid = std::min(yForGrid, maxy);
+
+    if (compEx.gridSet == nullptr) {
+        compEx.gridSet = iface.open(comp.spatialModel().filename);
+        if (compEx.gridSet == nullptr) {
+            return false;
+        }
+    }
+    const Grid *grid = compEx.gridSet->gridAt(xForGrid, yForGrid);
+    if (grid == nullptr) {
+#ifdef DEBUG_DEFMODEL
+        iface.log("Skipping component " + shortName(comp) +
+                  " due to no grid found for this point in the grid set.");
+#endif
+        res.valid = true;
+        return true;
+    }
+    if (grid->width < 2 || grid->height < 2) {
+        return false;
+    }
+    const double ix_d = (xForGrid - grid->minx) / grid->resx;
+    const double iy_d = (yForGrid - grid->miny) / grid->resy;
+    if (ix_d < -EPS || iy_d < -EPS || ix_d + 1 >= grid->width + EPS ||
+        iy_d + 1 >= grid->height + EPS) {
+#ifdef DEBUG_DEFMODEL
+        iface.log("Skipping component " + shortName(comp) +
+                  " due to point being outside of actual spatial extent of "
+                  "grid " +
+                  grid->name() + ".");
+#endif
+        res.valid = true;
+        return true;
+    }
+    const int ix0 = std::min(static_cast<int>(ix_d), grid->width - 2);
+    const int iy0 = std::min(static_cast<int>(iy_d), grid->height - 2);
+    const int ix1 = ix0 + 1;
+    const int iy1 = iy0 + 1;
+    const double frct_x = ix_d - ix0;
+    const double frct_y = iy_d - iy0;
+    const double one_minus_frct_x = 1. - frct_x;
+    const double one_minus_frct_y = 1. - frct_y;
+    const double m00 = one_minus_frct_x * one_minus_frct_y;
+    const double m10 = frct_x * one_minus_frct_y;
+    const double m01 = one_minus_frct_x * frct_y;
+    const double m11 = frct_x * frct_y;
+
+    if (compEx.displacementType == DisplacementType::VERTICAL) {
+        double dz00 = 0;
+        double dz01 = 0;
+        double dz10 = 0;
+        double dz11 = 0;
+        if (!grid->getZOffset(ix0, iy0, dz00) ||
+            !grid->getZOffset(ix1, iy0, dz10) ||
+            !grid->getZOffset(ix0, iy1, dz01) ||
+            !grid->getZOffset(ix1, iy1, dz11)) {
+            return false;
+        }
+        res.dz = dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
+    } else if (mIsHorizontalUnitDegree) {
+        double dx00 = 0;
+        double dy00 = 0;
+        double dx01 = 0;
+        double dy01 = 0;
+        double dx10 = 0;
+        double dy10 = 0;
+        double dx11 = 0;
+        double dy11 = 0;
+        if (compEx.displacementType == DisplacementType::HORIZONTAL) {
+            if (!grid->getLongLatOffset(ix0, iy0, dx00, dy00) ||
+                !grid->getLongLatOffset(ix1, iy0, dx10, dy10) ||
+                !grid->getLongLatOffset(ix0, iy1, dx01, dy01) ||
+                !grid->getLongLatOffset(ix1, iy1, dx11, dy11)) {
+                return false;
+            }
+        } else /* if (compEx.displacementType == DisplacementType::THREE_D) */
+        {
+            double dz00 = 0;
+            double dz01 = 0;
+            double dz10 = 0;
+            double dz11 = 0;
+            if (!grid->getLongLatZOffset(ix0, iy0, dx00, dy00, dz00) ||
+                !grid->getLongLatZOffset(ix1, iy0, dx10, dy10, dz10) ||
+                !grid->getLongLatZOffset(ix0, iy1, dx01, dy01, dz01) ||
+                !grid->getLongLatZOffset(ix1, iy1, dx11, dy11, dz11)) {
+                return false;
+            }
+            res.dz = dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
+        }
+        res.dx = dx00 * m00 + dx01 * m01 + dx10 * m10 + dx11 * m11;
+        res.dy = dy00 * m00 + dy01 * m01 + dy10 * m10 + dy11 * m11;
+    } else /* horizontal unit is metre */ {
+        double de00 = 0;
+        double dn00 = 0;
+        double de01 = 0;
+        double dn01 = 0;
+        double de10 = 0;
+        double dn10 = 0;
+        double de11 = 0;
+        double dn11 = 0;
+        if (compEx.displacementType == DisplacementType::HORIZONTAL) {
+            if (!grid->getEastingNorthingOffset(ix0, iy0, de00, dn00) ||
+                !grid->getEastingNorthingOffset(ix1, iy0, de10, dn10) ||
+                !grid->getEastingNorthingOffset(ix0, iy1, de01, dn01) ||
+                !grid->getEastingNorthingOffset(ix1, iy1, de11, dn11)) {
+                return false;
+            }
+        } else /* if (compEx.displacementType == DisplacementType::THREE_D) */
+        {
+            double dz00 = 0;
+            double dz01 = 0;
+            double dz10 = 0;
+            double dz11 = 0;
+            if (!grid->getEastingNorthingZOffset(ix0, iy0, de00, dn00, dz00) ||
+                !grid->getEastingNorthingZOffset(ix1, iy0, de10, dn10, dz10) ||
+                !grid->getEastingNorthingZOffset(ix0, iy1, de01, dn01, dz01) ||
+                !grid->getEastingNorthingZOffset(ix1, iy1, de11, dn11, dz11)) {
+                return false;
+            }
+            res.dz = dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
+        }
+        if (compEx.isBilinearInterpolation) {
+            res.dx = de00 * m00 + de01 * m01 + de10 * m10 + de11 * m11;
+            res.dy = dn00 * m00 + dn01 * m01 + dn10 * m10 + dn11 * m11;
+        } else /* geocentric_bilinear */ {
+            double dX;
+            double dY;
+            double dZ;
+
+            auto iter = compEx.mapGrids.find(grid);
+            if (iter == compEx.mapGrids.end()) {
+                GridEx<Grid> gridWithCache(grid);
+                iter = compEx.mapGrids
+                           .insert(std::pair<const Grid *, GridEx<Grid>>(
+                               grid, std::move(gridWithCache)))
+                           .first;
+            }
+            GridEx<Grid> &gridwithCacheRef = iter->second;
+
+            gridwithCacheRef.getBilinearGeocentric(
+                ix0, iy0, de00, dn00, de01, dn01, de10, dn10, de11, dn11, m00,
+                m01, m10, m11, dX, dY, dZ);
+            const double sinphi = sin(y);
+            const double cosphi = cos(y);
+            const double lam_rel_to_cell_center = (frct_x - 0.5) * grid->resx;
+            // Use small-angle approximation of sin/cos when reasonable
+            // Max abs/rel error on cos is 3.9e-9 and on sin 1.3e-11
+            const double sinlam =
+                gridwithCacheRef.smallResx
+                    ? lam_rel_to_cell_center *
+                          (1 - (1. / 6) * (lam_rel_to_cell_center *
+                                           lam_rel_to_cell_center))
+                    : sin(lam_rel_to_cell_center);
+            const double coslam = gridwithCacheRef.smallResx
+                                      ? (1 - 0.5 * (lam_rel_to_cell_center *
+                                                    lam_rel_to_cell_center))
+                                      : cos(lam_rel_to_cell_center);
+
+            // Convert back from geocentric deltas to easting, northing
+            // deltas
+            res.dx = -dX * sinlam + dY * coslam;
+            res.dy = (-dX * coslam - dY * sinlam) * sinphi + dZ * cosphi;
+#ifdef DEBUG_DEFMODEL
+            iface.log("After geocentric_bilinear interpolation: deInterp = " +
+                      toString(res.dx) + ", dnInterp = " + toString(res.dy) +
+                      ".");
+#endif
+        }
+    }
+
+    res.skip = false;
+    res.valid = true;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 template <class Grid, class GridSet, class EvaluatorIface>
 bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
     EvaluatorIface &iface, double x, double y, double z, double t,
-    bool forInverseComputation, double &x_out, double &y_out, double &z_out)
+    bool forInverseComputation, const double *tfactors, double &x_out,
+    double &y_out, double &z_out)
 
 {
     x_out = x;
@@ -831,6 +1118,10 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
 
     const double EPS = mIsGeographicCRS ? 1e-10 : 1e-5;
 
+    if (!std::isfinite(x) || !std::isfinite(y)) {
+        return false;
+    }
+
     // Check against global model spatial extent, potentially wrapping
     // longitude to match
     {
@@ -860,16 +1151,12 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
     }
 
     // Check against global model temporal extent
-    {
-        const auto &timeExtent = mModel->timeExtent();
-        if (t < timeExtent.first.toDecimalYear() ||
-            t > timeExtent.last.toDecimalYear()) {
+    if (!isValidEpoch(t)) {
 #ifdef DEBUG_DEFMODEL
-            iface.log("Calculation epoch " + toString(t) +
-                      " is not valid for the deformation model");
+        iface.log("Calculation epoch " + toString(t) +
+                  " is not valid for the deformation model");
 #endif
-            return false;
-        }
+        return false;
     }
 
     // For mIsHorizontalUnitDegree
@@ -882,268 +1169,56 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
 
     double dz = 0;
 
-    bool sincosphiInitialized = false;
-    double sinphi = 0;
-    double cosphi = 0;
-
-    for (auto &compEx : mComponents) {
-        const auto &comp = compEx->component;
+    for (size_t i = 0; i < mComponents.size(); ++i) {
+        auto &compEx = mComponents[i];
         if (compEx->displacementType == DisplacementType::NONE) {
             continue;
         }
-        const auto &extent = comp.extent();
-        double xForGrid = x;
-        double yForGrid = y;
-        const double minx = extent.minxNormalized(mIsGeographicCRS);
-        const double maxx = extent.maxxNormalized(mIsGeographicCRS);
-        const double miny = extent.minyNormalized(mIsGeographicCRS);
-        const double maxy = extent.maxyNormalized(mIsGeographicCRS);
-        const double extraMarginForInverse = 0;
-        if (!bboxCheck(xForGrid, yForGrid, forInverseComputation, minx, miny,
-                       maxx, maxy, EPS, extraMarginForInverse)) {
-#ifdef DEBUG_DEFMODEL
-            iface.log(
-                "Skipping component " + shortName(comp) +
-                " due to point being outside of its declared spatial extent.");
-#endif
-            continue;
-        }
-        xForGrid = std::max(xForGrid, minx);
-        yForGrid = std::max(yForGrid, miny);
-        xForGrid = std::min(xForGrid, maxx);
-        yForGrid = std::min(yForGrid, maxy);
-        const auto tfactor = compEx->evaluateAt(t);
+        const auto tfactor = tfactors ? tfactors[i] : compEx->evaluateAt(t);
         if (tfactor == 0.0) {
 #ifdef DEBUG_DEFMODEL
-            iface.log("Skipping component " + shortName(comp) +
+            iface.log("Skipping component " + shortName(compEx->component) +
                       " due to time function evaluating to 0.");
 #endif
             continue;
         }
 
+        if (!evaluateSpatial(iface, *compEx, x, y, forInverseComputation)) {
+            return false;
+        }
+        const auto &interp = compEx->lastSpatialEvaluation;
+        if (interp.skip) {
+            continue;
+        }
+
 #ifdef DEBUG_DEFMODEL
-        iface.log("Entering component " + shortName(comp) +
+        iface.log("Entering component " + shortName(compEx->component) +
                   " with time function evaluating to " + toString(tfactor) +
                   ".");
 #endif
 
-        if (compEx->gridSet == nullptr) {
-            compEx->gridSet = iface.open(comp.spatialModel().filename);
-            if (compEx->gridSet == nullptr) {
-                return false;
-            }
-        }
-        const Grid *grid = compEx->gridSet->gridAt(xForGrid, yForGrid);
-        if (grid == nullptr) {
+        if (compEx->displacementType != DisplacementType::HORIZONTAL) {
 #ifdef DEBUG_DEFMODEL
-            iface.log("Skipping component " + shortName(comp) +
-                      " due to no grid found for this point in the grid set.");
+            iface.log("tfactor * dzInterp = " + toString(tfactor) + " * " +
+                      toString(interp.dz) + ".");
 #endif
-            continue;
-        }
-        if (grid->width < 2 || grid->height < 2) {
-            return false;
+            dz += tfactor * interp.dz;
         }
-        const double ix_d = (xForGrid - grid->minx) / grid->resx;
-        const double iy_d = (yForGrid - grid->miny) / grid->resy;
-        if (ix_d < -EPS || iy_d < -EPS || ix_d + 1 >= grid->width + EPS ||
-            iy_d + 1 >= grid->height + EPS) {
-#ifdef DEBUG_DEFMODEL
-            iface.log("Skipping component " + shortName(comp) +
-                      " due to point being outside of actual spatial extent of "
-                      "grid " +
-                      grid->name() + ".");
-#endif
+        if (compEx->displacementType == DisplacementType::VERTICAL) {
             continue;
         }
-        const int ix0 = std::min(static_cast<int>(ix_d), grid->width - 2);
-        const int iy0 = std::min(static_cast<int>(iy_d), grid->height - 2);
-        const int ix1 = ix0 + 1;
-        const int iy1 = iy0 + 1;
-        const double frct_x = ix_d - ix0;
-        const double frct_y = iy_d - iy0;
-        const double one_minus_frct_x = 1. - frct_x;
-        const double one_minus_frct_y = 1. - frct_y;
-        const double m00 = one_minus_frct_x * one_minus_frct_y;
-        const double m10 = frct_x * one_minus_frct_y;
-        const double m01 = one_minus_frct_x * frct_y;
-        const double m11 = frct_x * frct_y;
-
-        if (compEx->displacementType == DisplacementType::VERTICAL) {
-            double dz00 = 0;
-            double dz01 = 0;
-            double dz10 = 0;
-            double dz11 = 0;
-            if (!grid->getZOffset(ix0, iy0, dz00) ||
-                !grid->getZOffset(ix1, iy0, dz10) ||
-                !grid->getZOffset(ix0, iy1, dz01) ||
-                !grid->getZOffset(ix1, iy1, dz11)) {
-                return false;
-            }
-            const double dzInterp =
-                dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
-#ifdef DEBUG_DEFMODEL
-            iface.log("tfactor * dzInterp = " + toString(tfactor) + " * " +
-                      toString(dzInterp) + ".");
-#endif
-            dz += tfactor * dzInterp;
-        } else if (mIsHorizontalUnitDegree) {
-            double dx00 = 0;
-            double dy00 = 0;
-            double dx01 = 0;
-            double dy01 = 0;
-            double dx10 = 0;
-            double dy10 = 0;
-            double dx11 = 0;
-            double dy11 = 0;
-            if (compEx->displacementType == DisplacementType::HORIZONTAL) {
-                if (!grid->getLongLatOffset(ix0, iy0, dx00, dy00) ||
-                    !grid->getLongLatOffset(ix1, iy0, dx10, dy10) ||
-                    !grid->getLongLatOffset(ix0, iy1, dx01, dy01) ||
-                    !grid->getLongLatOffset(ix1, iy1, dx11, dy11)) {
-                    return false;
-                }
-            } else /* if (compEx->displacementType == DisplacementType::THREE_D)
-                    */
-            {
-                double dz00 = 0;
-                double dz01 = 0;
-                double dz10 = 0;
-                double dz11 = 0;
-                if (!grid->getLongLatZOffset(ix0, iy0, dx00, dy00, dz00) ||
-                    !grid->getLongLatZOffset(ix1, iy0, dx10, dy10, dz10) ||
-                    !grid->getLongLatZOffset(ix0, iy1, dx01, dy01, dz01) ||
-                    !grid->getLongLatZOffset(ix1, iy1, dx11, dy11, dz11)) {
-                    return false;
-                }
-                const double dzInterp =
-                    dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
 #ifdef DEBUG_DEFMODEL
-                iface.log("tfactor * dzInterp = " + toString(tfactor) + " * " +
-                          toString(dzInterp) + ".");
+        iface.log("tfactor * dxInterp = " + toString(tfactor) + " * " +
+                  toString(interp.dx) + ".");
+        iface.log("tfactor * dyInterp = " + toString(tfactor) + " * " +
+                  toString(interp.dy) + ".");
 #endif
-                dz += tfactor * dzInterp;
-            }
-            const double dlamInterp =
-                dx00 * m00 + dx01 * m01 + dx10 * m10 + dx11 * m11;
-            const double dphiInterp =
-                dy00 * m00 + dy01 * m01 + dy10 * m10 + dy11 * m11;
-#ifdef DEBUG_DEFMODEL
-            iface.log("tfactor * dlamInterp = " + toString(tfactor) + " * " +
-                      toString(dlamInterp) + ".");
-            iface.log("tfactor * dphiInterp = " + toString(tfactor) + " * " +
-                      toString(dphiInterp) + ".");
-#endif
-            dlam += tfactor * dlamInterp;
-            dphi += tfactor * dphiInterp;
-        } else /* horizontal unit is metre */ {
-            double de00 = 0;
-            double dn00 = 0;
-            double de01 = 0;
-            double dn01 = 0;
-            double de10 = 0;
-            double dn10 = 0;
-            double de11 = 0;
-            double dn11 = 0;
-            if (compEx->displacementType == DisplacementType::HORIZONTAL) {
-                if (!grid->getEastingNorthingOffset(ix0, iy0, de00, dn00) ||
-                    !grid->getEastingNorthingOffset(ix1, iy0, de10, dn10) ||
-                    !grid->getEastingNorthingOffset(ix0, iy1, de01, dn01) ||
-                    !grid->getEastingNorthingOffset(ix1, iy1, de11, dn11)) {
-                    return false;
-                }
-            } else /* if (compEx->displacementType == DisplacementType::THREE_D)
-                    */
-            {
-                double dz00 = 0;
-                double dz01 = 0;
-                double dz10 = 0;
-                double dz11 = 0;
-                if (!grid->getEastingNorthingZOffset(ix0, iy0, de00, dn00,
-                                                     dz00) ||
-                    !grid->getEastingNorthingZOffset(ix1, iy0, de10, dn10,
-                                                     dz10) ||
-                    !grid->getEastingNorthingZOffset(ix0, iy1, de01, dn01,
-                                                     dz01) ||
-                    !grid->getEastingNorthingZOffset(ix1, iy1, de11, dn11,
-                                                     dz11)) {
-                    return false;
-                }
-                const double dzInterp =
-                    dz00 * m00 + dz01 * m01 + dz10 * m10 + dz11 * m11;
-#ifdef DEBUG_DEFMODEL
-                iface.log("tfactor * dzInterp = " + toString(tfactor) + " * " +
-                          toString(dzInterp) + ".");
-#endif
-                dz += tfactor * dzInterp;
-            }
-            if (compEx->isBilinearInterpolation) {
-                const double deInterp =
-                    de00 * m00 + de01 * m01 + de10 * m10 + de11 * m11;
-                const double dnInterp =
-                    dn00 * m00 + dn01 * m01 + dn10 * m10 + dn11 * m11;
-#ifdef DEBUG_DEFMODEL
-                iface.log("tfactor * deInterp = " + toString(tfactor) + " * " +
-                          toString(deInterp) + ".");
-                iface.log("tfactor * dnInterp = " + toString(tfactor) + " * " +
-                          toString(dnInterp) + ".");
-#endif
-                de += tfactor * deInterp;
-                dn += tfactor * dnInterp;
-            } else /* geocentric_bilinear */ {
-                double dX;
-                double dY;
-                double dZ;
-
-                auto iter = compEx->mapGrids.find(grid);
-                if (iter == compEx->mapGrids.end()) {
-                    GridEx<Grid> gridWithCache(grid);
-                    iter = compEx->mapGrids
-                               .insert(std::pair<const Grid *, GridEx<Grid>>(
-                                   grid, std::move(gridWithCache)))
-                               .first;
-                }
-                GridEx<Grid> &gridwithCacheRef = iter->second;
-
-                gridwithCacheRef.getBilinearGeocentric(
-                    ix0, iy0, de00, dn00, de01, dn01, de10, dn10, de11, dn11,
-                    m00, m01, m10, m11, dX, dY, dZ);
-                if (!sincosphiInitialized) {
-                    sincosphiInitialized = true;
-                    sinphi = sin(y);
-                    cosphi = cos(y);
-                }
-                const double lam_rel_to_cell_center =
-                    (frct_x - 0.5) * grid->resx;
-                // Use small-angle approximation of sin/cos when reasonable
-                // Max abs/rel error on cos is 3.9e-9 and on sin 1.3e-11
-                const double sinlam =
-                    gridwithCacheRef.smallResx
-                        ? lam_rel_to_cell_center *
-                              (1 - (1. / 6) * (lam_rel_to_cell_center *
-                                               lam_rel_to_cell_center))
-                        : sin(lam_rel_to_cell_center);
-                const double coslam = gridwithCacheRef.smallResx
-                                          ? (1 - 0.5 * (lam_rel_to_cell_center *
-                                                        lam_rel_to_cell_center))
-                                          : cos(lam_rel_to_cell_center);
-
-                // Convert back from geocentric deltas to easting, northing
-                // deltas
-                const double deInterp = -dX * sinlam + dY * coslam;
-                const double dnInterp =
-                    (-dX * coslam - dY * sinlam) * sinphi + dZ * cosphi;
-#ifdef DEBUG_DEFMODEL
-                iface.log("After geocentric_bilinear interpolation: tfactor * "
-                          "deInterp = " +
-                          toString(tfactor) + " * " + toString(deInterp) + ".");
-                iface.log("After geocentric_bilinear interpolation: tfactor * "
-                          "dnInterp = " +
-                          toString(tfactor) + " * " + toString(dnInterp) + ".");
-#endif
-                de += tfactor * deInterp;
-                dn += tfactor * dnInterp;
-            }
+        if (mIsHorizontalUnitDegree) {
+            dlam += tfactor * interp.dx;
+            dphi += tfactor * interp.dy;
+        } else {
+            de += tfactor * interp.dx;
+            dn += tfactor * interp.dy;
         }
     }
 
@@ -1162,9 +1237,7 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
             y_out += dn;
         } else if (mIsAddition) {
             // Simple way of adding the offset
-            if (!sincosphiInitialized) {
-                cosphi = cos(y);
-            }
+            const double cosphi = cos(y);
             DeltaEastingNorthingToLongLat(cosphi, de, dn, mA, mB, mEs, dlam,
                                           dphi);
 #ifdef DEBUG_DEFMODEL
@@ -1175,10 +1248,8 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
             y_out += dphi;
         } else {
             // Geocentric way of adding the offset
-            if (!sincosphiInitialized) {
-                sinphi = sin(y);
-                cosphi = cos(y);
-            }
+            const double sinphi = sin(y);
+            const double cosphi = cos(y);
             const double sinlam = sin(x);
             const double coslam = cos(x);
             const double dnsinphi = dn * sinphi;
@@ -1219,6 +1290,109 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::forward(
 
 // ---------------------------------------------------------------------------
 
+template <class Grid, class GridSet, class EvaluatorIface>
+size_t Evaluator<Grid, GridSet, EvaluatorIface>::forward(
+    EvaluatorIface &iface, size_t count, double *x, size_t strideX, double *y,
+    size_t strideY, double *z, size_t strideZ, const double *t,
+    size_t strideT) {
+
+    // Visit points station by station, so that consecutive evaluations at
+    // the same horizontal position hit the spatial interpolation cache of
+    // each component. Points with a NaN coordinate cannot be ordered, so they
+    // are left aside and evaluated last.
+    std::vector<size_t> order;
+    order.reserve(count);
+    std::vector<size_t> unordered;
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(x[i * strideX]) || std::isnan(y[i * strideY])) {
+            unordered.push_back(i);
+        } else {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [x, strideX, y, strideY](size_t a, size_t b) {
+                         const double xa = x[a * strideX];
+                         const double xb = x[b * strideX];
+                         if (xa != xb) {
+                             return xa < xb;
+                         }
+                         return y[a * strideY] < y[b * strideY];
+                     });
+    order.insert(order.end(), unordered.begin(), unordered.end());
+
+    // Evaluate the time functions of all components once per distinct epoch,
+    // before visiting the stations, as the points sharing an epoch are
+    // spread over the stations.
+    std::vector<double> epochs;
+    for (size_t i = 0; i < count; ++i) {
+        const double tVal = t[i * strideT];
+        if (isValidEpoch(tVal)) {
+            epochs.push_back(tVal);
+        }
+    }
+    std::sort(epochs.begin(), epochs.end());
+    epochs.erase(std::unique(epochs.begin(), epochs.end()), epochs.end());
+    const size_t nComponents = mComponents.size();
+    std::vector<double> tfactors(epochs.size() * nComponents);
+    for (size_t iEpoch = 0; iEpoch < epochs.size(); ++iEpoch) {
+        for (size_t iComp = 0; iComp < nComponents; ++iComp) {
+            const auto &compEx = mComponents[iComp];
+            if (compEx->displacementType != DisplacementType::NONE) {
+                tfactors[iEpoch * nComponents + iComp] =
+                    compEx->evaluateAt(epochs[iEpoch]);
+            }
+        }
+    }
+
+    size_t countSuccess = 0;
+    for (const size_t i : order) {
+        double &xRef = x[i * strideX];
+        double &yRef = y[i * strideY];
+        double &zRef = z[i * strideZ];
+        const double tVal = t[i * strideT];
+
+        // Invalid epochs are rejected by forward() before using tfactors
+        const double *pointTFactors = nullptr;
+        const auto iter = std::lower_bound(epochs.begin(), epochs.end(), tVal);
+        if (iter != epochs.end() && *iter == tVal) {
+            pointTFactors =
+                tfactors.data() +
+                static_cast<size_t>(iter - epochs.begin()) * nComponents;
+        }
+
+        double xOut;
+        double yOut;
+        double zOut;
+        if (forward(iface, xRef, yRef, zRef, tVal, false, pointTFactors, xOut,
+                    yOut, zOut)) {
+            xRef = xOut;
+            yRef = yOut;
+            zRef = zOut;
+            ++countSuccess;
+        } else {
+            xRef = HUGE_VAL;
+            yRef = HUGE_VAL;
+            zRef = HUGE_VAL;
+        }
+    }
+    return countSuccess;
+}
+
+// ---------------------------------------------------------------------------
+
+template <class Grid, class GridSet, class EvaluatorIface>
+size_t
+Evaluator<Grid, GridSet, EvaluatorIface>::timeFunctionEvaluationCount() const {
+    size_t count = 0;
+    for (const auto &compEx : mComponents) {
+        count += compEx->evaluationCount();
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+
 template <class Grid, class GridSet, class EvaluatorIface>
 bool Evaluator<Grid, GridSet, EvaluatorIface>::inverse(
     EvaluatorIface &iface, double x, double y, double z, double t,
@@ -1240,7 +1414,7 @@ bool Evaluator<Grid, GridSet, EvaluatorIface>::inverse(
         double y_new;
         double z_new;
         if (!forward(iface, x_out, y_out, z_out, t, forInverseComputation,
-                     x_new, y_new, z_new)) {
+                     nullptr, x_new, y_new, z_new)) {
             return false;
         }
 #ifdef DEBUG_DEFMODEL
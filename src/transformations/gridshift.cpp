@@ -43,6 +43,7 @@
 #include <cmath>
 #include <limits>
 #include <map>
+#include <new>
 #include <utility>
 
 PROJ_HEAD(gridshift, "Generic grid shift");
@@ -77,8 +78,9 @@ struct GridInfo {
 
 // ---------------------------------------------------------------------------
 
-struct gridshiftData {
-    ListOfGenericGrids m_grids{};
+// Shared with the copies of the operation, as all its members depend on the
+// grids. Must only be used with the mutex locked.
+struct gridshiftData : public SharedGrids<ListOfGenericGrids> {
     bool m_defer_grid_opening = false;
     bool m_bHasHorizontalOffset = false;
     bool m_bHasGeographic3DOffset = false;
@@ -111,7 +113,8 @@ struct gridshiftData {
                                      GenericShiftGridSet *&gridSetOut) const;
     PJ_XYZ grid_interpolate(PJ_CONTEXT *ctx, const std::string &type, PJ_XY xy,
                             const GenericShiftGrid *grid,
-                            bool &biquadraticInterpolationOut);
+                            bool &biquadraticInterpolationOut,
+                            double *jacobianOut = nullptr);
     PJ_XYZ grid_apply_internal(PJ_CONTEXT *ctx, const std::string &type,
                                bool isVerticalOnly, const PJ_XYZ in,
                                PJ_DIRECTION direction,
@@ -127,7 +130,7 @@ bool gridshiftData::checkGridTypes(PJ *P, bool &isProjectedCoord) {
     std::string offsetX, offsetY;
     int gridCount = 0;
     isProjectedCoord = false;
-    for (const auto &gridset : m_grids) {
+    for (const auto &gridset : grids) {
         for (const auto &grid : gridset->grids()) {
             ++gridCount;
             const auto &type = grid->metadataItem("TYPE");
@@ -223,7 +226,7 @@ bool gridshiftData::checkGridTypes(PJ *P, bool &isProjectedCoord) {
 const GenericShiftGrid *
 gridshiftData::findGrid(const std::string &type, const PJ_XYZ &input,
                         GenericShiftGridSet *&gridSetOut) const {
-    for (const auto &gridset : m_grids) {
+    for (const auto &gridset : grids) {
         auto grid = gridset->gridAt(type, input.x, input.y);
         if (grid) {
             gridSetOut = gridset.get();
@@ -239,12 +242,19 @@ gridshiftData::findGrid(const std::string &type, const PJ_XYZ &input,
 
 PJ_XYZ gridshiftData::grid_interpolate(PJ_CONTEXT *ctx, const std::string &type,
                                        PJ_XY xy, const GenericShiftGrid *grid,
-                                       bool &biquadraticInterpolationOut) {
+                                       bool &biquadraticInterpolationOut,
+                                       double *jacobianOut) {
     PJ_XYZ val;
 
     val.x = val.y = HUGE_VAL;
     val.z = 0;
 
+    // Partial derivatives of the horizontal shift (d(val.x)/dx, d(val.x)/dy,
+    // d(val.y)/dx, d(val.y)/dy), only computed for bilinear interpolation.
+    if (jacobianOut) {
+        jacobianOut[0] = jacobianOut[1] = jacobianOut[2] = jacobianOut[3] = 0;
+    }
+
     const bool isProjectedCoord = !grid->extentAndRes().isGeographic;
     auto iterCache = m_cacheGridInfo.find(grid);
     if (iterCache == m_cacheGridInfo.end()) {
@@ -421,6 +431,8 @@ PJ_XYZ gridshiftData::grid_interpolate(PJ_CONTEXT *ctx, const std::string &type,
 
     bool nodataFound = false;
     if (bilinearInterpolation) {
+        const double frctX = frct.x;
+        const double frctY = frct.y;
         double m10 = frct.x;
         double m11 = m10;
         double m01 = 1. - frct.x;
@@ -454,6 +466,22 @@ PJ_XYZ gridshiftData::grid_interpolate(PJ_CONTEXT *ctx, const std::string &type,
                 val.y = (m00 * gridInfo.shifts[1] + m10 * gridInfo.shifts[3] +
                          m01 * gridInfo.shifts[5] + m11 * gridInfo.shifts[7]);
             }
+            if (jacobianOut) {
+                const int stride = idxSampleZ >= 0 ? 3 : 2;
+                const float *shifts = gridInfo.shifts.data();
+                for (int i = 0; i < 2; ++i) {
+                    const double f00 = shifts[i];
+                    const double f10 = shifts[stride + i];
+                    const double f01 = shifts[2 * stride + i];
+                    const double f11 = shifts[3 * stride + i];
+                    jacobianOut[2 * i] =
+                        ((1 - frctY) * (f10 - f00) + frctY * (f11 - f01)) /
+                        extent.resX;
+                    jacobianOut[2 * i + 1] =
+                        ((1 - frctX) * (f01 - f00) + frctX * (f11 - f10)) /
+                        extent.resY;
+                }
+            }
         } else {
             val.x = 0;
             val.y = 0;
@@ -569,10 +597,18 @@ PJ_XYZ gridshiftData::grid_interpolate(PJ_CONTEXT *ctx, const std::string &type,
         constexpr double convFactorXY = 1. / 3600 / 180 * M_PI;
         val.x *= convFactorXY;
         val.y *= convFactorXY;
+        if (jacobianOut) {
+            for (int i = 0; i < 4; ++i)
+                jacobianOut[i] *= convFactorXY;
+        }
     }
 
     if (gridInfo.swapXYInRes) {
         std::swap(val.x, val.y);
+        if (jacobianOut) {
+            std::swap(jacobianOut[0], jacobianOut[2]);
+            std::swap(jacobianOut[1], jacobianOut[3]);
+        }
     }
 
     return val;
@@ -660,9 +696,10 @@ PJ_XYZ gridshiftData::grid_apply_internal(
         int i = MAX_ITERATIONS;
         const double toltol = TOL * TOL;
         PJ_XY diff;
+        double jacobian[4];
         do {
             shift = grid_interpolate(ctx, type, guess, grid,
-                                     biquadraticInterpolationOut);
+                                     biquadraticInterpolationOut, jacobian);
             if (grid->hasChanged()) {
                 shouldRetry = gridset->reopen(ctx);
                 PJ_XYZ out;
@@ -691,6 +728,7 @@ PJ_XYZ gridshiftData::grid_apply_internal(
 
             diff.x = guess.x + shift.x - normalized_in.x;
             diff.y = guess.y + shift.y - normalized_in.y;
+            pj_inverse_grid_shift_step(jacobian, diff.x, diff.y);
             guess.x -= diff.x;
             guess.y -= diff.y;
 
@@ -726,7 +764,8 @@ PJ_XYZ gridshiftData::grid_apply_internal(
 bool gridshiftData::loadGridsIfNeeded(PJ *P) {
     if (m_defer_grid_opening) {
         m_defer_grid_opening = false;
-        m_grids = pj_generic_grid_init(P, "grids");
+        grids = pj_generic_grid_init(P, "grids");
+        boundCtx = P->ctx;
         if (proj_errno(P)) {
             return false;
         }
@@ -735,6 +774,7 @@ bool gridshiftData::loadGridsIfNeeded(PJ *P) {
             return false;
         }
     }
+    bindContext(P->ctx);
     return true;
 }
 
@@ -828,11 +868,19 @@ PJ_XYZ gridshiftData::apply(PJ *P, PJ_DIRECTION direction, PJ_XYZ xyz) {
 
 } // anonymous namespace
 
+// The opaque object of the operation, referencing its shared data
+typedef std::shared_ptr<gridshiftData> gridshiftDataRef;
+
+static gridshiftData *pj_gridshift_get_data(PJ *P) {
+    return static_cast<gridshiftDataRef *>(P->opaque)->get();
+}
+
 // ---------------------------------------------------------------------------
 
 static PJ_XYZ pj_gridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
-    auto Q = static_cast<gridshiftData *>(P->opaque);
+    auto Q = pj_gridshift_get_data(P);
 
+    std::lock_guard<std::mutex> lock(Q->mutex);
     if (!Q->loadGridsIfNeeded(P)) {
         return proj_coord_error().xyz;
     }
@@ -853,8 +901,9 @@ static PJ_XYZ pj_gridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
 // ---------------------------------------------------------------------------
 
 static PJ_LPZ pj_gridshift_reverse_3d(PJ_XYZ xyz, PJ *P) {
-    auto Q = static_cast<gridshiftData *>(P->opaque);
+    auto Q = pj_gridshift_get_data(P);
 
+    std::lock_guard<std::mutex> lock(Q->mutex);
     // Must be done before using m_offsetX !
     if (!Q->loadGridsIfNeeded(P)) {
         return proj_coord_error().lpz;
@@ -877,7 +926,11 @@ static PJ *pj_gridshift_destructor(PJ *P, int errlev) {
     if (nullptr == P)
         return nullptr;
 
-    delete static_cast<struct gridshiftData *>(P->opaque);
+    auto ref = static_cast<gridshiftDataRef *>(P->opaque);
+    if (ref) {
+        pj_release_shared_grids(*ref, P->ctx);
+        delete ref;
+    }
     P->opaque = nullptr;
 
     return pj_default_destructor(P, errlev);
@@ -885,20 +938,57 @@ static PJ *pj_gridshift_destructor(PJ *P, int errlev) {
 
 // ---------------------------------------------------------------------------
 
-static void pj_gridshift_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
-    auto Q = (struct gridshiftData *)P->opaque;
-    for (auto &grid : Q->m_grids) {
-        grid->reassign_context(ctx);
+static bool pj_gridshift_prepare_for_area(PJ *P, PJ_DIRECTION direction,
+                                          const std::vector<PJ_COORD> &points,
+                                          size_t &bytesLoaded) {
+    auto Q = pj_gridshift_get_data(P);
+    std::lock_guard<std::mutex> lock(Q->mutex);
+    if (!Q->loadGridsIfNeeded(P)) {
+        return false;
     }
+    if (direction == PJ_FWD || (Q->m_offsetX == 0 && Q->m_offsetY == 0)) {
+        return pj_grids_prefetch(Q->grids, points, bytesLoaded);
+    }
+    // In the inverse direction, the offsets are subtracted before reading
+    // the grids.
+    std::vector<PJ_COORD> shiftedPoints(points);
+    for (auto &point : shiftedPoints) {
+        if (point.xyzt.x != HUGE_VAL) {
+            point.xyzt.x -= Q->m_offsetX;
+            point.xyzt.y -= Q->m_offsetY;
+        }
+    }
+    return pj_grids_prefetch(Q->grids, shiftedPoints, bytesLoaded);
+}
+
+// ---------------------------------------------------------------------------
+
+static void pj_gridshift_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
+    auto Q = pj_gridshift_get_data(P);
+    std::lock_guard<std::mutex> lock(Q->mutex);
+    Q->bindContext(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
+static bool pj_gridshift_clone_opaque(PJ *dst, const PJ *src) {
+    // The copy shares the data of src
+    dst->opaque = new (std::nothrow)
+        gridshiftDataRef(*static_cast<const gridshiftDataRef *>(src->opaque));
+    return dst->opaque != nullptr;
 }
 
 // ---------------------------------------------------------------------------
 
 PJ *PJ_TRANSFORMATION(gridshift, 0) {
-    auto Q = new gridshiftData;
-    P->opaque = (void *)Q;
+    auto ref = new gridshiftDataRef(std::make_shared<gridshiftData>());
+    P->opaque = (void *)ref;
+    auto Q = ref->get();
+    Q->boundCtx = P->ctx;
     P->destructor = pj_gridshift_destructor;
     P->reassign_context = pj_gridshift_reassign_context;
+    P->prepare_for_area = pj_gridshift_prepare_for_area;
+    P->clone_opaque = pj_gridshift_clone_opaque;
 
     P->fwd3d = pj_gridshift_forward_3d;
     P->inv3d = pj_gridshift_reverse_3d;
@@ -930,7 +1020,7 @@ PJ *PJ_TRANSFORMATION(gridshift, 0) {
         Q->m_defer_grid_opening = true;
     } else {
         const char *gridnames = pj_param(P->ctx, P->params, "sgrids").s;
-        Q->m_grids = pj_generic_grid_init(P, "grids");
+        Q->grids = pj_generic_grid_init(P, "grids");
         /* Was gridlist compiled properly? */
         if (proj_errno(P)) {
             proj_log_error(P, _("could not find required grid(s)."));
@@ -473,6 +473,36 @@ static void helmert_reverse_4d(PJ_COORD &point, PJ *P) {
     point.lpz = lpz;
 }
 
+static bool helmert_get_affine_coeffs(const PJ *P, PJ_DIRECTION direction,
+                                      PJ_AFFINE_COEFFS &coeffs) {
+    const struct pj_opaque_helmert *Q =
+        (const struct pj_opaque_helmert *)P->opaque;
+
+    /* Only the static translation and scaling case: the parameters of the
+     * time-dependent case vary with the observation epoch */
+    if (Q->fourparam || !Q->no_rotation || Q->dxyz.x != 0 ||
+        Q->dxyz.y != 0 || Q->dxyz.z != 0 || Q->dscale != 0 ||
+        Q->dtheta != 0)
+        return false;
+
+    const double scale = (Q->scale == 0) ? 1.0 : 1 + Q->scale * 1e-6;
+    const double xyz[3] = {Q->xyz.x, Q->xyz.y, Q->xyz.z};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++)
+            coeffs.matrix[i][j] = 0.0;
+        if (direction == PJ_FWD) {
+            coeffs.matrix[i][i] = scale;
+            coeffs.offset[i] = xyz[i];
+        } else {
+            coeffs.matrix[i][i] = 1.0 / scale;
+            coeffs.offset[i] = -xyz[i] / scale;
+        }
+    }
+    coeffs.tscale = 1.0;
+    coeffs.toff = 0.0;
+    return true;
+}
+
 /* Arcsecond to radians */
 #define ARCSEC_TO_RAD (DEG_TO_RAD / 3600.0)
 
@@ -482,6 +512,7 @@ static PJ *init_helmert_six_parameters(PJ *P) {
     if (nullptr == Q)
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = (void *)Q;
+    P->clone_opaque = pj_clone_plain_opaque<struct pj_opaque_helmert>;
 
     /* In most cases, we work on 3D cartesian coordinates */
     P->left = PJ_IO_UNITS_CARTESIAN;
@@ -692,6 +723,8 @@ PJ *PJ_TRANSFORMATION(helmert, 0) {
     update_parameters(P);
     build_rot_matrix(P);
 
+    P->get_affine_coeffs = helmert_get_affine_coeffs;
+
     return P;
 }
 
@@ -2,6 +2,7 @@
 
 #include <errno.h>
 #include <mutex>
+#include <new>
 #include <stddef.h>
 #include <string.h>
 #include <time.h>
@@ -17,31 +18,49 @@ static std::set<std::string> gKnownGridsHGridShift{};
 using namespace NS_PROJ;
 
 namespace { // anonymous namespace
+struct hgridshiftGrids : public SharedGrids<ListOfHGrids> {
+    bool defer_grid_opening = false;
+    bool inverse_grids_initialized = false;
+};
+
 struct hgridshiftData {
     double t_final = 0;
     double t_epoch = 0;
-    ListOfHGrids grids{};
-    bool defer_grid_opening = false;
+    bool cache_inverse_grid = false;
+    std::shared_ptr<hgridshiftGrids> grids =
+        std::make_shared<hgridshiftGrids>();
 };
 } // anonymous namespace
 
+// Open the grids if their opening was deferred, and bind them to the context
+// of P. Must be called with the mutex of the grids locked.
+static bool pj_hgridshift_use_grids(PJ *P, hgridshiftGrids &G) {
+    if (G.defer_grid_opening) {
+        G.defer_grid_opening = false;
+        G.grids = pj_hgrid_init(P, "grids");
+        G.boundCtx = P->ctx;
+        if (proj_errno(P)) {
+            return false;
+        }
+    }
+    G.bindContext(P->ctx);
+    return true;
+}
+
 static PJ_XYZ pj_hgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
     auto Q = static_cast<hgridshiftData *>(P->opaque);
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
 
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_hgrid_init(P, "grids");
-        if (proj_errno(P)) {
-            return proj_coord_error().xyz;
-        }
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_hgridshift_use_grids(P, *Q->grids)) {
+        return proj_coord_error().xyz;
     }
 
-    if (!Q->grids.empty()) {
+    if (!Q->grids->grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
          * otherwise just pass the coordinate through unchanged. */
-        point.lp = pj_hgrid_apply(P->ctx, Q->grids, point.lp, PJ_FWD);
+        point.lp = pj_hgrid_apply(P->ctx, Q->grids->grids, point.lp, PJ_FWD);
     }
 
     return point.xyz;
@@ -52,18 +71,20 @@ static PJ_LPZ pj_hgridshift_reverse_3d(PJ_XYZ xyz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.xyz = xyz;
 
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_hgrid_init(P, "grids");
-        if (proj_errno(P)) {
-            return proj_coord_error().lpz;
-        }
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_hgridshift_use_grids(P, *Q->grids)) {
+        return proj_coord_error().lpz;
+    }
+
+    if (Q->cache_inverse_grid && !Q->grids->inverse_grids_initialized) {
+        Q->grids->inverse_grids_initialized = true;
+        pj_hgrid_init_inverse_grids(P->ctx, Q->grids->grids);
     }
 
-    if (!Q->grids.empty()) {
+    if (!Q->grids->grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
          * otherwise just pass the coordinate through unchanged. */
-        point.lp = pj_hgrid_apply(P->ctx, Q->grids, point.lp, PJ_INV);
+        point.lp = pj_hgrid_apply(P->ctx, Q->grids->grids, point.lp, PJ_INV);
     }
 
     return point.lpz;
@@ -123,7 +144,11 @@ static PJ *pj_hgridshift_destructor(PJ *P, int errlev) {
     if (nullptr == P)
         return nullptr;
 
-    delete static_cast<struct hgridshiftData *>(P->opaque);
+    auto Q = static_cast<struct hgridshiftData *>(P->opaque);
+    if (Q) {
+        pj_release_shared_grids(Q->grids, P->ctx);
+        delete Q;
+    }
     P->opaque = nullptr;
 
     return pj_default_destructor(P, errlev);
@@ -131,9 +156,31 @@ static PJ *pj_hgridshift_destructor(PJ *P, int errlev) {
 
 static void pj_hgridshift_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     auto Q = (struct hgridshiftData *)P->opaque;
-    for (auto &grid : Q->grids) {
-        grid->reassign_context(ctx);
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    Q->grids->bindContext(ctx);
+}
+
+static bool pj_hgridshift_clone_opaque(PJ *dst, const PJ *src) {
+    // The copy shares the grids of src
+    dst->opaque = new (std::nothrow)
+        hgridshiftData(*static_cast<const hgridshiftData *>(src->opaque));
+    return dst->opaque != nullptr;
+}
+
+static bool pj_hgridshift_prepare_for_area(PJ *P, PJ_DIRECTION direction,
+                                           const std::vector<PJ_COORD> &points,
+                                           size_t &bytesLoaded) {
+    auto Q = static_cast<hgridshiftData *>(P->opaque);
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_hgridshift_use_grids(P, *Q->grids)) {
+        return false;
     }
+    if (direction == PJ_INV && Q->cache_inverse_grid &&
+        !Q->grids->inverse_grids_initialized) {
+        Q->grids->inverse_grids_initialized = true;
+        pj_hgrid_init_inverse_grids(P->ctx, Q->grids->grids);
+    }
+    return pj_grids_prefetch(Q->grids->grids, points, bytesLoaded);
 }
 
 PJ *PJ_TRANSFORMATION(hgridshift, 0) {
@@ -141,6 +188,8 @@ PJ *PJ_TRANSFORMATION(hgridshift, 0) {
     P->opaque = (void *)Q;
     P->destructor = pj_hgridshift_destructor;
     P->reassign_context = pj_hgridshift_reassign_context;
+    P->prepare_for_area = pj_hgridshift_prepare_for_area;
+    P->clone_opaque = pj_hgridshift_clone_opaque;
 
     P->fwd4d = pj_hgridshift_forward_4d;
     P->inv4d = pj_hgridshift_reverse_4d;
@@ -177,8 +226,12 @@ PJ *PJ_TRANSFORMATION(hgridshift, 0) {
     if (pj_param(P->ctx, P->params, "tt_epoch").i)
         Q->t_epoch = pj_param(P->ctx, P->params, "dt_epoch").f;
 
+    if (pj_param(P->ctx, P->params, "tcache_inverse_grid").i)
+        Q->cache_inverse_grid = true;
+
+    Q->grids->boundCtx = P->ctx;
     if (P->ctx->defer_grid_opening) {
-        Q->defer_grid_opening = true;
+        Q->grids->defer_grid_opening = true;
     } else {
         const char *gridnames = pj_param(P->ctx, P->params, "sgrids").s;
         gMutexHGridShift.lock();
@@ -186,9 +239,9 @@ PJ *PJ_TRANSFORMATION(hgridshift, 0) {
                                  gKnownGridsHGridShift.end();
         gMutexHGridShift.unlock();
         if (isKnownGrid) {
-            Q->defer_grid_opening = true;
+            Q->grids->defer_grid_opening = true;
         } else {
-            Q->grids = pj_hgrid_init(P, "grids");
+            Q->grids->grids = pj_hgrid_init(P, "grids");
             /* Was gridlist compiled properly? */
             if (proj_errno(P)) {
                 proj_log_error(P, _("could not find required grid(s)."));
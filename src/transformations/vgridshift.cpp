@@ -2,6 +2,7 @@
 
 #include <errno.h>
 #include <mutex>
+#include <new>
 #include <stddef.h>
 #include <string.h>
 #include <time.h>
@@ -17,20 +18,24 @@ static std::set<std::string> gKnownGridsVGridShift{};
 using namespace NS_PROJ;
 
 namespace { // anonymous namespace
+struct vgridshiftGrids : public SharedGrids<ListOfVGrids> {
+    // Depends on the grids opened, see deal_with_vertcon_gtx_hack()
+    double forward_multiplier = 0;
+    bool defer_grid_opening = false;
+};
+
 struct vgridshiftData {
     double t_final = 0;
     double t_epoch = 0;
-    double forward_multiplier = 0;
-    ListOfVGrids grids{};
-    bool defer_grid_opening = false;
+    std::shared_ptr<vgridshiftGrids> grids =
+        std::make_shared<vgridshiftGrids>();
 };
 } // anonymous namespace
 
-static void deal_with_vertcon_gtx_hack(PJ *P) {
-    struct vgridshiftData *Q = (struct vgridshiftData *)P->opaque;
+static void deal_with_vertcon_gtx_hack(PJ *P, vgridshiftGrids &G) {
     // The .gtx VERTCON files stored millimeters, but the .tif files
     // are in metres.
-    if (Q->forward_multiplier != 0.001) {
+    if (G.forward_multiplier != 0.001) {
         return;
     }
     const char *gridname = pj_param(P->ctx, P->params, "sgrids").s;
@@ -42,13 +47,29 @@ static void deal_with_vertcon_gtx_hack(PJ *P) {
         strcmp(gridname, "vertcone.gtx") != 0) {
         return;
     }
-    if (Q->grids.empty()) {
+    if (G.grids.empty()) {
         return;
     }
-    const auto &grids = Q->grids[0]->grids();
+    const auto &grids = G.grids[0]->grids();
     if (!grids.empty() && grids[0]->name().find(".tif") != std::string::npos) {
-        Q->forward_multiplier = 1.0;
+        G.forward_multiplier = 1.0;
+    }
+}
+
+// Open the grids if their opening was deferred, and bind them to the context
+// of P. Must be called with the mutex of the grids locked.
+static bool pj_vgridshift_use_grids(PJ *P, vgridshiftGrids &G) {
+    if (G.defer_grid_opening) {
+        G.defer_grid_opening = false;
+        G.grids = pj_vgrid_init(P, "grids");
+        G.boundCtx = P->ctx;
+        deal_with_vertcon_gtx_hack(P, G);
+        if (proj_errno(P)) {
+            return false;
+        }
     }
+    G.bindContext(P->ctx);
+    return true;
 }
 
 static PJ_XYZ pj_vgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
@@ -56,20 +77,17 @@ static PJ_XYZ pj_vgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
 
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_vgrid_init(P, "grids");
-        deal_with_vertcon_gtx_hack(P);
-        if (proj_errno(P)) {
-            return proj_coord_error().xyz;
-        }
+    auto &G = *Q->grids;
+    std::lock_guard<std::mutex> lock(G.mutex);
+    if (!pj_vgridshift_use_grids(P, G)) {
+        return proj_coord_error().xyz;
     }
 
-    if (!Q->grids.empty()) {
+    if (!G.grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
          * otherwise just pass the coordinate through unchanged. */
         point.xyz.z +=
-            pj_vgrid_value(P, Q->grids, point.lp, Q->forward_multiplier);
+            pj_vgrid_value(P, G.grids, point.lp, G.forward_multiplier);
     }
 
     return point.xyz;
@@ -80,20 +98,17 @@ static PJ_LPZ pj_vgridshift_reverse_3d(PJ_XYZ xyz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.xyz = xyz;
 
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_vgrid_init(P, "grids");
-        deal_with_vertcon_gtx_hack(P);
-        if (proj_errno(P)) {
-            return proj_coord_error().lpz;
-        }
+    auto &G = *Q->grids;
+    std::lock_guard<std::mutex> lock(G.mutex);
+    if (!pj_vgridshift_use_grids(P, G)) {
+        return proj_coord_error().lpz;
     }
 
-    if (!Q->grids.empty()) {
+    if (!G.grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
          * otherwise just pass the coordinate through unchanged. */
         point.xyz.z -=
-            pj_vgrid_value(P, Q->grids, point.lp, Q->forward_multiplier);
+            pj_vgrid_value(P, G.grids, point.lp, G.forward_multiplier);
     }
 
     return point.lpz;
@@ -153,7 +168,11 @@ static PJ *pj_vgridshift_destructor(PJ *P, int errlev) {
     if (nullptr == P)
         return nullptr;
 
-    delete static_cast<struct vgridshiftData *>(P->opaque);
+    auto Q = static_cast<struct vgridshiftData *>(P->opaque);
+    if (Q) {
+        pj_release_shared_grids(Q->grids, P->ctx);
+        delete Q;
+    }
     P->opaque = nullptr;
 
     return pj_default_destructor(P, errlev);
@@ -161,9 +180,26 @@ static PJ *pj_vgridshift_destructor(PJ *P, int errlev) {
 
 static void pj_vgridshift_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     auto Q = (struct vgridshiftData *)P->opaque;
-    for (auto &grid : Q->grids) {
-        grid->reassign_context(ctx);
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    Q->grids->bindContext(ctx);
+}
+
+static bool pj_vgridshift_clone_opaque(PJ *dst, const PJ *src) {
+    // The copy shares the grids of src
+    dst->opaque = new (std::nothrow)
+        vgridshiftData(*static_cast<const vgridshiftData *>(src->opaque));
+    return dst->opaque != nullptr;
+}
+
+static bool pj_vgridshift_prepare_for_area(PJ *P, PJ_DIRECTION,
+                                           const std::vector<PJ_COORD> &points,
+                                           size_t &bytesLoaded) {
+    struct vgridshiftData *Q = (struct vgridshiftData *)P->opaque;
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_vgridshift_use_grids(P, *Q->grids)) {
+        return false;
     }
+    return pj_grids_prefetch(Q->grids->grids, points, bytesLoaded);
 }
 
 PJ *PJ_TRANSFORMATION(vgridshift, 0) {
@@ -171,6 +207,8 @@ PJ *PJ_TRANSFORMATION(vgridshift, 0) {
     P->opaque = (void *)Q;
     P->destructor = pj_vgridshift_destructor;
     P->reassign_context = pj_vgridshift_reassign_context;
+    P->prepare_for_area = pj_vgridshift_prepare_for_area;
+    P->clone_opaque = pj_vgridshift_clone_opaque;
 
     if (!pj_param(P->ctx, P->params, "tgrids").i) {
         proj_log_error(P, _("+grids parameter missing."));
@@ -198,13 +236,15 @@ PJ *PJ_TRANSFORMATION(vgridshift, 0) {
         Q->t_epoch = pj_param(P->ctx, P->params, "dt_epoch").f;
 
     /* historical: the forward direction subtracts the grid offset. */
-    Q->forward_multiplier = -1.0;
+    Q->grids->forward_multiplier = -1.0;
     if (pj_param(P->ctx, P->params, "tmultiplier").i) {
-        Q->forward_multiplier = pj_param(P->ctx, P->params, "dmultiplier").f;
+        Q->grids->forward_multiplier =
+            pj_param(P->ctx, P->params, "dmultiplier").f;
     }
 
+    Q->grids->boundCtx = P->ctx;
     if (P->ctx->defer_grid_opening) {
-        Q->defer_grid_opening = true;
+        Q->grids->defer_grid_opening = true;
     } else {
         const char *gridnames = pj_param(P->ctx, P->params, "sgrids").s;
         gMutexVGridShift.lock();
@@ -213,11 +253,11 @@ PJ *PJ_TRANSFORMATION(vgridshift, 0) {
         gMutexVGridShift.unlock();
 
         if (isKnownGrid) {
-            Q->defer_grid_opening = true;
+            Q->grids->defer_grid_opening = true;
         } else {
             /* Build gridlist. P->vgridlist_geoid can be empty if +grids only
              * ask for optional grids. */
-            Q->grids = pj_vgrid_init(P, "grids");
+            Q->grids->grids = pj_vgrid_init(P, "grids");
 
             /* Was gridlist compiled properly? */
             if (proj_errno(P)) {
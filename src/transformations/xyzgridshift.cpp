@@ -34,35 +34,49 @@
 #include "proj_internal.h"
 
 #include <algorithm>
+#include <new>
 
 PROJ_HEAD(xyzgridshift, "Geocentric grid shift");
 
 using namespace NS_PROJ;
 
 namespace { // anonymous namespace
+struct xyzgridshiftGrids : public SharedGrids<ListOfGenericGrids> {
+    bool defer_grid_opening = false;
+};
+
 struct xyzgridshiftData {
     PJ *cart = nullptr;
     bool grid_ref_is_input = true;
-    ListOfGenericGrids grids{};
-    bool defer_grid_opening = false;
+    std::shared_ptr<xyzgridshiftGrids> grids =
+        std::make_shared<xyzgridshiftGrids>();
     double multiplier = 1.0;
 };
 } // anonymous namespace
 
 // ---------------------------------------------------------------------------
 
-static bool get_grid_values(PJ *P, xyzgridshiftData *Q, const PJ_LP &lp,
-                            double &dx, double &dy, double &dz) {
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_generic_grid_init(P, "grids");
+// Open the grids if their opening was deferred, and bind them to the context
+// of P. Must be called with the mutex of the grids locked.
+static bool pj_xyzgridshift_use_grids(PJ *P, xyzgridshiftGrids &G) {
+    if (G.defer_grid_opening) {
+        G.defer_grid_opening = false;
+        G.grids = pj_generic_grid_init(P, "grids");
+        G.boundCtx = P->ctx;
         if (proj_errno(P)) {
             return false;
         }
     }
+    G.bindContext(P->ctx);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
 
+static bool get_grid_values(PJ *P, xyzgridshiftData *Q, const PJ_LP &lp,
+                            double &dx, double &dy, double &dz) {
     GenericShiftGridSet *gridset = nullptr;
-    auto grid = pj_find_generic_grid(Q->grids, lp, gridset);
+    auto grid = pj_find_generic_grid(Q->grids->grids, lp, gridset);
     if (!grid) {
         return false;
     }
@@ -171,6 +185,11 @@ static PJ_XYZ pj_xyzgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
 
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_xyzgridshift_use_grids(P, *Q->grids)) {
+        return proj_coord_error().xyz;
+    }
+
     if (Q->grid_ref_is_input) {
         point = direct_adjustment(P, Q, point, 1.0);
     } else {
@@ -185,6 +204,11 @@ static PJ_LPZ pj_xyzgridshift_reverse_3d(PJ_XYZ xyz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.xyz = xyz;
 
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_xyzgridshift_use_grids(P, *Q->grids)) {
+        return proj_coord_error().lpz;
+    }
+
     if (Q->grid_ref_is_input) {
         point = iterative_adjustment(P, Q, point, -1.0);
     } else {
@@ -202,6 +226,7 @@ static PJ *pj_xyzgridshift_destructor(PJ *P, int errlev) {
     if (Q) {
         if (Q->cart)
             Q->cart->destructor(Q->cart, errlev);
+        pj_release_shared_grids(Q->grids, P->ctx);
         delete Q;
     }
     P->opaque = nullptr;
@@ -209,11 +234,47 @@ static PJ *pj_xyzgridshift_destructor(PJ *P, int errlev) {
     return pj_default_destructor(P, errlev);
 }
 
+static bool
+pj_xyzgridshift_prepare_for_area(PJ *P, PJ_DIRECTION,
+                                 const std::vector<PJ_COORD> &points,
+                                 size_t &bytesLoaded) {
+    auto Q = static_cast<xyzgridshiftData *>(P->opaque);
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    if (!pj_xyzgridshift_use_grids(P, *Q->grids)) {
+        return false;
+    }
+    // The grids are indexed by the geographic coordinates of the points
+    std::vector<PJ_COORD> geodeticPoints;
+    geodeticPoints.reserve(points.size());
+    for (const auto &point : points) {
+        PJ_COORD geodetic = point;
+        if (point.xyzt.x != HUGE_VAL)
+            geodetic.lpz = pj_inv3d(point.xyz, Q->cart);
+        geodeticPoints.push_back(geodetic);
+    }
+    return pj_grids_prefetch(Q->grids->grids, geodeticPoints, bytesLoaded);
+}
+
 static void pj_xyzgridshift_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     auto Q = (struct xyzgridshiftData *)P->opaque;
-    for (auto &grid : Q->grids) {
-        grid->reassign_context(ctx);
+    std::lock_guard<std::mutex> lock(Q->grids->mutex);
+    Q->grids->bindContext(ctx);
+}
+
+static bool pj_xyzgridshift_clone_opaque(PJ *dst, const PJ *src) {
+    auto srcQ = static_cast<const xyzgridshiftData *>(src->opaque);
+    PJ *cart = pj_clone_instantiated(dst->ctx, srcQ->cart);
+    if (cart == nullptr)
+        return false;
+    // The copy shares the grids of src
+    auto Q = new (std::nothrow) xyzgridshiftData(*srcQ);
+    if (Q == nullptr) {
+        proj_destroy(cart);
+        return false;
     }
+    Q->cart = cart;
+    dst->opaque = Q;
+    return true;
 }
 
 PJ *PJ_TRANSFORMATION(xyzgridshift, 0) {
@@ -221,6 +282,8 @@ PJ *PJ_TRANSFORMATION(xyzgridshift, 0) {
     P->opaque = (void *)Q;
     P->destructor = pj_xyzgridshift_destructor;
     P->reassign_context = pj_xyzgridshift_reassign_context;
+    P->prepare_for_area = pj_xyzgridshift_prepare_for_area;
+    P->clone_opaque = pj_xyzgridshift_clone_opaque;
 
     P->fwd4d = nullptr;
     P->inv4d = nullptr;
@@ -266,10 +329,11 @@ PJ *PJ_TRANSFORMATION(xyzgridshift, 0) {
         Q->multiplier = pj_param(P->ctx, P->params, "dmultiplier").f;
     }
 
+    Q->grids->boundCtx = P->ctx;
     if (P->ctx->defer_grid_opening) {
-        Q->defer_grid_opening = true;
+        Q->grids->defer_grid_opening = true;
     } else {
-        Q->grids = pj_generic_grid_init(P, "grids");
+        Q->grids->grids = pj_generic_grid_init(P, "grids");
         /* Was gridlist compiled properly? */
         if (proj_errno(P)) {
             proj_log_error(P, _("could not find required grid(s)."));
@@ -35,8 +35,11 @@
 #include "proj_internal.h"
 // clang-format on
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -1153,6 +1156,73 @@ TEST(gie, proj_create_crs_to_crs_with_area_large) {
 
 // ---------------------------------------------------------------------------
 
+TEST(gie, proj_create_crs_to_crs_alternatives_instantiated_when_used) {
+    auto P = proj_create_crs_to_crs(PJ_DEFAULT_CTX, "EPSG:4267", "EPSG:4326",
+                                    nullptr);
+    ASSERT_TRUE(P != nullptr);
+    ASSERT_GT(P->alternativeCoordinateOperations.size(), 1U);
+    for (const auto &alt : P->alternativeCoordinateOperations) {
+        EXPECT_TRUE(alt.instantiationDeferred);
+    }
+
+    PJ_COORD c = proj_coord(40, -100, 0, HUGE_VAL);
+    PJ_COORD res = proj_trans(P, PJ_FWD, c);
+    ASSERT_GE(P->iCurCoordOp, 0);
+    int countInstantiated = 0;
+    for (const auto &alt : P->alternativeCoordinateOperations) {
+        if (!alt.instantiationDeferred)
+            countInstantiated++;
+    }
+    // Only the selected operation, and those tried before it, are
+    // instantiated
+    EXPECT_LT(countInstantiated,
+              static_cast<int>(P->alternativeCoordinateOperations.size()));
+    const int countInstantiatedInP = countInstantiated;
+    EXPECT_FALSE(P->alternativeCoordinateOperations[P->iCurCoordOp]
+                     .instantiationDeferred);
+
+    auto lastOp = proj_trans_get_last_used_operation(P);
+    ASSERT_TRUE(lastOp != nullptr);
+    PJ_COORD res2 = proj_trans(lastOp, PJ_FWD, c);
+    EXPECT_EQ(res.xy.x, res2.xy.x);
+    EXPECT_EQ(res.xy.y, res2.xy.y);
+    proj_destroy(lastOp);
+
+    // Copies keep the operations that were not used uninstantiated
+    auto P2 = proj_clone(PJ_DEFAULT_CTX, P);
+    ASSERT_TRUE(P2 != nullptr);
+    countInstantiated = 0;
+    for (const auto &alt : P2->alternativeCoordinateOperations) {
+        if (!alt.instantiationDeferred)
+            countInstantiated++;
+    }
+    EXPECT_LE(countInstantiated, countInstantiatedInP);
+    res2 = proj_trans(P2, PJ_FWD, c);
+    EXPECT_EQ(res.xy.x, res2.xy.x);
+    EXPECT_EQ(res.xy.y, res2.xy.y);
+    proj_destroy(P2);
+
+    // And so do objects normalized for visualization
+    auto P3 = proj_normalize_for_visualization(PJ_DEFAULT_CTX, P);
+    ASSERT_TRUE(P3 != nullptr);
+    ASSERT_EQ(P3->alternativeCoordinateOperations.size(),
+              P->alternativeCoordinateOperations.size());
+    countInstantiated = 0;
+    for (const auto &alt : P3->alternativeCoordinateOperations) {
+        if (!alt.instantiationDeferred)
+            countInstantiated++;
+    }
+    EXPECT_EQ(countInstantiated, countInstantiatedInP);
+    res2 = proj_trans(P3, PJ_FWD, proj_coord(-100, 40, 0, HUGE_VAL));
+    EXPECT_EQ(res.xy.x, res2.xy.y);
+    EXPECT_EQ(res.xy.y, res2.xy.x);
+    proj_destroy(P3);
+
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, proj_create_crs_to_crs_with_longitude_outside_minus_180_180) {
 
     // Test bugfix for https://github.com/OSGeo/PROJ/issues/3594
@@ -1244,6 +1314,302 @@ TEST(gie, proj_trans_generic) {
 
 // ---------------------------------------------------------------------------
 
+static void checkTransArrayMatchesTrans(PJ *P, PJ_DIRECTION direction,
+                                       const std::vector<PJ_COORD> &input) {
+    std::vector<PJ_COORD> expected(input);
+    int expectedErrno = 0;
+    for (auto &coord : expected) {
+        proj_errno_reset(P);
+        coord = proj_trans(P, direction, coord);
+        const int thisErrno = proj_errno(P);
+        if (thisErrno != 0 && expectedErrno == 0)
+            expectedErrno = thisErrno;
+        else if (thisErrno != 0 && thisErrno != expectedErrno)
+            expectedErrno = PROJ_ERR_COORD_TRANSFM;
+    }
+
+    std::vector<PJ_COORD> output(input);
+    EXPECT_EQ(proj_trans_array(P, direction, output.size(), output.data()),
+              expectedErrno);
+    // The array variants must be bit-identical to the point by point path,
+    // including for the HUGE_VAL components of the points that failed
+    for (size_t i = 0; i < input.size(); i++) {
+        for (int j = 0; j < 4; j++)
+            EXPECT_EQ(output[i].v[j], expected[i].v[j]) << i << " " << j;
+    }
+}
+
+TEST(gie, proj_trans_array_tmerc) {
+    // Points on both sides of the 3 degree limit of the auto algorithm,
+    // outside of the domain of the exact algorithm, and with an invalid
+    // latitude, in a number which is not a multiple of the batch size.
+    std::vector<PJ_COORD> lonlat;
+    for (int lat = -85; lat <= 85; lat += 17) {
+        for (double lon : {9.0, 10.5, 11.9, 13.5, 25.0, 60.0, 99.0, -150.0})
+            lonlat.push_back(proj_coord(lon, lat, 10, 0));
+    }
+    lonlat.push_back(proj_coord(12, 95, 0, 0));
+
+    std::vector<PJ_COORD> lonlatRad(lonlat);
+    for (auto &coord : lonlatRad) {
+        coord.lp.lam = proj_torad(coord.lp.lam);
+        coord.lp.phi = proj_torad(coord.lp.phi);
+    }
+
+    for (const char *def :
+         {"+proj=utm +zone=32 +ellps=GRS80",
+          "+proj=etmerc +lat_0=10 +lon_0=9 +ellps=GRS80 +x_0=500000",
+          "+proj=tmerc +algo=poder_engsager +lon_0=9 +ellps=GRS80",
+          "+proj=tmerc +algo=evenden_snyder +lon_0=9 +ellps=GRS80"}) {
+        auto P = proj_create(PJ_DEFAULT_CTX, def);
+        ASSERT_TRUE(P != nullptr) << def;
+        checkTransArrayMatchesTrans(P, PJ_FWD, lonlatRad);
+
+        std::vector<PJ_COORD> projected(lonlatRad);
+        proj_trans_array(P, PJ_FWD, projected.size(), projected.data());
+        projected.erase(std::remove_if(projected.begin(), projected.end(),
+                                       [](const PJ_COORD &coord) {
+                                           return coord.xy.x == HUGE_VAL;
+                                       }),
+                        projected.end());
+        projected.push_back(proj_coord(2e7, 0, 0, 0));
+        checkTransArrayMatchesTrans(P, PJ_INV, projected);
+        proj_destroy(P);
+    }
+
+    auto P = proj_create(PJ_DEFAULT_CTX,
+                         "+proj=pipeline +step +proj=axisswap +order=2,1 "
+                         "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+                         "+step +proj=utm +zone=32 +ellps=GRS80");
+    ASSERT_TRUE(P != nullptr);
+    std::vector<PJ_COORD> latlon(lonlat);
+    for (auto &coord : latlon)
+        std::swap(coord.v[0], coord.v[1]);
+    checkTransArrayMatchesTrans(P, PJ_FWD, latlon);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_defmodel) {
+    // Time series at a few stations, interleaved, with a missing time and
+    // an epoch outside of the time extent of the model.
+    std::vector<PJ_COORD> coords;
+    for (double t : {2010.0, 2020.0, HUGE_VAL, 1800.0, 2015.5}) {
+        for (double lon : {2.0, -120.5, 2.0 + 1e-9}) {
+            coords.push_back(
+                proj_coord(proj_torad(lon), proj_torad(49), 30, t));
+        }
+    }
+
+    auto P = proj_create(
+        PJ_DEFAULT_CTX,
+        "+proj=defmodel +model=tests/simple_model_degree_3d.json");
+    ASSERT_TRUE(P != nullptr);
+    checkTransArrayMatchesTrans(P, PJ_FWD, coords);
+    checkTransArrayMatchesTrans(P, PJ_INV, coords);
+    proj_destroy(P);
+
+    P = proj_create(PJ_DEFAULT_CTX,
+                    "+proj=pipeline +step +proj=unitconvert +xy_in=rad "
+                    "+xy_out=deg +step +inv +proj=unitconvert +xy_in=rad "
+                    "+xy_out=deg +step +proj=defmodel "
+                    "+model=tests/simple_model_degree_3d.json");
+    ASSERT_TRUE(P != nullptr);
+    checkTransArrayMatchesTrans(P, PJ_FWD, coords);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_approx) {
+    auto P = proj_create(PJ_DEFAULT_CTX,
+                         "+proj=pipeline +step +inv +proj=utm +zone=31 "
+                         "+ellps=WGS84 +step +proj=unitconvert +xy_in=rad "
+                         "+xy_out=deg");
+    ASSERT_TRUE(P != nullptr);
+
+    // Pixel centers of a 200x150 raster of 100 m pixels
+    std::vector<PJ_COORD> input;
+    for (int j = 0; j < 150; j++) {
+        for (int i = 0; i < 200; i++)
+            input.push_back(
+                proj_coord(400050 + 100 * i, 5400050 + 100 * j, 0, 0));
+    }
+    std::vector<PJ_COORD> expected(input);
+    ASSERT_EQ(proj_trans_array(P, PJ_FWD, expected.size(), expected.data()),
+              0);
+
+    constexpr double maxError = 1e-8;
+    std::vector<PJ_COORD> output(input);
+    ASSERT_EQ(proj_trans_array_approx(P, PJ_FWD, output.size(), output.data(),
+                                      maxError, 0),
+              0);
+    for (size_t i = 0; i < input.size(); i++) {
+        EXPECT_NEAR(output[i].xy.x, expected[i].xy.x, maxError) << i;
+        EXPECT_NEAR(output[i].xy.y, expected[i].xy.y, maxError) << i;
+        // z and t are passed through unchanged
+        EXPECT_EQ(output[i].xyzt.z, 0) << i;
+        EXPECT_EQ(output[i].xyzt.t, 0) << i;
+    }
+
+    // A single line of pixels
+    output.assign(input.begin(), input.begin() + 200);
+    ASSERT_EQ(proj_trans_array_approx(P, PJ_FWD, output.size(), output.data(),
+                                      maxError, 0),
+              0);
+    for (size_t i = 0; i < output.size(); i++) {
+        EXPECT_NEAR(output[i].xy.x, expected[i].xy.x, maxError) << i;
+        EXPECT_NEAR(output[i].xy.y, expected[i].xy.y, maxError) << i;
+    }
+
+    // Without a tolerance, same results as proj_trans_array()
+    output = input;
+    ASSERT_EQ(
+        proj_trans_array_approx(P, PJ_FWD, output.size(), output.data(), 0, 0),
+        0);
+    for (size_t i = 0; i < input.size(); i++) {
+        EXPECT_EQ(output[i].xy.x, expected[i].xy.x) << i;
+        EXPECT_EQ(output[i].xy.y, expected[i].xy.y) << i;
+    }
+
+    // Failing points are reported as with proj_trans_array()
+    std::vector<PJ_COORD> lonlat;
+    for (int j = 0; j < 20; j++) {
+        for (int i = 0; i < 20; i++)
+            lonlat.push_back(proj_coord(2 + 0.01 * i, 48 + 0.01 * j, 0, 0));
+    }
+    lonlat[7] = proj_coord(2, 95, 0, 0);
+    lonlat[8].xy.x = std::numeric_limits<double>::quiet_NaN();
+    output = lonlat;
+    expected = lonlat;
+    EXPECT_EQ(proj_trans_array_approx(P, PJ_INV, output.size(), output.data(),
+                                      1e-3, 0),
+              proj_trans_array(P, PJ_INV, expected.size(), expected.data()));
+    EXPECT_EQ(output[7].xy.x, HUGE_VAL);
+    EXPECT_TRUE(std::isnan(output[8].xy.x));
+    for (size_t i = 0; i < lonlat.size(); i++) {
+        if (i != 7 && i != 8) {
+            EXPECT_NEAR(output[i].xy.x, expected[i].xy.x, 1e-3) << i;
+        }
+    }
+
+    proj_destroy(P);
+
+    // Geocentric output, whose z varies over the area
+    P = proj_create(PJ_DEFAULT_CTX,
+                    "+proj=pipeline +step +inv +proj=utm +zone=31 "
+                    "+ellps=WGS84 +step +proj=cart +ellps=WGS84");
+    ASSERT_TRUE(P != nullptr);
+    expected = input;
+    ASSERT_EQ(proj_trans_array(P, PJ_FWD, expected.size(), expected.data()),
+              0);
+
+    // Without a tolerance for z, the points are transformed exactly
+    output = input;
+    ASSERT_EQ(proj_trans_array_approx(P, PJ_FWD, output.size(), output.data(),
+                                      1e-3, 0),
+              0);
+    for (size_t i = 0; i < input.size(); i++) {
+        EXPECT_EQ(output[i].xyz.x, expected[i].xyz.x) << i;
+        EXPECT_EQ(output[i].xyz.z, expected[i].xyz.z) << i;
+    }
+
+    // With one, z is approximated within it
+    output = input;
+    ASSERT_EQ(proj_trans_array_approx(P, PJ_FWD, output.size(), output.data(),
+                                      1e-3, 1e-4),
+              0);
+    for (size_t i = 0; i < input.size(); i++) {
+        EXPECT_NEAR(output[i].xyz.x, expected[i].xyz.x, 1e-3) << i;
+        EXPECT_NEAR(output[i].xyz.y, expected[i].xyz.y, 1e-3) << i;
+        EXPECT_NEAR(output[i].xyz.z, expected[i].xyz.z, 1e-4) << i;
+        EXPECT_EQ(output[i].xyzt.t, 0) << i;
+    }
+
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, pipeline_cache) {
+    auto ctx = proj_context_create();
+    size_t hits = 1, misses = 1, entries = 1;
+
+    // Disabled by default
+    auto P = proj_create(ctx, "+proj=utm +zone=31 +ellps=GRS80");
+    ASSERT_TRUE(P != nullptr);
+    proj_destroy(P);
+    proj_context_get_pipeline_cache_stats(ctx, &hits, &misses, &entries);
+    EXPECT_EQ(hits, 0U);
+    EXPECT_EQ(misses, 0U);
+    EXPECT_EQ(entries, 0U);
+
+    proj_context_set_pipeline_cache_size(ctx, 2);
+    const char *const pipeline =
+        "+proj=pipeline +step +proj=axisswap +order=2,1 "
+        "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+        "+step +proj=tmerc +lat_0=49 +lon_0=-2 +k=0.9996012717 "
+        "+x_0=400000 +y_0=-100000 +ellps=airy";
+    PJ_COORD a = proj_coord(52, 1, 0, 0);
+    auto P1 = proj_create(ctx, pipeline);
+    ASSERT_TRUE(P1 != nullptr);
+    proj_context_get_pipeline_cache_stats(ctx, &hits, &misses, &entries);
+    EXPECT_GT(misses, 0U);
+    EXPECT_GT(entries, 0U);
+    const size_t hitsAfterFirstCreation = hits;
+    const size_t missesAfterFirstCreation = misses;
+    const size_t entriesAfterFirstCreation = entries;
+
+    auto P2 = proj_create(ctx, pipeline);
+    ASSERT_TRUE(P2 != nullptr);
+    ASSERT_NE(P1, P2);
+    proj_context_get_pipeline_cache_stats(ctx, &hits, &misses, &entries);
+    EXPECT_GT(hits, hitsAfterFirstCreation);
+    EXPECT_EQ(misses, missesAfterFirstCreation);
+    EXPECT_EQ(entries, entriesAfterFirstCreation);
+
+    PJ_COORD b1 = proj_trans(P1, PJ_FWD, a);
+    PJ_COORD b2 = proj_trans(P2, PJ_FWD, a);
+    EXPECT_EQ(b1.xy.x, b2.xy.x);
+    EXPECT_EQ(b1.xy.y, b2.xy.y);
+    proj_destroy(P1);
+    b2 = proj_trans(P2, PJ_INV, b2);
+    EXPECT_NEAR(b2.xy.x, a.xy.x, 1e-10);
+    EXPECT_NEAR(b2.xy.y, a.xy.y, 1e-10);
+    proj_destroy(P2);
+
+    // Least recently used objects are evicted
+    for (const char *def :
+         {"+proj=merc +ellps=WGS84", "+proj=utm +zone=32 +ellps=WGS84"}) {
+        P = proj_create(ctx, def);
+        ASSERT_TRUE(P != nullptr);
+        proj_destroy(P);
+    }
+    proj_context_get_pipeline_cache_stats(ctx, &hits, &misses, &entries);
+    EXPECT_EQ(entries, 2U);
+
+    // Changing the size empties the cache
+    proj_context_set_pipeline_cache_size(ctx, 10);
+    proj_context_get_pipeline_cache_stats(ctx, &hits, &misses, &entries);
+    EXPECT_EQ(hits, 0U);
+    EXPECT_EQ(misses, 0U);
+    EXPECT_EQ(entries, 0U);
+
+    // The size is kept by cloned contexts
+    auto ctx2 = proj_context_clone(ctx);
+    P = proj_create(ctx2, "+proj=merc +ellps=WGS84");
+    ASSERT_TRUE(P != nullptr);
+    proj_destroy(P);
+    proj_context_get_pipeline_cache_stats(ctx2, &hits, &misses, &entries);
+    EXPECT_GT(entries, 0U);
+    proj_context_destroy(ctx2);
+
+    proj_context_destroy(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, proj_trans_with_a_crs) {
     auto P = proj_create(PJ_DEFAULT_CTX, "EPSG:4326");
     PJ_COORD input;
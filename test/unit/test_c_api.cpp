@@ -2016,6 +2016,90 @@ TEST_F(CApi, proj_create_operations_dont_discard_superseded) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_create_operations_max_threads) {
+    auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
+    ASSERT_NE(ctxt, nullptr);
+    ContextKeeper keeper_ctxt(ctxt);
+
+    auto source_crs = proj_create_from_database(
+        m_ctxt, "EPSG", "4939", PJ_CATEGORY_CRS, false, nullptr); // GDA94 3D
+    ASSERT_NE(source_crs, nullptr);
+    ObjectKeeper keeper_source_crs(source_crs);
+
+    auto target_crs = proj_create_from_database(
+        m_ctxt, "EPSG", "7843", PJ_CATEGORY_CRS, false, nullptr); // GDA2020 3D
+    ASSERT_NE(target_crs, nullptr);
+    ObjectKeeper keeper_target_crs(target_crs);
+
+    proj_operation_factory_context_set_max_threads(m_ctxt, ctxt, 4);
+
+    auto res = proj_create_operations(m_ctxt, source_crs, target_crs, ctxt);
+    ASSERT_NE(res, nullptr);
+    ObjListKeeper keeper_res(res);
+
+    ASSERT_EQ(proj_list_get_count(res), 1);
+    auto op = proj_list_get(m_ctxt, res, 0);
+    ASSERT_NE(op, nullptr);
+    ObjectKeeper keeper_op(op);
+    EXPECT_EQ(std::string(proj_get_name(op)), "GDA94 to GDA2020 (1)");
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_create_operations_max_result_count) {
+    auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
+    ASSERT_NE(ctxt, nullptr);
+    ContextKeeper keeper_ctxt(ctxt);
+
+    auto source_crs = proj_create_from_database(
+        m_ctxt, "EPSG", "4267", PJ_CATEGORY_CRS, false, nullptr); // NAD27
+    ASSERT_NE(source_crs, nullptr);
+    ObjectKeeper keeper_source_crs(source_crs);
+
+    auto target_crs = proj_create_from_database(
+        m_ctxt, "EPSG", "4269", PJ_CATEGORY_CRS, false, nullptr); // NAD83
+    ASSERT_NE(target_crs, nullptr);
+    ObjectKeeper keeper_target_crs(target_crs);
+
+    proj_operation_factory_context_set_spatial_criterion(
+        m_ctxt, ctxt, PROJ_SPATIAL_CRITERION_PARTIAL_INTERSECTION);
+    proj_operation_factory_context_set_grid_availability_use(
+        m_ctxt, ctxt, PROJ_GRID_AVAILABILITY_IGNORED);
+
+    auto resFull =
+        proj_create_operations(m_ctxt, source_crs, target_crs, ctxt);
+    ASSERT_NE(resFull, nullptr);
+    ObjListKeeper keeper_resFull(resFull);
+    ASSERT_GT(proj_list_get_count(resFull), 2);
+
+    proj_operation_factory_context_set_max_result_count(m_ctxt, ctxt, 2);
+
+    auto res = proj_create_operations(m_ctxt, source_crs, target_crs, ctxt);
+    ASSERT_NE(res, nullptr);
+    ObjListKeeper keeper_res(res);
+    ASSERT_EQ(proj_list_get_count(res), 2);
+    for (int i = 0; i < 2; ++i) {
+        auto op = proj_list_get(m_ctxt, res, i);
+        ASSERT_NE(op, nullptr);
+        ObjectKeeper keeper_op(op);
+        auto opFull = proj_list_get(m_ctxt, resFull, i);
+        ASSERT_NE(opFull, nullptr);
+        ObjectKeeper keeper_opFull(opFull);
+        EXPECT_EQ(std::string(proj_get_name(op)),
+                  std::string(proj_get_name(opFull)));
+    }
+
+    proj_operation_factory_context_set_max_result_count(m_ctxt, ctxt, 0);
+
+    auto resUnlimited =
+        proj_create_operations(m_ctxt, source_crs, target_crs, ctxt);
+    ASSERT_NE(resUnlimited, nullptr);
+    ObjListKeeper keeper_resUnlimited(resUnlimited);
+    EXPECT_EQ(proj_list_get_count(resUnlimited), proj_list_get_count(resFull));
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_create_operations_with_pivot) {
 
     auto source_crs = proj_create_from_database(
@@ -3270,6 +3354,50 @@ TEST_F(CApi, proj_clone) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_clone_of_instantiated_pipeline) {
+    auto obj = proj_create(
+        m_ctxt, "+proj=pipeline +step +proj=axisswap +order=2,1 "
+                "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+                "+step +proj=push +v_3 "
+                "+step +proj=cart +ellps=GRS80 "
+                "+step +proj=helmert +x=1 +y=2 +z=3 "
+                "+step +inv +proj=cart +ellps=GRS80 "
+                "+step +proj=pop +v_3 "
+                "+step +proj=utm +zone=31 +ellps=GRS80 "
+                "+step +proj=unitconvert +xy_in=m +xy_out=km");
+    ObjectKeeper keeper(obj);
+    ASSERT_NE(obj, nullptr);
+
+    PJ_COORD c = proj_coord(49, 2, 100, 0);
+    PJ_COORD c_trans_ref = proj_trans(obj, PJ_FWD, c);
+    ASSERT_NE(c_trans_ref.xyzt.x, HUGE_VAL);
+
+    auto ctx = proj_context_create();
+    auto clone = proj_clone(ctx, obj);
+    ObjectKeeper keeperClone(clone);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_TRUE(proj_is_equivalent_to(obj, clone, PJ_COMP_STRICT));
+
+    keeper.clear();
+    obj = nullptr;
+    (void)obj;
+
+    PJ_COORD c_trans = proj_trans(clone, PJ_FWD, c);
+    EXPECT_EQ(c_trans.xyzt.x, c_trans_ref.xyzt.x);
+    EXPECT_EQ(c_trans.xyzt.y, c_trans_ref.xyzt.y);
+    EXPECT_EQ(c_trans.xyzt.z, c_trans_ref.xyzt.z);
+
+    PJ_COORD c_inv = proj_trans(clone, PJ_INV, c_trans);
+    EXPECT_NEAR(c_inv.xyzt.x, c.xyzt.x, 1e-10);
+    EXPECT_NEAR(c_inv.xyzt.y, c.xyzt.y, 1e-10);
+    EXPECT_NEAR(c_inv.xyzt.z, c.xyzt.z, 1e-10);
+
+    keeperClone.clear();
+    proj_context_destroy(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_clone_of_obj_with_alternative_operations) {
     // NAD27 to NAD83
     auto obj =
@@ -6513,6 +6641,69 @@ TEST_F(CApi, proj_trans_bounds__south_pole) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_prepare_for_area) {
+    size_t bytesLoaded = 1;
+    EXPECT_FALSE(
+        proj_prepare_for_area(nullptr, PJ_FWD, 0, 0, 1, 1, &bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 0U);
+
+    {
+        auto crs = proj_create(m_ctxt, "EPSG:4326");
+        ObjectKeeper keeper_crs(crs);
+        ASSERT_NE(crs, nullptr);
+        EXPECT_FALSE(proj_prepare_for_area(crs, PJ_FWD, 0, 0, 1, 1, nullptr));
+    }
+
+    // Grid format without prefetching
+    {
+        auto P = proj_create(
+            m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                    "+xy_out=rad +step +proj=hgridshift +grids=conus "
+                    "+step +proj=unitconvert +xy_in=rad +xy_out=deg");
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+        EXPECT_TRUE(proj_prepare_for_area(P, PJ_FWD, -100, 40, -99, 41,
+                                          &bytesLoaded));
+        EXPECT_EQ(bytesLoaded, 0U);
+        EXPECT_TRUE(proj_prepare_for_area(P, PJ_INV, -100, 40, -99, 41,
+                                          &bytesLoaded));
+        EXPECT_EQ(proj_errno(P), 0);
+    }
+
+#ifdef TIFF_ENABLED
+    {
+        auto P = proj_create(
+            m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                    "+xy_out=rad +step +proj=push +v_1 +v_2 +step "
+                    "+proj=vgridshift +grids=tests/test_vgrid_int16.tif "
+                    "+multiplier=1 +step +proj=pop +v_1 +v_2 +step "
+                    "+proj=unitconvert +xy_in=rad +xy_out=deg");
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+
+        // Area not intersecting the grid
+        EXPECT_TRUE(
+            proj_prepare_for_area(P, PJ_FWD, -10, -10, -9, -9, &bytesLoaded));
+        EXPECT_EQ(bytesLoaded, 0U);
+
+        EXPECT_TRUE(proj_prepare_for_area(P, PJ_FWD, 4.4, 52.4, 4.6, 52.6,
+                                          &bytesLoaded));
+        EXPECT_GT(bytesLoaded, 0U);
+
+        // Already loaded
+        EXPECT_TRUE(proj_prepare_for_area(P, PJ_FWD, 4.4, 52.4, 4.6, 52.6,
+                                          &bytesLoaded));
+        EXPECT_EQ(bytesLoaded, 0U);
+
+        PJ_COORD c = proj_coord(4.5, 52.5, 0, 0);
+        c = proj_trans(P, PJ_FWD, c);
+        EXPECT_NEAR(c.xyz.z, 11.5, 1e-10);
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_crs_has_point_motion_operation) {
     auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
     ASSERT_NE(ctxt, nullptr);
@@ -6679,6 +6870,122 @@ TEST_F(CApi, concurrent_context) {
     proj_cleanup();
 }
 
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_shared) {
+    // One operation without and one with alternative operations
+    const std::pair<const char *, const char *> crsPairs[] = {
+        {"EPSG:4326", "EPSG:32631"}, {"EPSG:4267", "EPSG:4326"}};
+    for (const auto &crsPair : crsPairs) {
+        auto P = proj_create_crs_to_crs(m_ctxt, crsPair.first, crsPair.second,
+                                        nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+
+        std::vector<PJ_COORD> input;
+        for (int i = 0; i < 20; i++)
+            input.push_back(proj_coord(40 + 0.1 * i, 2 - 0.05 * i, 0, 0));
+        std::vector<PJ_COORD> expected;
+        for (const auto &c : input)
+            expected.push_back(proj_trans(P, PJ_FWD, c));
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back(std::thread([P, &input, &expected] {
+                PJ_CONTEXT *ctxt = proj_context_create();
+                PJ_TRANS_STATE *state = proj_trans_state_create(ctxt);
+                for (int j = 0; j < 10; j++) {
+                    for (size_t k = 0; k < input.size(); k++) {
+                        PJ_COORD c =
+                            proj_trans_shared(P, state, PJ_FWD, input[k]);
+                        EXPECT_EQ(c.xy.x, expected[k].xy.x);
+                        EXPECT_EQ(c.xy.y, expected[k].xy.y);
+                    }
+                    auto coords = input;
+                    EXPECT_EQ(proj_trans_array_shared(P, state, PJ_FWD,
+                                                      coords.size(),
+                                                      coords.data()),
+                              0);
+                    for (size_t k = 0; k < coords.size(); k++) {
+                        EXPECT_EQ(coords[k].xy.x, expected[k].xy.x);
+                        EXPECT_EQ(coords[k].xy.y, expected[k].xy.y);
+                    }
+                }
+                proj_trans_state_destroy(state);
+                proj_context_destroy(ctxt);
+            }));
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+
+    // Errors are reported in the context of the state
+    PJ_CONTEXT *ctxt = proj_context_create();
+    PJ_TRANS_STATE *state = proj_trans_state_create(ctxt);
+    auto P = proj_create(m_ctxt, "+proj=merc +ellps=WGS84");
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+    PJ_COORD c = proj_trans_shared(P, state, PJ_INV,
+                                   proj_coord(HUGE_VAL, HUGE_VAL, 0, 0));
+    EXPECT_EQ(c.xy.x, HUGE_VAL);
+    EXPECT_EQ(proj_context_errno(m_ctxt), 0);
+    PJ_COORD coords[] = {proj_coord(0, 0, 0, 0), proj_coord(0, 91, 0, 0)};
+    EXPECT_NE(proj_trans_array_shared(P, state, PJ_FWD, 2, coords), 0);
+    EXPECT_NE(proj_context_errno(ctxt), 0);
+    EXPECT_EQ(proj_context_errno(m_ctxt), 0);
+    EXPECT_EQ(proj_trans_array_shared(nullptr, state, PJ_FWD, 2, coords),
+              PROJ_ERR_OTHER_API_MISUSE);
+
+    // Copies of destroyed objects are evicted, and not used for objects
+    // allocated at their address
+    for (int i = 0; i < 10; i++) {
+        auto P2 = proj_create(m_ctxt, i % 2 ? "+proj=merc +ellps=WGS84"
+                                            : "+proj=eqc +ellps=WGS84");
+        ASSERT_NE(P2, nullptr);
+        const PJ_COORD in = proj_coord(0.1, 0.2, 0, 0);
+        const PJ_COORD expected = proj_trans(P2, PJ_FWD, in);
+        c = proj_trans_shared(P2, state, PJ_FWD, in);
+        EXPECT_EQ(c.xy.x, expected.xy.x);
+        EXPECT_EQ(c.xy.y, expected.xy.y);
+        proj_destroy(P2);
+    }
+    proj_trans_state_destroy(state);
+    proj_context_destroy(ctxt);
+
+    // Copies share the grids of the shared object: they are not looked for
+    // again in the context of the state, where they cannot be found
+    auto P3 = proj_create(
+        m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                "+xy_out=rad +step +proj=hgridshift +grids=conus "
+                "+step +proj=unitconvert +xy_in=rad +xy_out=deg");
+    ObjectKeeper keeper_P3(P3);
+    ASSERT_NE(P3, nullptr);
+    // Opens the grid, which may have been deferred
+    const PJ_COORD in = proj_coord(-100, 40, 0, 0);
+    const PJ_COORD expected = proj_trans(P3, PJ_FWD, in);
+    ASSERT_NE(expected.xy.x, HUGE_VAL);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back(std::thread([P3, in, expected] {
+            PJ_CONTEXT *ctxt3 = proj_context_create();
+            const char *searchPath = "/i_do/not/exist";
+            proj_context_set_search_paths(ctxt3, 1, &searchPath);
+            PJ_TRANS_STATE *state3 = proj_trans_state_create(ctxt3);
+            for (int j = 0; j < 100; j++) {
+                PJ_COORD c3 = proj_trans_shared(P3, state3, PJ_FWD, in);
+                EXPECT_EQ(c3.xy.x, expected.xy.x);
+                EXPECT_EQ(c3.xy.y, expected.xy.y);
+            }
+            proj_trans_state_destroy(state3);
+            proj_context_destroy(ctxt3);
+        }));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
 #endif // __MINGW32__
 
 } // namespace
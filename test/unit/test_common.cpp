@@ -28,14 +28,22 @@
 
 #include "gtest_include.h"
 
+// to be able to use internal::intern
+#ifndef FROM_PROJ_CPP
+#define FROM_PROJ_CPP
+#endif
+
 #include "proj/common.hpp"
 #include "proj/coordinateoperation.hpp"
 #include "proj/metadata.hpp"
 #include "proj/util.hpp"
 
+#include "proj/internal/internal.hpp"
+
 #include <limits>
 
 using namespace osgeo::proj::common;
+using namespace osgeo::proj::internal;
 using namespace osgeo::proj::metadata;
 using namespace osgeo::proj::operation;
 using namespace osgeo::proj::util;
@@ -71,6 +79,53 @@ TEST(common, unit_of_measure) {
 
 // ---------------------------------------------------------------------------
 
+TEST(common, unit_of_measure_interned_strings) {
+    const std::string name("metre");
+    UnitOfMeasure metre(name, 1.0, UnitOfMeasure::Type::LINEAR,
+                        std::string("EPSG"), "9001");
+    EXPECT_TRUE(metre == UnitOfMeasure::METRE);
+    EXPECT_EQ(&metre.name(), &UnitOfMeasure::METRE.name());
+    EXPECT_EQ(&metre.codeSpace(), &UnitOfMeasure::METRE.codeSpace());
+    EXPECT_TRUE(metre != UnitOfMeasure::DEGREE);
+
+    auto id = Identifier::create(
+        "1234", PropertyMap().set(Identifier::CODESPACE_KEY, "EPSG"));
+    EXPECT_EQ(&*(id->codeSpace()), &metre.codeSpace());
+
+    // Strings that do not come from the database or built-in objects are
+    // not added to the interned strings
+    const std::string userName("unit_of_measure_interned_strings unit");
+    UnitOfMeasure userUnitA(userName, 2.0, UnitOfMeasure::Type::LINEAR);
+    UnitOfMeasure userUnitB(userName, 2.0, UnitOfMeasure::Type::LINEAR);
+    EXPECT_EQ(intern(userName), nullptr);
+    EXPECT_EQ(userUnitA.name(), userName);
+    EXPECT_NE(&userUnitA.name(), &userUnitB.name());
+    EXPECT_TRUE(userUnitA == userUnitB);
+    EXPECT_TRUE(userUnitA != metre);
+
+    const std::string userParamName(
+        "unit_of_measure_interned_strings parameter");
+    auto userParam = OperationParameter::create(
+        PropertyMap().set(IdentifiedObject::NAME_KEY, userParamName));
+    EXPECT_EQ(intern(userParamName), nullptr);
+    EXPECT_EQ(userParam->nameStr(), userParamName);
+
+    // They are while an InterningScope is active
+    {
+        const InterningScope interningScope;
+        auto paramA = OperationParameter::create(
+            PropertyMap().set(IdentifiedObject::NAME_KEY, userParamName));
+        auto paramB = OperationParameter::create(
+            PropertyMap().set(IdentifiedObject::NAME_KEY, userParamName));
+        EXPECT_EQ(&paramA->nameStr(), &paramB->nameStr());
+        EXPECT_EQ(&paramA->nameStr(), intern(userParamName));
+    }
+    EXPECT_NE(intern(userParamName), nullptr);
+    EXPECT_EQ(intern(userName), nullptr);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(common, measure) {
     EXPECT_TRUE(Measure(0.0) == Measure(0.0));
     EXPECT_TRUE(Measure(1.0) == Measure(1.0));
@@ -124,6 +179,45 @@ TEST(common, identifiedobject) {
 
 // ---------------------------------------------------------------------------
 
+TEST(common, identifiedobject_equivalent_name) {
+    const char *const names[] = {"",
+                                 "x",
+                                 "X",
+                                 "y",
+                                 "Central_Meridian",
+                                 "Central_- ()/Meridian",
+                                 "\xc3\xa1",
+                                 "\xc3",
+                                 "a",
+                                 "foo + ",
+                                 "foo + bar",
+                                 "foobar",
+                                 "WGS 1984",
+                                 "WGS_84",
+                                 "1984",
+                                 "84",
+                                 "D_NAD_1983_2011"};
+    std::vector<OperationParameterNNPtr> params;
+    for (const char *name : names) {
+        params.emplace_back(OperationParameter::create(
+            PropertyMap().set(IdentifiedObject::NAME_KEY, name)));
+    }
+    // Compare twice, as normalized names are only computed on first use
+    for (int iter = 0; iter < 2; ++iter) {
+        for (const auto &a : params) {
+            for (const auto &b : params) {
+                EXPECT_EQ(a->isEquivalentTo(
+                              b.get(), IComparable::Criterion::EQUIVALENT),
+                          Identifier::isEquivalentName(a->nameStr().c_str(),
+                                                       b->nameStr().c_str()))
+                    << a->nameStr() << " vs " << b->nameStr();
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(common, identifiedobject_name_invalid_type_integer) {
     PropertyMap properties;
     properties.set(IdentifiedObject::NAME_KEY, 123);
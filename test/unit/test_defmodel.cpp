@@ -1379,6 +1379,74 @@ TEST(defmodel, evaluator_horizontal_unit_metre) {
         EXPECT_NEAR(dn, tFactor * expected_dn, 1e-9);
         EXPECT_NEAR(newZ - zVal, tFactor * 0.84, 1e-4);
     }
+
+    // Test batch forward() against single point forward(), with a time
+    // function varying with time
+    {
+        j["horizontal_offset_method"] = "geocentric";
+        j["components"][0]["displacement_type"] = "3d";
+        j["components"][0]["spatial_model"]["interpolation_method"] =
+            "geocentric_bilinear";
+        auto &timeFunctionModel =
+            j["components"][0]["time_function"]["parameters"]["model"];
+        timeFunctionModel[1]["scale_factor"] = 2 * tFactor;
+        Evaluator<Grid, GridSet, EvaluatorIface> evalBatch(
+            MasterFile::parse(j.dump()), iface, a, b);
+        Evaluator<Grid, GridSet, EvaluatorIface> evalSingle(
+            MasterFile::parse(j.dump()), iface, a, b);
+
+        const double stations[][2] = {
+            {165.9, -37.3}, {gridMinX, gridMinY}, {166.1, -37.25}};
+        const double epochs[] = {2012.5, 2018, 1000 /* invalid */, 2015.25};
+        std::vector<PJ_COORD> coords;
+        // Interleave stations and epochs
+        for (const double epoch : epochs) {
+            for (const auto &station : stations) {
+                coords.push_back(proj_coord(DegToRad(station[0]),
+                                            DegToRad(station[1]), zVal, epoch));
+            }
+        }
+        // NaN coordinates cannot be ordered with the other ones
+        coords.insert(coords.begin() + 1,
+                      proj_coord(std::numeric_limits<double>::quiet_NaN(),
+                                 DegToRad(stations[0][1]), zVal, 2018));
+        coords.push_back(proj_coord(DegToRad(stations[0][0]),
+                                    std::numeric_limits<double>::quiet_NaN(),
+                                    zVal, 2018));
+        const auto coordsIn = coords;
+        EXPECT_EQ(evalBatch.forward(iface, coords.size(), &coords[0].xyzt.x, 4,
+                                    &coords[0].xyzt.y, 4, &coords[0].xyzt.z, 4,
+                                    &coords[0].xyzt.t, 4),
+                  coords.size() - 5);
+        // The time function is evaluated once per valid epoch, although the
+        // points sharing an epoch are at different stations
+        EXPECT_EQ(evalBatch.timeFunctionEvaluationCount(), 3U);
+        for (size_t i = 0; i < coords.size(); ++i) {
+            if (std::isnan(coordsIn[i].xyzt.x) ||
+                std::isnan(coordsIn[i].xyzt.y)) {
+                EXPECT_EQ(coords[i].xyzt.x, HUGE_VAL);
+                continue;
+            }
+            double newLong;
+            double newLat;
+            double newZ;
+            if (coordsIn[i].xyzt.t == 1000) {
+                EXPECT_FALSE(evalSingle.forward(
+                    iface, coordsIn[i].xyzt.x, coordsIn[i].xyzt.y,
+                    coordsIn[i].xyzt.z, coordsIn[i].xyzt.t, newLong, newLat,
+                    newZ));
+                EXPECT_EQ(coords[i].xyzt.x, HUGE_VAL);
+                continue;
+            }
+            EXPECT_TRUE(evalSingle.forward(
+                iface, coordsIn[i].xyzt.x, coordsIn[i].xyzt.y,
+                coordsIn[i].xyzt.z, coordsIn[i].xyzt.t, newLong, newLat, newZ));
+            EXPECT_EQ(coords[i].xyzt.x, newLong) << i;
+            EXPECT_EQ(coords[i].xyzt.y, newLat) << i;
+            EXPECT_EQ(coords[i].xyzt.z, newZ) << i;
+            EXPECT_EQ(coords[i].xyzt.t, coordsIn[i].xyzt.t);
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
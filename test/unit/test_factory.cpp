@@ -74,6 +74,78 @@ TEST(factory, databasecontext_create) {
 
 // ---------------------------------------------------------------------------
 
+TEST(factory, databasecontext_setUseObjectArena) {
+    auto refFactory =
+        AuthorityFactory::create(DatabaseContext::create(), "EPSG");
+    const auto refWKT =
+        refFactory->createProjectedCRS("32631")->exportToWKT(
+            WKTFormatter::create().get());
+    const auto refOps =
+        refFactory->createFromCoordinateReferenceSystemCodes("4326", "4258");
+
+    CRSPtr crs;
+    std::vector<CoordinateOperationNNPtr> ops;
+    {
+        auto dbContext = DatabaseContext::create();
+        dbContext->setUseObjectArena(true);
+        auto factory = AuthorityFactory::create(dbContext, "EPSG");
+        crs = factory->createProjectedCRS("32631").as_nullable();
+        ops = factory->createFromCoordinateReferenceSystemCodes("4326", "4258");
+        EXPECT_TRUE(ObjectArena::active() == nullptr);
+
+        // The objects were allocated from the arena of the context, in a
+        // few chunks of memory
+        const auto arena = dbContext->getObjectArena();
+        ASSERT_TRUE(arena != nullptr);
+        EXPECT_GT(arena->usedSize(), 10U * 1024);
+        EXPECT_GE(arena->reservedSize(), arena->usedSize());
+        EXPECT_LE(arena->reservedSize(), 512U * 1024);
+        EXPECT_FALSE(arena->full());
+    }
+
+    // Objects remain valid after the context and its arena are released
+    ASSERT_TRUE(crs != nullptr);
+    EXPECT_EQ(crs->exportToWKT(WKTFormatter::create().get()), refWKT);
+    ASSERT_EQ(ops.size(), refOps.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        EXPECT_TRUE(ops[i]->isEquivalentTo(refOps[i].get()));
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(factory, databasecontext_setUseObjectArena_full) {
+    std::weak_ptr<ObjectArena> firstArena;
+    {
+        auto dbContext = DatabaseContext::create();
+        dbContext->setUseObjectArena(true);
+        auto factory = AuthorityFactory::create(dbContext, "EPSG");
+        firstArena = dbContext->getObjectArena();
+        ASSERT_FALSE(firstArena.expired());
+
+        // Once full, the arena is replaced by a new one
+        const auto codes = factory->getAuthorityCodes(
+            AuthorityFactory::ObjectType::PROJECTED_CRS);
+        for (const auto &code : codes) {
+            factory->createProjectedCRS(code);
+            if (dbContext->getObjectArena() != firstArena.lock())
+                break;
+        }
+        auto arena = firstArena.lock();
+        ASSERT_TRUE(arena != nullptr);
+        EXPECT_TRUE(arena->full());
+        EXPECT_LE(arena->reservedSize(), 1024U * 1024 + 64 * 1024);
+        ASSERT_TRUE(dbContext->getObjectArena() != nullptr);
+        EXPECT_NE(dbContext->getObjectArena(), arena);
+        EXPECT_FALSE(dbContext->getObjectArena()->full());
+    }
+
+    // And released with the last of its objects
+    EXPECT_TRUE(firstArena.expired());
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(factory, AuthorityFactory_createObject) {
     auto factory = AuthorityFactory::create(DatabaseContext::create(), "EPSG");
     EXPECT_THROW(factory->createObject("-1"), NoSuchAuthorityCodeException);
@@ -0,0 +1,385 @@
+/******************************************************************************
+ *
+ * Project:  PROJ
+ * Purpose:  Test geod_batch.h
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gtest_include.h"
+
+#include "geod_batch.h"
+
+#include "proj_internal.h" // M_PI
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+
+// lat1, lon1, azi1, lat2, lon2, azi2, s12, from src/tests/geodtest.c
+const double testcases[][7] = {
+    {35.60777, -139.44815, 111.098748429560326, -11.17491, -69.95921,
+     129.289270889708762, 8935244.5604818305},
+    {55.52454, 106.05087, 22.020059880982801, 77.03196, 197.18234,
+     109.112041110671519, 4105086.1713924406},
+    {-21.97856, 142.59065, -32.44456876433189, 41.84138, 98.56635,
+     -41.84359951440466, 8394328.894657671},
+    {-66.99028, 112.2363, 173.73491240878403, -12.70631, 285.90344,
+     2.512956620913668, 11150344.2312080241},
+    {-17.42761, 173.34268, -159.033557661192928, -15.84784, 5.93557,
+     -20.787484651536988, 16076603.1631180673},
+};
+constexpr int ncases = sizeof(testcases) / sizeof(testcases[0]);
+
+// ---------------------------------------------------------------------------
+
+class GeodBatchTest : public ::testing::Test {
+  protected:
+    void SetUp() override { geod_init(&g, 6378137, 1 / 298.257223563); }
+
+    struct geod_geodesic g {};
+};
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, inverse_array) {
+    std::vector<double> lat1, lon1, lat2, lon2;
+    for (const auto &tc : testcases) {
+        lat1.push_back(tc[0]);
+        lon1.push_back(tc[1]);
+        lat2.push_back(tc[3]);
+        lon2.push_back(tc[4]);
+    }
+    std::vector<double> s12(ncases), azi1(ncases), azi2(ncases);
+    geod_inverse_array(&g, ncases, lat1.data(), lon1.data(), lat2.data(),
+                       lon2.data(), s12.data(), azi1.data(), azi2.data());
+    for (int i = 0; i < ncases; ++i) {
+        double s12a, azi1a, azi2a;
+        geod_inverse(&g, lat1[i], lon1[i], lat2[i], lon2[i], &s12a, &azi1a,
+                     &azi2a);
+        EXPECT_EQ(s12[i], s12a);
+        EXPECT_EQ(azi1[i], azi1a);
+        EXPECT_EQ(azi2[i], azi2a);
+        EXPECT_NEAR(s12[i], testcases[i][6], 1e-8);
+    }
+
+    // Consecutive points of a track, output only the distances, in place
+    s12 = lat1;
+    geod_inverse_array(&g, ncases - 1, s12.data(), lon1.data(),
+                       lat1.data() + 1, lon1.data() + 1, s12.data(), nullptr,
+                       nullptr);
+    for (int i = 0; i < ncases - 1; ++i) {
+        double s12a;
+        geod_inverse(&g, lat1[i], lon1[i], lat1[i + 1], lon1[i + 1], &s12a,
+                     nullptr, nullptr);
+        EXPECT_EQ(s12[i], s12a);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, direct_array) {
+    std::vector<double> lat1, lon1, azi1, s12;
+    for (const auto &tc : testcases) {
+        lat1.push_back(tc[0]);
+        lon1.push_back(tc[1]);
+        azi1.push_back(tc[2]);
+        s12.push_back(tc[6]);
+    }
+    std::vector<double> lat2(ncases), lon2(ncases), azi2(ncases);
+    geod_direct_array(&g, ncases, lat1.data(), lon1.data(), azi1.data(),
+                      s12.data(), lat2.data(), lon2.data(), azi2.data());
+    for (int i = 0; i < ncases; ++i) {
+        double lat2a, lon2a, azi2a;
+        geod_direct(&g, lat1[i], lon1[i], azi1[i], s12[i], &lat2a, &lon2a,
+                    &azi2a);
+        EXPECT_EQ(lat2[i], lat2a);
+        EXPECT_EQ(lon2[i], lon2a);
+        EXPECT_EQ(azi2[i], azi2a);
+        EXPECT_NEAR(lat2[i], testcases[i][3], 1e-13);
+    }
+
+    // In place, without the azimuths
+    geod_direct_array(&g, ncases, lat1.data(), lon1.data(), azi1.data(),
+                      s12.data(), lat1.data(), lon1.data(), nullptr);
+    for (int i = 0; i < ncases; ++i) {
+        EXPECT_EQ(lat1[i], lat2[i]);
+        EXPECT_EQ(lon1[i], lon2[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Same value, NaN and sign of zero included
+::testing::AssertionResult isSame(double a, double b) {
+    if ((std::isnan(a) && std::isnan(b)) ||
+        (a == b && std::signbit(a) == std::signbit(b)))
+        return ::testing::AssertionSuccess();
+    return ::testing::AssertionFailure() << a << " != " << b;
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(GeodBatch, arrays_same_as_scalar) {
+    // Random geodesics mixed with the special cases of geodesic.c: poles,
+    // equator, meridians, nearly antipodal and coincident points, and
+    // invalid values. The lanes are filled by several kinds of geodesics.
+    const double special[] = {0,  -0.0,  90,    -90, 180,   -180,
+                              45, 1e-20, 91,    360, 1e-15, NAN};
+    constexpr int nspecial = sizeof(special) / sizeof(special[0]);
+    constexpr int N = 2003;
+    std::vector<double> lat1(N), lon1(N), lat2(N), lon2(N), azi1(N), s12(N);
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    const auto pick = [&]() { return special[gen() % nspecial]; };
+    for (int i = 0; i < N; ++i) {
+        lat1[i] = 90 * dist(gen);
+        lon1[i] = 540 * dist(gen);
+        lat2[i] = 90 * dist(gen);
+        lon2[i] = 540 * dist(gen);
+        azi1[i] = 180 * dist(gen);
+        s12[i] = 2e7 * dist(gen);
+        switch (i % 10) {
+        case 0:
+            lat1[i] = pick();
+            break;
+        case 1:
+            lon1[i] = pick();
+            azi1[i] = pick();
+            break;
+        case 2:
+            lat2[i] = pick();
+            break;
+        case 3:
+            lat2[i] = -lat1[i];
+            lon2[i] = lon1[i] + 179.5;
+            break;
+        case 4:
+            lon2[i] = lon1[i];
+            break;
+        case 5:
+            lon2[i] = lon1[i] + 180;
+            break;
+        case 6:
+            lat2[i] = lat1[i] + 1e-7;
+            lon2[i] = lon1[i] + 1e-7;
+            break;
+        case 7:
+            lat1[i] = lat2[i] = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (double f : {1 / 298.257223563, 0.0, -1 / 150.0, 1 / 50.0, 0.1}) {
+        struct geod_geodesic g;
+        geod_init(&g, 6378137, f);
+
+        std::vector<double> s12a(N), azi1a(N), azi2a(N);
+        geod_inverse_array(&g, N, lat1.data(), lon1.data(), lat2.data(),
+                           lon2.data(), s12a.data(), azi1a.data(),
+                           azi2a.data());
+        for (int i = 0; i < N; ++i) {
+            double s12x, azi1x, azi2x;
+            geod_inverse(&g, lat1[i], lon1[i], lat2[i], lon2[i], &s12x,
+                         &azi1x, &azi2x);
+            EXPECT_TRUE(isSame(s12a[i], s12x)) << "f=" << f << " i=" << i;
+            EXPECT_TRUE(isSame(azi1a[i], azi1x)) << "f=" << f << " i=" << i;
+            EXPECT_TRUE(isSame(azi2a[i], azi2x)) << "f=" << f << " i=" << i;
+        }
+
+        std::vector<double> lat2a(N), lon2a(N);
+        geod_direct_array(&g, N, lat1.data(), lon1.data(), azi1.data(),
+                          s12.data(), lat2a.data(), lon2a.data(),
+                          azi2a.data());
+        for (int i = 0; i < N; ++i) {
+            double lat2x, lon2x, azi2x;
+            geod_direct(&g, lat1[i], lon1[i], azi1[i], s12[i], &lat2x, &lon2x,
+                        &azi2x);
+            EXPECT_TRUE(isSame(lat2a[i], lat2x)) << "f=" << f << " i=" << i;
+            EXPECT_TRUE(isSame(lon2a[i], lon2x)) << "f=" << f << " i=" << i;
+            EXPECT_TRUE(isSame(azi2a[i], azi2x)) << "f=" << f << " i=" << i;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, distances_and_nearest) {
+    std::vector<double> lat1, lon1, lat2, lon2;
+    for (const auto &tc : testcases) {
+        lat1.push_back(tc[0]);
+        lon1.push_back(tc[1]);
+        lat2.push_back(tc[3]);
+        lon2.push_back(tc[4]);
+    }
+    std::vector<double> s12(ncases * ncases);
+    geod_distances(&g, lat1.data(), lon1.data(), ncases, lat2.data(),
+                   lon2.data(), ncases, s12.data(), 1);
+    for (int i = 0; i < ncases; ++i) {
+        for (int j = 0; j < ncases; ++j) {
+            double s12a;
+            geod_inverse(&g, lat1[i], lon1[i], lat2[j], lon2[j], &s12a,
+                         nullptr, nullptr);
+            EXPECT_EQ(s12[i * ncases + j], s12a);
+        }
+        EXPECT_NEAR(s12[i * ncases + i], testcases[i][6], 1e-8);
+
+        double s12min = 0;
+        const int k = geod_nearest(&g, lat1[i], lon1[i], lat2.data(),
+                                   lon2.data(), ncases, &s12min);
+        ASSERT_GE(k, 0);
+        EXPECT_EQ(s12min, s12[i * ncases + k]);
+        for (int j = 0; j < ncases; ++j) {
+            EXPECT_TRUE(s12[i * ncases + j] > s12min ||
+                        (j >= k && s12[i * ncases + j] == s12min));
+        }
+    }
+
+    double s12min = 0;
+    EXPECT_EQ(geod_nearest(&g, lat1[0], lon1[0], lat2.data(), lon2.data(), 0,
+                           &s12min),
+              -1);
+    EXPECT_TRUE(std::isnan(s12min));
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, distances_threads) {
+    // Rows whose length is not a multiple of the number of lanes, computed
+    // by several threads, with points repeated, on the poles and invalid.
+    constexpr int n1 = 37;
+    constexpr int n2 = 53;
+    std::vector<double> lat1, lon1, lat2, lon2;
+    for (int i = 0; i < n1; ++i) {
+        lat1.push_back(i == 0 ? 90 : (i == 1 ? 91 : -85 + 4.7 * i));
+        lon1.push_back(-180 + 9.8 * i);
+    }
+    for (int j = 0; j < n2; ++j) {
+        lat2.push_back(j < n1 ? lat1[j] : 60 - 3.1 * j);
+        lon2.push_back(j < n1 ? lon1[j] : 7.3 * j);
+    }
+    std::vector<double> s12(n1 * n2);
+    geod_distances(&g, lat1.data(), lon1.data(), n1, lat2.data(), lon2.data(),
+                   n2, s12.data(), 4);
+    for (int i = 0; i < n1; ++i) {
+        for (int j = 0; j < n2; ++j) {
+            double s12a;
+            geod_inverse(&g, lat1[i], lon1[i], lat2[j], lon2[j], &s12a,
+                         nullptr, nullptr);
+            EXPECT_TRUE(isSame(s12[i * n2 + j], s12a)) << i << " " << j;
+        }
+
+        double s12min = 0;
+        const int k = geod_nearest(&g, lat1[i], lon1[i], lat2.data(),
+                                   lon2.data(), n2, &s12min);
+        if (i == 1) {
+            EXPECT_EQ(k, -1);
+            continue;
+        }
+        // The first occurrence of the point itself
+        EXPECT_EQ(k, i);
+        EXPECT_EQ(s12min, 0);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, polygon_addpoints) {
+    std::vector<double> lats, lons;
+    for (const auto &tc : testcases) {
+        lats.push_back(tc[0]);
+        lons.push_back(tc[1]);
+    }
+    for (int polyline = 1; polyline >= 0; --polyline) {
+        struct geod_polygon p;
+        geod_polygon_init(&p, polyline);
+        for (int i = 0; i < ncases; ++i)
+            geod_polygon_addpoint(&g, &p, lats[i], lons[i]);
+        double A = 0, P = 0;
+        geod_polygon_compute(&g, &p, 0, 1, &A, &P);
+
+        // Mix with geod_polygon_addpoint()
+        struct geod_polygon pa;
+        geod_polygon_init(&pa, polyline);
+        geod_polygon_addpoints(&g, &pa, lats.data(), lons.data(), 0, 1);
+        geod_polygon_addpoint(&g, &pa, lats[0], lons[0]);
+        geod_polygon_addpoints(&g, &pa, lats.data() + 1, lons.data() + 1, 2,
+                               4);
+        geod_polygon_addpoints(&g, &pa, lats.data() + 3, lons.data() + 3,
+                               ncases - 3, 1);
+        EXPECT_EQ(pa.num, p.num);
+        double Aa = 0, Pa = 0;
+        geod_polygon_compute(&g, &pa, 0, 1, &Aa, &Pa);
+        EXPECT_EQ(Pa, P);
+        if (!polyline) {
+            EXPECT_EQ(Aa, A);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GeodBatchTest, polygon_addpoints_many_points) {
+    // Enough vertices for the edges to be computed by chunks, crossing the
+    // prime and anti meridians.
+    std::vector<double> lats, lons;
+    constexpr int N = 10000;
+    for (int i = 0; i < N; ++i) {
+        const double t = 2 * M_PI * i / N;
+        lats.push_back(40 * std::sin(t) + 5 * std::sin(37 * t));
+        lons.push_back(170 * std::cos(t) + 3 * std::cos(53 * t));
+    }
+    for (int polyline = 1; polyline >= 0; --polyline) {
+        struct geod_polygon p;
+        geod_polygon_init(&p, polyline);
+        for (int i = 0; i < N; ++i)
+            geod_polygon_addpoint(&g, &p, lats[i], lons[i]);
+        double A = 0, P = 0;
+        geod_polygon_compute(&g, &p, 0, 1, &A, &P);
+
+        // On the calling thread only, and shared by 4 threads
+        for (int nthreads = 1; nthreads <= 4; nthreads += 3) {
+            struct geod_polygon pa;
+            geod_polygon_init(&pa, polyline);
+            geod_polygon_addpoints(&g, &pa, lats.data(), lons.data(), N,
+                                   nthreads);
+            EXPECT_EQ(pa.num, p.num);
+            EXPECT_EQ(pa.crossings, p.crossings);
+            EXPECT_EQ(pa.P[0], p.P[0]);
+            EXPECT_EQ(pa.P[1], p.P[1]);
+            EXPECT_EQ(pa.A[0], p.A[0]);
+            EXPECT_EQ(pa.A[1], p.A[1]);
+            double Aa = 0, Pa = 0;
+            geod_polygon_compute(&g, &pa, 0, 1, &Aa, &Pa);
+            EXPECT_EQ(Pa, P);
+            EXPECT_EQ(Aa, A);
+        }
+    }
+}
+
+} // namespace
@@ -32,6 +32,14 @@
 
 #include "proj_internal.h" // M_PI
 
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace {
 
 // ---------------------------------------------------------------------------
@@ -117,6 +125,110 @@ TEST_F(GridTest, HorizontalShiftGridSet_null) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(GridTest, HorizontalShiftGridSet_inverse_grid) {
+    // Store the inverse grid in a temporary directory
+    const char *tmpDir = "./proj_test_tmp_inverse_grid";
+    proj_context_set_user_writable_directory(m_ctxt, tmpDir, true);
+    proj_context_set_user_writable_directory(m_ctxt2, tmpDir, true);
+
+    NS_PROJ::ListOfHGrids grids;
+    grids.emplace_back(NS_PROJ::HorizontalShiftGridSet::open(m_ctxt, "conus"));
+    ASSERT_NE(grids[0], nullptr);
+    EXPECT_EQ(grids[0]->inverseGridSet(), nullptr);
+
+    NS_PROJ::pj_hgrid_init_inverse_grids(m_ctxt, grids);
+    auto invGridSet = grids[0]->inverseGridSet();
+    ASSERT_NE(invGridSet, nullptr);
+    const std::string invGridSetName(invGridSet->name());
+    ASSERT_EQ(invGridSet->grids().size(), 1U);
+    const auto grid = grids[0]->grids()[0].get();
+    const auto invGrid = invGridSet->grids()[0].get();
+    EXPECT_EQ(invGrid->width(), grid->width());
+    EXPECT_EQ(invGrid->height(), grid->height());
+    EXPECT_NEAR(invGrid->extentAndRes().west, grid->extentAndRes().west,
+                1e-10);
+    EXPECT_NEAR(invGrid->extentAndRes().south, grid->extentAndRes().south,
+                1e-10);
+
+    // Applying the forward shift after the inverse shift interpolated in the
+    // inverse grid must give back the initial point, including between
+    // nodes, within the accuracy of the bilinear interpolation (1e-8 degree
+    // is about 1 mm, while shifts are of the order of 1e-4 degree).
+    {
+        PJ *PInv = proj_create(
+            m_ctxt, ("+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                     "+xy_out=rad +step +proj=hgridshift +grids=" +
+                     invGridSetName +
+                     " +step +proj=unitconvert +xy_in=rad +xy_out=deg")
+                        .c_str());
+        ASSERT_NE(PInv, nullptr);
+        PJ *PFwd = proj_create(
+            m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                    "+xy_out=rad +step +proj=hgridshift +grids=conus "
+                    "+step +proj=unitconvert +xy_in=rad +xy_out=deg");
+        ASSERT_NE(PFwd, nullptr);
+        for (const auto &pair : {std::make_pair(-100.1, 40.1),
+                                 std::make_pair(-80.55, 35.2),
+                                 std::make_pair(-120.33, 45.71),
+                                 std::make_pair(-71.07, 42.37)}) {
+            PJ_COORD c = proj_coord(pair.first, pair.second, 0, 0);
+            PJ_COORD res =
+                proj_trans(PFwd, PJ_FWD, proj_trans(PInv, PJ_FWD, c));
+            EXPECT_NEAR(res.lp.lam, c.lp.lam, 1e-8) << pair.first;
+            EXPECT_NEAR(res.lp.phi, c.lp.phi, 1e-8) << pair.second;
+        }
+        proj_destroy(PInv);
+        proj_destroy(PFwd);
+    }
+
+    // Opening the grid again reuses the inverse grid stored on disk
+    NS_PROJ::ListOfHGrids grids2;
+    grids2.emplace_back(
+        NS_PROJ::HorizontalShiftGridSet::open(m_ctxt2, "conus"));
+    ASSERT_NE(grids2[0], nullptr);
+    NS_PROJ::pj_hgrid_init_inverse_grids(m_ctxt2, grids2);
+    ASSERT_NE(grids2[0]->inverseGridSet(), nullptr);
+    EXPECT_EQ(grids2[0]->inverseGridSet()->name(), invGridSetName);
+
+    // Check that inverse transformation using it gives the same results
+    // as the iterative method
+    {
+        PJ *P = proj_create(
+            m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                    "+xy_out=rad +step +proj=hgridshift +grids=conus "
+                    "+cache_inverse_grid +step +proj=unitconvert +xy_in=rad "
+                    "+xy_out=deg");
+        ASSERT_NE(P, nullptr);
+        PJ *PRef = proj_create(
+            m_ctxt, "+proj=pipeline +step +proj=unitconvert +xy_in=deg "
+                    "+xy_out=rad +step +proj=hgridshift +grids=conus "
+                    "+step +proj=unitconvert +xy_in=rad +xy_out=deg");
+        ASSERT_NE(PRef, nullptr);
+        for (const auto &pair : {std::make_pair(-100.0, 40.0),
+                                 std::make_pair(-80.5, 35.2),
+                                 std::make_pair(-120.3, 45.7)}) {
+            PJ_COORD c = proj_coord(pair.first, pair.second, 0, 0);
+            PJ_COORD res = proj_trans(P, PJ_INV, c);
+            PJ_COORD resRef = proj_trans(PRef, PJ_INV, c);
+            EXPECT_NEAR(res.lp.lam, resRef.lp.lam, 1e-10);
+            EXPECT_NEAR(res.lp.phi, resRef.lp.phi, 1e-10);
+        }
+        proj_destroy(P);
+        proj_destroy(PRef);
+    }
+
+    grids.clear();
+    grids2.clear();
+    EXPECT_EQ(std::remove(invGridSetName.c_str()), 0);
+#ifdef _WIN32
+    RemoveDirectoryA(tmpDir);
+#else
+    rmdir(tmpDir);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(GridTest, GenericShiftGridSet_null) {
     auto gridSet = NS_PROJ::GenericShiftGridSet::open(m_ctxt, "null");
     ASSERT_NE(gridSet, nullptr);
@@ -292,6 +404,113 @@ TEST_F(GridTest, GenericShiftGridSet_gtiff_valuesAt_tiled_optim) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(GridTest, GenericShiftGridSet_gtiff_prefetch) {
+    auto gridSet = NS_PROJ::GenericShiftGridSet::open(
+        m_ctxt, "tests/nkgrf03vel_realigned_extract_tiled_256x256.tif");
+    ASSERT_NE(gridSet, nullptr);
+    auto grid = gridSet->gridAt(21.3333333 / 180 * M_PI, 63.0 / 180 * M_PI);
+    ASSERT_NE(grid, nullptr);
+
+    // Area not intersecting the grid
+    size_t bytesLoaded = 0;
+    EXPECT_TRUE(gridSet->prefetch(-1, -1, -0.9, -0.9, bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 0U);
+
+    EXPECT_TRUE(gridSet->prefetch(21.2 / 180 * M_PI, 62.9 / 180 * M_PI,
+                                  21.4 / 180 * M_PI, 63.1 / 180 * M_PI,
+                                  bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 256U * 256U * grid->samplesPerPixel() *
+                               sizeof(float));
+
+    // Already loaded
+    bytesLoaded = 0;
+    EXPECT_TRUE(gridSet->prefetch(21.2 / 180 * M_PI, 62.9 / 180 * M_PI,
+                                  21.4 / 180 * M_PI, 63.1 / 180 * M_PI,
+                                  bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 0U);
+
+    float out = -1.0f;
+    EXPECT_TRUE(grid->valueAt(0, 0, 0, out));
+    EXPECT_EQ(out, 0.20783890783786773682f);
+    EXPECT_TRUE(grid->valueAt(0, 1, 0, out));
+    EXPECT_EQ(out, 0.19718019664287567139f);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GridTest, GenericShiftGridSet_gtiff_prefetch_with_subgrid) {
+    auto gridSet = NS_PROJ::GenericShiftGridSet::open(
+        m_ctxt, "tests/test_hgrid_with_subgrid.tif");
+    ASSERT_NE(gridSet, nullptr);
+    const double lon = -115.5416667 / 180 * M_PI;
+    const double lat = 51.1666667 / 180 * M_PI;
+    auto grid = gridSet->gridAt(lon, lat);
+    ASSERT_NE(grid, nullptr);
+    std::vector<float> valuesBefore;
+    for (int i = 0; i < grid->width(); ++i) {
+        float out = -1.0f;
+        EXPECT_TRUE(grid->valueAt(i, grid->height() / 2, 0, out));
+        valuesBefore.push_back(out);
+    }
+
+    size_t bytesLoaded = 0;
+    EXPECT_TRUE(gridSet->prefetch(lon - 1e-3, lat - 1e-3, lon + 1e-3,
+                                  lat + 1e-3, bytesLoaded));
+    EXPECT_GT(bytesLoaded, 0U);
+
+    for (int i = 0; i < grid->width(); ++i) {
+        float out = -1.0f;
+        EXPECT_TRUE(grid->valueAt(i, grid->height() / 2, 0, out));
+        EXPECT_EQ(out, valuesBefore[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GridTest, GenericShiftGridSet_gtiff_prefetch_many_blocks) {
+    // 360x180 grid with 2 samples, in 138 tiles of 16x32 pixels
+    const char *gridName = "tests/test_hgrid_tiled.tif";
+    auto gridSet = NS_PROJ::GenericShiftGridSet::open(m_ctxt, gridName);
+    ASSERT_NE(gridSet, nullptr);
+    auto grid = gridSet->gridAt(4.5 / 180 * M_PI, 52.5 / 180 * M_PI);
+    ASSERT_NE(grid, nullptr);
+    const auto &extent = grid->extentAndRes();
+    const size_t blockSize = 16 * 32 * 2 * sizeof(float);
+
+    // Limited by the size of the grid chunk cache
+    proj_grid_cache_set_max_size(m_ctxt, 1);
+    m_ctxt->gridChunkCache.max_size = 10 * blockSize;
+    size_t bytesLoaded = 0;
+    EXPECT_TRUE(gridSet->prefetch(extent.west, extent.south, extent.east,
+                                  extent.north, bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 10 * blockSize);
+
+    proj_grid_cache_set_max_size(m_ctxt, -1);
+    bytesLoaded = 0;
+    EXPECT_TRUE(gridSet->prefetch(extent.west, extent.south, extent.east,
+                                  extent.north, bytesLoaded));
+    EXPECT_EQ(bytesLoaded, 128 * blockSize);
+
+    // Compare with values read without prefetching
+    auto gridSetRef = NS_PROJ::GenericShiftGridSet::open(m_ctxt2, gridName);
+    ASSERT_NE(gridSetRef, nullptr);
+    auto gridRef = gridSetRef->gridAt(4.5 / 180 * M_PI, 52.5 / 180 * M_PI);
+    ASSERT_NE(gridRef, nullptr);
+    for (int y = 0; y < grid->height(); y += 7) {
+        for (int x = 0; x < grid->width(); x += 5) {
+            for (int sample = 0; sample < 2; ++sample) {
+                float out = -1.0f;
+                float outRef = -2.0f;
+                EXPECT_TRUE(grid->valueAt(x, y, sample, out));
+                EXPECT_TRUE(gridRef->valueAt(x, y, sample, outRef));
+                EXPECT_EQ(out, outRef) << x << " " << y;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(GridTest, GenericShiftGridSet_gtiff_with_subgrid) {
     auto gridSet = NS_PROJ::GenericShiftGridSet::open(
         m_ctxt, "tests/test_hgrid_with_subgrid.tif");
@@ -45,6 +45,8 @@
 
 #include "proj_constants.h"
 
+#include <cmath>
+#include <cstdio>
 #include <string>
 
 using namespace osgeo::proj::common;
@@ -18168,3 +18170,75 @@ TEST(json_import, PointMotionOperation) {
     EXPECT_EQ(pmo->exportToJSON(&(JSONFormatter::create()->setSchema("foo"))),
               json);
 }
+
+// ---------------------------------------------------------------------------
+
+TEST(io, toString_shortest_roundtrip) {
+    const double values[] = {0.0,
+                             1.0,
+                             -1.0,
+                             0.1,
+                             -0.5,
+                             1e-4,
+                             1.5e-4,
+                             9.9e-5,
+                             0.0001234,
+                             2.5,
+                             49.5,
+                             6378137.0,
+                             298.257223563,
+                             -298.257222101,
+                             0.9996,
+                             500000.0,
+                             0.017453292519943295,
+                             57.29577951308232,
+                             1e14,
+                             999999999999999.0,
+                             1e15,
+                             1e20,
+                             123456789012345.0,
+                             0.123456789012345,
+                             0.3333333333333333,
+                             1.0 / 3,
+                             2.0 / 3,
+                             0.99999999999,
+                             4.99999999999999,
+                             1e-300,
+                             1e300};
+    for (const double val : values) {
+        char szBuffer[32];
+        snprintf(szBuffer, sizeof(szBuffer), "%.15g", val);
+        std::string expected(szBuffer);
+        if (expected.find("9999999999") != std::string::npos) {
+            snprintf(szBuffer, sizeof(szBuffer), "%.14g", val);
+            expected = szBuffer;
+        }
+        EXPECT_EQ(toString(val), expected) << val;
+
+        if (formatShortestDouble15(val, szBuffer)) {
+            char szExpected[32];
+            snprintf(szExpected, sizeof(szExpected), "%.15g", val);
+            EXPECT_STREQ(szBuffer, szExpected) << val;
+        }
+    }
+
+    // Pseudo-random decimal values of various magnitudes
+    uint64_t state = 1;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const int nDigits = 1 + static_cast<int>((state >> 33) % 17);
+        const int nExp = static_cast<int>((state >> 40) % 24) - 8;
+        double val = static_cast<double>((state >> 11) % 100000000000000000ULL);
+        val /= std::pow(10.0, 17 - nDigits);
+        val = std::round(val) * std::pow(10.0, nExp - nDigits);
+        if ((state >> 63) != 0) {
+            val = -val;
+        }
+        char szBuffer[32];
+        if (formatShortestDouble15(val, szBuffer)) {
+            char szExpected[32];
+            snprintf(szExpected, sizeof(szExpected), "%.15g", val);
+            EXPECT_STREQ(szBuffer, szExpected) << val;
+        }
+    }
+}
@@ -49,7 +49,9 @@
 
 #include "proj_constants.h"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace osgeo::proj::common;
@@ -637,6 +639,186 @@ TEST(operation, geogCRS_to_geogCRS_context_datum_ensemble) {
 
 // ---------------------------------------------------------------------------
 
+TEST(operation, geogCRS_to_geogCRS_context_max_threads) {
+    auto authFactory =
+        AuthorityFactory::create(DatabaseContext::create(), std::string());
+    const std::pair<const char *, const char *> pairs[] = {
+        {"EPSG:4939", "EPSG:7843"}, // GDA94 3D -> GDA2020 3D
+        {"EPSG:4807", "EPSG:4171"}, // NTF (Paris) -> RGF93
+        {"EPSG:4267", "EPSG:6318"}, // NAD27 -> NAD83(2011)
+        {"EPSG:4230", "EPSG:4979"}, // ED50 -> WGS 84 3D
+        {"EPSG:32631", "EPSG:7415"} // WGS 84 / UTM 31N -> RD/NAP
+    };
+    for (const auto &pair : pairs) {
+        auto src =
+            createFromUserInput(pair.first, authFactory->databaseContext());
+        auto srcCRS = nn_dynamic_pointer_cast<CRS>(src);
+        ASSERT_TRUE(srcCRS != nullptr);
+        auto dst =
+            createFromUserInput(pair.second, authFactory->databaseContext());
+        auto dstCRS = nn_dynamic_pointer_cast<CRS>(dst);
+        ASSERT_TRUE(dstCRS != nullptr);
+
+        auto ctxt =
+            CoordinateOperationContext::create(authFactory, nullptr, 0.0);
+        ctxt->setSpatialCriterion(
+            CoordinateOperationContext::SpatialCriterion::PARTIAL_INTERSECTION);
+        ctxt->setGridAvailabilityUse(
+            CoordinateOperationContext::GridAvailabilityUse::
+                IGNORE_GRID_AVAILABILITY);
+        EXPECT_EQ(ctxt->getMaxThreads(), 1);
+        auto factory = CoordinateOperationFactory::create();
+        auto listSerial = factory->createOperations(
+            NN_NO_CHECK(srcCRS), NN_NO_CHECK(dstCRS), ctxt);
+        ASSERT_GE(listSerial.size(), 1U) << pair.first << " " << pair.second;
+
+        for (int maxThreads : {4, 8, 0}) {
+            ctxt->setMaxThreads(maxThreads);
+            auto list = factory->createOperations(
+                NN_NO_CHECK(srcCRS), NN_NO_CHECK(dstCRS), ctxt);
+            ASSERT_EQ(list.size(), listSerial.size())
+                << pair.first << " " << pair.second;
+            for (size_t i = 0; i < list.size(); ++i) {
+                EXPECT_EQ(list[i]->nameStr(), listSerial[i]->nameStr());
+                EXPECT_EQ(list[i]->exportToWKT(
+                              WKTFormatter::create(
+                                  WKTFormatter::Convention::WKT2_2019)
+                                  .get()),
+                          listSerial[i]->exportToWKT(
+                              WKTFormatter::create(
+                                  WKTFormatter::Convention::WKT2_2019)
+                                  .get()));
+            }
+        }
+    }
+
+    // The threads and their database contexts are kept for later calls
+    const auto &dbContext = authFactory->databaseContext();
+    const size_t otherThreadContextCount =
+        dbContext->getOtherThreadContextCount();
+    EXPECT_GE(otherThreadContextCount, 1U);
+    EXPECT_LE(otherThreadContextCount,
+              std::max<size_t>(7, std::thread::hardware_concurrency()));
+    auto ctxt = CoordinateOperationContext::create(authFactory, nullptr, 0.0);
+    ctxt->setSpatialCriterion(
+        CoordinateOperationContext::SpatialCriterion::PARTIAL_INTERSECTION);
+    ctxt->setGridAvailabilityUse(
+        CoordinateOperationContext::GridAvailabilityUse::
+            IGNORE_GRID_AVAILABILITY);
+    ctxt->setMaxThreads(8);
+    auto factory = CoordinateOperationFactory::create();
+    for (int i = 0; i < 10; ++i) {
+        for (const auto &pair : pairs) {
+            auto src = nn_dynamic_pointer_cast<CRS>(
+                createFromUserInput(pair.first, dbContext));
+            ASSERT_TRUE(src != nullptr);
+            auto dst = nn_dynamic_pointer_cast<CRS>(
+                createFromUserInput(pair.second, dbContext));
+            ASSERT_TRUE(dst != nullptr);
+            EXPECT_GE(factory
+                          ->createOperations(NN_NO_CHECK(src),
+                                             NN_NO_CHECK(dst), ctxt)
+                          .size(),
+                      1U);
+        }
+    }
+    EXPECT_EQ(dbContext->getOtherThreadContextCount(),
+              otherThreadContextCount);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(operation, geogCRS_to_geogCRS_context_max_result_count) {
+    auto authFactory =
+        AuthorityFactory::create(DatabaseContext::create(), "EPSG");
+    auto ctxt = CoordinateOperationContext::create(authFactory, nullptr, 0.0);
+    ctxt->setSpatialCriterion(
+        CoordinateOperationContext::SpatialCriterion::PARTIAL_INTERSECTION);
+    ctxt->setGridAvailabilityUse(
+        CoordinateOperationContext::GridAvailabilityUse::
+            IGNORE_GRID_AVAILABILITY);
+    EXPECT_EQ(ctxt->getMaxResultCount(), 0U);
+    auto factory = CoordinateOperationFactory::create();
+    auto listFull = factory->createOperations(
+        authFactory->createCoordinateReferenceSystem("4267"), // NAD27
+        authFactory->createCoordinateReferenceSystem("4269"), // NAD83
+        ctxt);
+    ASSERT_GT(listFull.size(), 3U);
+
+    for (size_t maxResultCount :
+         {size_t(1), size_t(3), listFull.size(), listFull.size() + 1}) {
+        ctxt->setMaxResultCount(maxResultCount);
+        EXPECT_EQ(ctxt->getMaxResultCount(), maxResultCount);
+        auto list = factory->createOperations(
+            authFactory->createCoordinateReferenceSystem("4267"),
+            authFactory->createCoordinateReferenceSystem("4269"), ctxt);
+        ASSERT_EQ(list.size(), std::min(maxResultCount, listFull.size()));
+        for (size_t i = 0; i < list.size(); ++i) {
+            EXPECT_EQ(list[i]->nameStr(), listFull[i]->nameStr());
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(operation, geogCRS_to_geogCRS_context_desired_accuracy_skips_ops) {
+    auto authFactory =
+        AuthorityFactory::create(DatabaseContext::create(), "EPSG");
+    auto ctxt = CoordinateOperationContext::create(authFactory, nullptr, 1.0);
+    ctxt->setSpatialCriterion(
+        CoordinateOperationContext::SpatialCriterion::PARTIAL_INTERSECTION);
+    ctxt->setGridAvailabilityUse(
+        CoordinateOperationContext::GridAvailabilityUse::
+            IGNORE_GRID_AVAILABILITY);
+    auto list = CoordinateOperationFactory::create()->createOperations(
+        authFactory->createCoordinateReferenceSystem("4230"), // ED50
+        authFactory->createCoordinateReferenceSystem("4326"), ctxt);
+    ASSERT_GE(list.size(), 1U);
+    for (const auto &op : list) {
+        ASSERT_EQ(op->coordinateOperationAccuracies().size(), 1U);
+        EXPECT_LE(
+            std::stod(op->coordinateOperationAccuracies()[0]->value()), 1.0);
+    }
+
+    // The desired accuracy is pushed down to the database query, which
+    // skips the less accurate operations.
+    bool hasSkippedOps = false;
+    auto listPushedDown = authFactory->createFromCoordinateReferenceSystemCodes(
+        "EPSG", "4230", "EPSG", "4326", false, false, false, false, true, false,
+        nullptr, nullptr, 1.0, hasSkippedOps);
+    EXPECT_TRUE(hasSkippedOps);
+    ASSERT_GE(listPushedDown.size(), 1U);
+
+    // Compare with the same query with the push-down disabled: only the
+    // operations less accurate than requested must have been skipped.
+    bool hasSkippedOpsNoPushDown = true;
+    auto listNoPushDown = authFactory->createFromCoordinateReferenceSystemCodes(
+        "EPSG", "4230", "EPSG", "4326", false, false, false, false, true, false,
+        nullptr, nullptr, 0.0, hasSkippedOpsNoPushDown);
+    EXPECT_FALSE(hasSkippedOpsNoPushDown);
+    EXPECT_GT(listNoPushDown.size(), listPushedDown.size());
+    std::vector<std::string> namesNoPushDownAccurateEnough;
+    for (const auto &op : listNoPushDown) {
+        const auto &accuracies = op->coordinateOperationAccuracies();
+        if (accuracies.empty() || std::stod(accuracies[0]->value()) <= 1.0) {
+            namesNoPushDownAccurateEnough.push_back(op->nameStr());
+        }
+    }
+    std::vector<std::string> namesPushedDown;
+    for (const auto &op : listPushedDown) {
+        namesPushedDown.push_back(op->nameStr());
+    }
+    EXPECT_EQ(namesPushedDown, namesNoPushDownAccurateEnough);
+
+    // Operations skipped by the above search are still returned when
+    // no accuracy is requested.
+    auto listAll = authFactory->createFromCoordinateReferenceSystemCodes(
+        "EPSG", "4230", "EPSG", "4326", false, false, false, false);
+    EXPECT_GT(listAll.size(), list.size());
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(operation, geogCRS_to_geogCRS_context_incompatible_celestial_body) {
     auto authFactory =
         AuthorityFactory::create(DatabaseContext::create(), std::string());